@@ -0,0 +1,965 @@
+//********************************************************************************
+//**                                                                            **
+//**  Pertains to CU-BEN ver 4.0                                                **
+//**                                                                            **
+//**  CU-BENs: a ship hull modeling finite element library                      **
+//**  Copyright (c) 2019 C. J. Earls                                            **
+//**  Developed by C. J. Earls, Cornell University                              **
+//**  All rights reserved.                                                      **
+//**                                                                            **
+//**  Contributors:                                                             **
+//**    Christopher Stull                                                       **
+//**    Heather Reed                                                            **
+//**    Justyna Kosianka                                                        **
+//**    Wensi Wu                                                                **
+//**                                                                            **
+//**  This program is free software: you can redistribute it and/or modify it   **
+//**  under the terms of the GNU General Public License as published by the     **
+//**  Free Software Foundation, either version 3 of the License, or (at your    **
+//**  option) any later version.                                                **
+//**                                                                            **
+//**  This program is distributed in the hope that it will be useful, but       **
+//**  WITHOUT ANY WARRANTY; without even the implied warranty of                **
+//**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General  **
+//**  Public License for more details.                                          **
+//**                                                                            **
+//**  You should have received a copy of the GNU General Public License along   **
+//**  with this program. If not, see <https://www.gnu.org/licenses/>.           **
+//**                                                                            **
+//********************************************************************************
+
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "prototypes.h"
+
+// CLAPACK header files
+#if defined(__APPLE__)
+#  include <Accelerate/Accelerate.h>
+#else
+void dgetrf_ (int *m, int *n, double *a, int *lda, int *ipiv, int *info);
+void dgetrs_ (char *trans, int *n, int *nrhs, double *a, int *lda, int *ipiv, double *b,
+              int *ldb, int *info);
+#endif
+
+#define AMGLEV 12 // Maximum number of levels of the multigrid hierarchy
+#define AMGMIN 300 // Number of DOFs below which a level is solved directly
+#define AMGNB 6 // Number of near-nullspace (rigid body) modes
+#define AMGTHETA 0.08 // Threshold of strong coupling between two joints or aggregates
+#define AMGTOL 1e-10 // Relative residual at which the conjugate gradient iterations stop
+#define AMGMAXIT 1000 // Maximum number of conjugate gradient iterations
+
+extern BEN_TLS long NJ, NEQ;
+extern BEN_TLS int ANAFLAG, ITFLAG;
+extern BEN_TLS FILE *OFP[8];
+
+/* Smoothed aggregation multigrid hierarchy, held between calls: for each level, the number
+ of DOFs, the matrix in compressed row storage (both triangles), and the prolongator from the
+ next coarser level (compressed row storage, one row per DOF of the level), with vectors for
+ the V-cycle; the coarsest level is held as a dense LU factorization */
+static BEN_TLS int amgnlev = 0;
+static BEN_TLS long amgn[AMGLEV];
+static BEN_TLS long *amgap[AMGLEV], *amgai[AMGLEV], *amgpp[AMGLEV], *amgpi[AMGLEV];
+static BEN_TLS double *amgax[AMGLEV], *amgpx[AMGLEV], *amgr[AMGLEV], *amgb[AMGLEV], *amgx[AMGLEV];
+static BEN_TLS double *amgdc = NULL;
+static BEN_TLS int *amgpiv = NULL;
+
+/* Near-nullspace modes of the finest level [AMGNB][NEQ] and the joint of each equation,
+ computed by amgmodes from the initial geometry; the iterative solver is abandoned for the
+ remainder of the analysis once it fails to converge */
+static BEN_TLS double *amgbn = NULL;
+static BEN_TLS long *amgnod = NULL;
+static BEN_TLS int amgstall = 0;
+
+int amgmodes (double *px, long *pjcode)
+{
+    // Initialize function variables
+    long i, j, k;
+    int dir;
+    double xc[3], dx[3];
+
+    amgbn = alloc_dbl (AMGNB*NEQ);
+    amgnod = alloc_long (NEQ);
+    if (amgbn == NULL || amgnod == NULL) {
+        return 1;
+    }
+    for (i = 0; i < AMGNB*NEQ; ++i) {
+        *(amgbn+i) = 0;
+    }
+
+    // Rotations are taken about the centroid of the joints to keep the modes well scaled
+    for (k = 0; k < 3; ++k) {
+        xc[k] = 0;
+        for (j = 0; j < NJ; ++j) {
+            xc[k] += *(px+j*3+k) / NJ;
+        }
+    }
+
+    /* Rigid body translations and rotations of the joints; the rotational DOFs of frames and
+     shells take the rotation itself, and the warping DOF of frames is left out */
+    for (j = 0; j < NJ; ++j) {
+        for (k = 0; k < 3; ++k) {
+            dx[k] = *(px+j*3+k) - xc[k];
+        }
+        for (dir = 0; dir < 6; ++dir) {
+            i = *(pjcode+j*7+dir);
+            if (i == 0) {
+                continue;
+            }
+            *(amgnod+i-1) = j;
+            if (dir < 3) {
+                *(amgbn+dir*NEQ+i-1) = 1;
+                if (dir == 0) {
+                    *(amgbn+4*NEQ+i-1) = dx[2];
+                    *(amgbn+5*NEQ+i-1) = -dx[1];
+                } else if (dir == 1) {
+                    *(amgbn+3*NEQ+i-1) = -dx[2];
+                    *(amgbn+5*NEQ+i-1) = dx[0];
+                } else {
+                    *(amgbn+3*NEQ+i-1) = dx[1];
+                    *(amgbn+4*NEQ+i-1) = -dx[0];
+                }
+            } else {
+                *(amgbn+dir*NEQ+i-1) = 1;
+            }
+        }
+        i = *(pjcode+j*7+6);
+        if (i != 0) {
+            *(amgnod+i-1) = j;
+        }
+    }
+    return 0;
+}
+
+long amgaggr (long n, long *pap, long *pai, double *pax, long *pnod, long nn, long *pagg)
+{
+    // Initialize function variables
+    long i, j, k, a, b, kk, nagg, nedge;
+    double d;
+
+    long *pnp = alloc_long (nn+1);
+    long *pni = alloc_long (n);
+    long *pmark = alloc_long (nn);
+    long *pep = alloc_long (nn+1);
+    long *pagg1 = alloc_long (nn);
+    double *pd = alloc_dbl (n);
+    if (pnp == NULL || pni == NULL || pmark == NULL || pep == NULL || pagg1 == NULL ||
+        pd == NULL) {
+        return -1;
+    }
+    for (i = 0; i < n; ++i) {
+        *(pd+i) = amgdiag (pap, pai, pax, i);
+    }
+
+    // List the DOFs of each node (joint or aggregate of the finer level)
+    for (a = 0; a <= nn; ++a) {
+        *(pnp+a) = 0;
+    }
+    for (i = 0; i < n; ++i) {
+        (*(pnp+*(pnod+i)+1))++;
+    }
+    for (a = 0; a < nn; ++a) {
+        *(pnp+a+1) += *(pnp+a);
+    }
+    for (i = 0; i < n; ++i) {
+        *(pni+(*(pnp+*(pnod+i)))++) = i;
+    }
+    for (a = nn; a > 0; --a) {
+        *(pnp+a) = *(pnp+a-1);
+    }
+    *(pnp) = 0;
+
+    /* Two nodes are strongly coupled if an entry between their DOFs is large relative to
+     the diagonal entries, |a_ij| >= theta sqrt(a_ii a_jj); the strong couplings are found
+     twice, to count and then to store them */
+    long *pei = NULL;
+    for (kk = 0; kk < 2; ++kk) {
+        for (a = 0; a < nn; ++a) {
+            *(pmark+a) = -1;
+        }
+        nedge = 0;
+        for (a = 0; a < nn; ++a) {
+            *(pep+a) = nedge;
+            for (k = *(pnp+a); k < *(pnp+a+1); ++k) {
+                i = *(pni+k);
+                for (j = *(pap+i); j < *(pap+i+1); ++j) {
+                    b = *(pnod+*(pai+j));
+                    if (b == a || *(pmark+b) == a) {
+                        continue;
+                    }
+                    d = *(pd+i) * (*(pd+*(pai+j)));
+                    if (fabs(*(pax+j)) >= AMGTHETA * sqrt(fabs(d))) {
+                        *(pmark+b) = a;
+                        if (kk == 1) {
+                            *(pei+nedge) = b;
+                        }
+                        nedge++;
+                    }
+                }
+            }
+        }
+        *(pep+nn) = nedge;
+        if (kk == 0) {
+            pei = alloc_long (nedge+1);
+            if (pei == NULL) {
+                return -1;
+            }
+        }
+    }
+
+    /* Aggregation in three passes (Vanek et al. 1996): a node whose strong neighbors are all
+     free starts an aggregate with them; a remaining node joins the aggregate of a strong
+     neighbor; any node still left starts an aggregate with its free strong neighbors */
+    for (a = 0; a < nn; ++a) {
+        *(pagg+a) = -1;
+    }
+    nagg = 0;
+    for (a = 0; a < nn; ++a) {
+        if (*(pagg+a) != -1) {
+            continue;
+        }
+        for (k = *(pep+a); k < *(pep+a+1); ++k) {
+            if (*(pagg+*(pei+k)) != -1) {
+                break;
+            }
+        }
+        if (k == *(pep+a+1)) {
+            *(pagg+a) = nagg;
+            for (k = *(pep+a); k < *(pep+a+1); ++k) {
+                *(pagg+*(pei+k)) = nagg;
+            }
+            nagg++;
+        }
+    }
+    for (a = 0; a < nn; ++a) {
+        *(pagg1+a) = *(pagg+a);
+    }
+    for (a = 0; a < nn; ++a) {
+        if (*(pagg+a) == -1) {
+            for (k = *(pep+a); k < *(pep+a+1); ++k) {
+                if (*(pagg1+*(pei+k)) != -1) {
+                    *(pagg+a) = *(pagg1+*(pei+k));
+                    break;
+                }
+            }
+        }
+    }
+    for (a = 0; a < nn; ++a) {
+        if (*(pagg+a) == -1) {
+            *(pagg+a) = nagg;
+            for (k = *(pep+a); k < *(pep+a+1); ++k) {
+                if (*(pagg+*(pei+k)) == -1) {
+                    *(pagg+*(pei+k)) = nagg;
+                }
+            }
+            nagg++;
+        }
+    }
+
+    free (pnp);
+    free (pni);
+    free (pmark);
+    free (pep);
+    free (pagg1);
+    free (pd);
+    free (pei);
+
+    return nagg;
+}
+
+double amgdiag (long *pap, long *pai, double *pax, long i)
+{
+    // Initialize function variables
+    long j;
+
+    for (j = *(pap+i); j < *(pap+i+1); ++j) {
+        if (*(pai+j) == i) {
+            return *(pax+j);
+        }
+    }
+    return 0;
+}
+
+long amgmatmul (long n, long nc, long *pap, long *pai, double *pax, long *pbp, long *pbi,
+    double *pbx, long **ppcp, long **ppci, double **ppcx)
+{
+    // Initialize function variables
+    long i, j, k, c, nz, pass;
+
+    long *pcp = alloc_long (n+1);
+    long *pmark = alloc_long (nc);
+    double *pacc = alloc_dbl (nc);
+    if (pcp == NULL || pmark == NULL || pacc == NULL) {
+        return -1;
+    }
+    long *pci = NULL;
+    double *pcx = NULL;
+
+    /* Product C = A B of two matrices in compressed row storage (A is n by any, B any by
+     nc), formed row by row with a dense accumulator; the first pass counts the entries */
+    for (pass = 0; pass < 2; ++pass) {
+        for (c = 0; c < nc; ++c) {
+            *(pmark+c) = -1;
+        }
+        nz = 0;
+        for (i = 0; i < n; ++i) {
+            *(pcp+i) = nz;
+            for (j = *(pap+i); j < *(pap+i+1); ++j) {
+                for (k = *(pbp+*(pai+j)); k < *(pbp+*(pai+j)+1); ++k) {
+                    c = *(pbi+k);
+                    if (*(pmark+c) < *(pcp+i)) {
+                        *(pmark+c) = nz;
+                        if (pass == 1) {
+                            *(pci+nz) = c;
+                            *(pacc+c) = 0;
+                        }
+                        nz++;
+                    }
+                    if (pass == 1) {
+                        *(pacc+c) += *(pax+j) * (*(pbx+k));
+                    }
+                }
+            }
+            if (pass == 1) {
+                for (k = *(pcp+i); k < nz; ++k) {
+                    *(pcx+k) = *(pacc+*(pci+k));
+                }
+            }
+        }
+        *(pcp+n) = nz;
+        if (pass == 0) {
+            pci = alloc_long (nz+1);
+            pcx = alloc_dbl (nz+1);
+            if (pci == NULL || pcx == NULL) {
+                return -1;
+            }
+        }
+    }
+    free (pmark);
+    free (pacc);
+
+    *ppcp = pcp;
+    *ppci = pci;
+    *ppcx = pcx;
+    return nz;
+}
+
+long amgtrans (long n, long nc, long *pap, long *pai, double *pax, long **pptp, long **ppti,
+    double **pptx)
+{
+    // Initialize function variables
+    long i, j, c;
+
+    long *ptp = alloc_long (nc+1);
+    long *pti = alloc_long (*(pap+n)+1);
+    double *ptx = alloc_dbl (*(pap+n)+1);
+    if (ptp == NULL || pti == NULL || ptx == NULL) {
+        return -1;
+    }
+
+    // Transpose of an n by nc matrix in compressed row storage
+    for (c = 0; c <= nc; ++c) {
+        *(ptp+c) = 0;
+    }
+    for (j = 0; j < *(pap+n); ++j) {
+        (*(ptp+*(pai+j)+1))++;
+    }
+    for (c = 0; c < nc; ++c) {
+        *(ptp+c+1) += *(ptp+c);
+    }
+    for (i = 0; i < n; ++i) {
+        for (j = *(pap+i); j < *(pap+i+1); ++j) {
+            c = *(pai+j);
+            *(pti+*(ptp+c)) = i;
+            *(ptx+*(ptp+c)) = *(pax+j);
+            (*(ptp+c))++;
+        }
+    }
+    for (c = nc; c > 0; --c) {
+        *(ptp+c) = *(ptp+c-1);
+    }
+    *(ptp) = 0;
+
+    *pptp = ptp;
+    *ppti = pti;
+    *pptx = ptx;
+    return *(ptp+nc);
+}
+
+int amgfact (long *pmaxa, double *pss, int *pdet)
+{
+    // Initialize function variables
+    long i, j, k, kk, n, nn, nc, nagg, m, c, t, l, it;
+    int lev, kb, nk, info, nci;
+    double d, rho, omega, nrm, r;
+
+    /* For FSI analysis the skyline holds the uncoupled structure and fluid blocks, which are
+     factorized as the preconditioner of fsigmres */
+    if (ITFLAG == 0 || amgstall == 1 || ANAFLAG == 4) {
+        return 0;
+    }
+    amgfree ();
+
+    /* Copy the skyline matrix into compressed row storage, with both triangles and without
+     the zero entries of the profile */
+    n = NEQ;
+    long *pap = alloc_long (n+1);
+    if (pap == NULL) {
+        return -1;
+    }
+    for (i = 0; i <= n; ++i) {
+        *(pap+i) = 0;
+    }
+    for (j = 0; j < n; ++j) {
+        k = j;
+        for (kk = *(pmaxa+j); kk < *(pmaxa+j+1); ++kk, --k) {
+            if (*(pss+kk-1) != 0 || k == j) {
+                (*(pap+k+1))++;
+                if (k != j) {
+                    (*(pap+j+1))++;
+                }
+            }
+        }
+    }
+    for (i = 0; i < n; ++i) {
+        *(pap+i+1) += *(pap+i);
+    }
+    long *pai = alloc_long (*(pap+n));
+    double *pax = alloc_dbl (*(pap+n));
+    if (pai == NULL || pax == NULL) {
+        return -1;
+    }
+    for (j = 0; j < n; ++j) {
+        k = j;
+        for (kk = *(pmaxa+j); kk < *(pmaxa+j+1); ++kk, --k) {
+            if (*(pss+kk-1) != 0 || k == j) {
+                *(pai+*(pap+k)) = j;
+                *(pax+(*(pap+k))++) = *(pss+kk-1);
+                if (k != j) {
+                    *(pai+*(pap+j)) = k;
+                    *(pax+(*(pap+j))++) = *(pss+kk-1);
+                }
+            }
+        }
+    }
+    for (i = n; i > 0; --i) {
+        *(pap+i) = *(pap+i-1);
+    }
+    *(pap) = 0;
+
+    // The nodes of the finest level are the joints and its near-nullspace the rigid body modes
+    long *pnod = alloc_long (n);
+    double *pbn = alloc_dbl (AMGNB*n);
+    if (pnod == NULL || pbn == NULL) {
+        return -1;
+    }
+    for (i = 0; i < n; ++i) {
+        *(pnod+i) = *(amgnod+i);
+    }
+    for (i = 0; i < AMGNB*n; ++i) {
+        *(pbn+i) = *(amgbn+i);
+    }
+    nn = NJ;
+    kb = AMGNB;
+
+    for (lev = 0; ; ++lev) {
+        amgn[lev] = n;
+        amgap[lev] = pap;
+        amgai[lev] = pai;
+        amgax[lev] = pax;
+        amgr[lev] = alloc_dbl (n);
+        amgb[lev] = alloc_dbl (n);
+        amgx[lev] = alloc_dbl (n);
+        if (amgr[lev] == NULL || amgb[lev] == NULL || amgx[lev] == NULL) {
+            return -1;
+        }
+        amgnlev = lev+1;
+        for (i = 0; i < n; ++i) {
+            if (amgdiag (pap, pai, pax, i) <= 0) {
+                fprintf(OFP[0], "\n***WARNING*** Nonpositive diagonal entry; the multigrid");
+                fprintf(OFP[0], " preconditioner is not used\n");
+                amgfree ();
+                free (pnod);
+                free (pbn);
+                return 0;
+            }
+        }
+        if (n <= AMGMIN || lev == AMGLEV-1) {
+            break;
+        }
+
+        // Aggregate the nodes of this level
+        long *pagg = alloc_long (nn);
+        if (pagg == NULL) {
+            return -1;
+        }
+        nagg = amgaggr (n, pap, pai, pax, pnod, nn, pagg);
+        if (nagg < 0) {
+            return -1;
+        }
+
+        /* Tentative prolongator: the near-nullspace modes restricted to the DOFs of each
+         aggregate are orthonormalized (modified Gram-Schmidt, dropping dependent modes); the
+         orthonormal modes are its columns and the coefficients the near-nullspace of the
+         coarse level */
+        long *pgp = alloc_long (nagg+1);
+        long *pgi = alloc_long (n);
+        long *pgc = alloc_long (nagg+1);
+        long *ptp = alloc_long (n+1);
+        long *pti = alloc_long (kb*n+1);
+        double *ptx = alloc_dbl (kb*n+1);
+        double *pq = alloc_dbl (kb*n+1);
+        double *pbc = alloc_dbl (kb*kb*nagg+1);
+        long *pnodc = alloc_long (kb*nagg+1);
+        if (pgp == NULL || pgi == NULL || pgc == NULL || ptp == NULL || pti == NULL ||
+            ptx == NULL || pq == NULL || pbc == NULL || pnodc == NULL) {
+            return -1;
+        }
+        for (c = 0; c <= nagg; ++c) {
+            *(pgp+c) = 0;
+        }
+        for (i = 0; i < n; ++i) {
+            (*(pgp+*(pagg+*(pnod+i))+1))++;
+        }
+        for (c = 0; c < nagg; ++c) {
+            *(pgp+c+1) += *(pgp+c);
+        }
+        for (i = 0; i < n; ++i) {
+            *(pgi+(*(pgp+*(pagg+*(pnod+i))))++) = i;
+        }
+        for (c = nagg; c > 0; --c) {
+            *(pgp+c) = *(pgp+c-1);
+        }
+        *(pgp) = 0;
+
+        nc = 0;
+        for (c = 0; c < nagg; ++c) {
+            *(pgc+c) = nc;
+            m = *(pgp+c+1) - *(pgp+c);
+            nk = 0;
+            for (t = 0; t < kb; ++t) {
+                // Column t of the modes on the DOFs of the aggregate, stored in pq
+                nrm = 0;
+                for (l = 0; l < m; ++l) {
+                    *(pq+*(pgp+c)*kb+nk*m+l) = *(pbn+t*n+*(pgi+*(pgp+c)+l));
+                    nrm += *(pbn+t*n+*(pgi+*(pgp+c)+l)) * (*(pbn+t*n+*(pgi+*(pgp+c)+l)));
+                }
+                for (l = 0; l < kb; ++l) {
+                    *(pbc+(nc+l)*kb+t) = 0;
+                }
+                for (k = 0; k < nk; ++k) {
+                    r = 0;
+                    for (l = 0; l < m; ++l) {
+                        r += *(pq+*(pgp+c)*kb+k*m+l) * (*(pq+*(pgp+c)*kb+nk*m+l));
+                    }
+                    for (l = 0; l < m; ++l) {
+                        *(pq+*(pgp+c)*kb+nk*m+l) -= r * (*(pq+*(pgp+c)*kb+k*m+l));
+                    }
+                    *(pbc+(nc+k)*kb+t) = r;
+                }
+                d = 0;
+                for (l = 0; l < m; ++l) {
+                    d += *(pq+*(pgp+c)*kb+nk*m+l) * (*(pq+*(pgp+c)*kb+nk*m+l));
+                }
+                d = sqrt(d);
+                if (nk < m && d > 1e-8 * sqrt(nrm) && d > 0) {
+                    for (l = 0; l < m; ++l) {
+                        *(pq+*(pgp+c)*kb+nk*m+l) /= d;
+                    }
+                    *(pbc+(nc+nk)*kb+t) = d;
+                    nk++;
+                }
+            }
+            for (k = 0; k < nk; ++k) {
+                *(pnodc+nc+k) = c;
+            }
+            nc += nk;
+            // Number of entries in the rows of the tentative prolongator for the aggregate
+            for (l = 0; l < m; ++l) {
+                *(ptp+*(pgi+*(pgp+c)+l)) = nk;
+            }
+        }
+        *(pgc+nagg) = nc;
+        if (nc >= n || nc == 0) {
+            // Coarsening has stalled; this level is solved directly
+            free (pagg);
+            free (pgp);
+            free (pgi);
+            free (pgc);
+            free (ptp);
+            free (pti);
+            free (ptx);
+            free (pq);
+            free (pbc);
+            free (pnodc);
+            break;
+        }
+
+        // Assemble the tentative prolongator in compressed row storage
+        k = 0;
+        for (i = 0; i < n; ++i) {
+            t = *(ptp+i);
+            *(ptp+i) = k;
+            k += t;
+        }
+        *(ptp+n) = k;
+        for (c = 0; c < nagg; ++c) {
+            m = *(pgp+c+1) - *(pgp+c);
+            nk = *(pgc+c+1) - *(pgc+c);
+            for (l = 0; l < m; ++l) {
+                i = *(pgi+*(pgp+c)+l);
+                for (t = 0; t < nk; ++t) {
+                    *(pti+*(ptp+i)+t) = *(pgc+c) + t;
+                    *(ptx+*(ptp+i)+t) = *(pq+*(pgp+c)*kb+t*m+l);
+                }
+            }
+        }
+
+        /* Estimate the spectral radius of D^-1 A by power iterations, and smooth the
+         tentative prolongator by damped Jacobi, P = (I - omega D^-1 A) Pt with
+         omega = 4 / (3 rho) */
+        double *pv = amgr[lev];
+        double *pw = amgx[lev];
+        for (i = 0; i < n; ++i) {
+            *(pv+i) = 1 + (double) (i % 7) / 7;
+        }
+        rho = 1;
+        for (it = 0; it < 15; ++it) {
+            nrm = 0;
+            for (i = 0; i < n; ++i) {
+                *(pw+i) = 0;
+                for (j = *(pap+i); j < *(pap+i+1); ++j) {
+                    *(pw+i) += *(pax+j) * (*(pv+*(pai+j)));
+                }
+                *(pw+i) /= amgdiag (pap, pai, pax, i);
+                nrm += *(pw+i) * (*(pw+i));
+            }
+            nrm = sqrt(nrm);
+            d = 0;
+            for (i = 0; i < n; ++i) {
+                d += *(pv+i) * (*(pv+i));
+            }
+            rho = nrm / sqrt(d);
+            for (i = 0; i < n; ++i) {
+                *(pv+i) = *(pw+i) / nrm;
+            }
+        }
+        omega = 4 / (3 * rho);
+
+        long *pcp, *pci, *ppp, *ppi;
+        double *pcx, *ppx;
+        if (amgmatmul (n, nc, pap, pai, pax, ptp, pti, ptx, &pcp, &pci, &pcx) < 0) {
+            return -1;
+        }
+        for (i = 0; i < n; ++i) {
+            d = omega / amgdiag (pap, pai, pax, i);
+            for (j = *(pcp+i); j < *(pcp+i+1); ++j) {
+                *(pcx+j) *= -d;
+            }
+            // The pattern of A Pt includes that of Pt, as the diagonal of A is nonzero
+            for (k = *(ptp+i); k < *(ptp+i+1); ++k) {
+                for (j = *(pcp+i); j < *(pcp+i+1); ++j) {
+                    if (*(pci+j) == *(pti+k)) {
+                        *(pcx+j) += *(ptx+k);
+                        break;
+                    }
+                }
+            }
+        }
+        ppp = pcp;
+        ppi = pci;
+        ppx = pcx;
+        amgpp[lev] = ppp;
+        amgpi[lev] = ppi;
+        amgpx[lev] = ppx;
+
+        // Galerkin coarse level matrix Ac = P^t A P
+        long *pqp, *pqi, *prp, *pri, *pacp, *paci;
+        double *pqx, *prx, *pacx;
+        if (amgmatmul (n, nc, pap, pai, pax, ppp, ppi, ppx, &pqp, &pqi, &pqx) < 0 ||
+            amgtrans (n, nc, ppp, ppi, ppx, &prp, &pri, &prx) < 0 ||
+            amgmatmul (nc, nc, prp, pri, prx, pqp, pqi, pqx, &pacp, &paci, &pacx) < 0) {
+            return -1;
+        }
+        free (pqp);
+        free (pqi);
+        free (pqx);
+        free (prp);
+        free (pri);
+        free (prx);
+
+        // The coarse level becomes the current level
+        free (pagg);
+        free (pgp);
+        free (pgi);
+        free (pgc);
+        free (ptp);
+        free (pti);
+        free (ptx);
+        free (pq);
+        free (pnod);
+        free (pbn);
+        pbn = alloc_dbl (kb*nc+1);
+        if (pbn == NULL) {
+            return -1;
+        }
+        for (k = 0; k < nc; ++k) {
+            for (t = 0; t < kb; ++t) {
+                *(pbn+t*nc+k) = *(pbc+k*kb+t);
+            }
+        }
+        free (pbc);
+        pnod = pnodc;
+        nn = nagg;
+        n = nc;
+        pap = pacp;
+        pai = paci;
+        pax = pacx;
+    }
+    free (pnod);
+    free (pbn);
+
+    // Dense LU factorization of the coarsest level
+    n = amgn[amgnlev-1];
+    amgdc = alloc_dbl (n*n);
+    amgpiv = alloc_int (n);
+    if (amgdc == NULL || amgpiv == NULL) {
+        return -1;
+    }
+    for (i = 0; i < n*n; ++i) {
+        *(amgdc+i) = 0;
+    }
+    for (i = 0; i < n; ++i) {
+        for (j = *(pap+i); j < *(pap+i+1); ++j) {
+            *(amgdc+*(pai+j)*n+i) = *(pax+j);
+        }
+    }
+    nci = (int) n;
+    dgetrf_(&nci, &nci, amgdc, &nci, amgpiv, &info);
+    if (info != 0) {
+        fprintf(OFP[0], "\n***WARNING*** Singular coarsest level; the multigrid preconditioner");
+        fprintf(OFP[0], " is not used\n");
+        amgfree ();
+        return 0;
+    }
+
+    *pdet = 0;
+    return 1;
+}
+
+void amgcycle (int lev, double *pb, double *px)
+{
+    // Initialize function variables
+    long i, j, n;
+    int nci, info, nrhs = 1;
+    char trans = 'N';
+    double s;
+
+    long *pap = amgap[lev];
+    long *pai = amgai[lev];
+    double *pax = amgax[lev];
+    n = amgn[lev];
+
+    // Coarsest level: direct solution
+    if (lev == amgnlev-1) {
+        for (i = 0; i < n; ++i) {
+            *(px+i) = *(pb+i);
+        }
+        nci = (int) n;
+        dgetrs_(&trans, &nci, &nrhs, amgdc, &nci, amgpiv, px, &nci, &info);
+        return;
+    }
+
+    // Pre-smoothing: one forward Gauss-Seidel sweep from a zero initial guess
+    for (i = 0; i < n; ++i) {
+        *(px+i) = 0;
+    }
+    for (i = 0; i < n; ++i) {
+        s = *(pb+i);
+        for (j = *(pap+i); j < *(pap+i+1); ++j) {
+            if (*(pai+j) != i) {
+                s -= *(pax+j) * (*(px+*(pai+j)));
+            }
+        }
+        *(px+i) = s / amgdiag (pap, pai, pax, i);
+    }
+
+    // Restrict the residual to the coarse level, solve there, and prolongate the correction
+    double *pr = amgr[lev];
+    for (i = 0; i < n; ++i) {
+        s = *(pb+i);
+        for (j = *(pap+i); j < *(pap+i+1); ++j) {
+            s -= *(pax+j) * (*(px+*(pai+j)));
+        }
+        *(pr+i) = s;
+    }
+    double *pbc = amgb[lev+1];
+    double *pxc = amgx[lev+1];
+    for (i = 0; i < amgn[lev+1]; ++i) {
+        *(pbc+i) = 0;
+    }
+    for (i = 0; i < n; ++i) {
+        for (j = *(amgpp[lev]+i); j < *(amgpp[lev]+i+1); ++j) {
+            *(pbc+*(amgpi[lev]+j)) += *(amgpx[lev]+j) * (*(pr+i));
+        }
+    }
+    amgcycle (lev+1, pbc, pxc);
+    for (i = 0; i < n; ++i) {
+        for (j = *(amgpp[lev]+i); j < *(amgpp[lev]+i+1); ++j) {
+            *(px+i) += *(amgpx[lev]+j) * (*(pxc+*(amgpi[lev]+j)));
+        }
+    }
+
+    // Post-smoothing: one backward Gauss-Seidel sweep, so that the V-cycle is symmetric
+    for (i = n-1; i >= 0; --i) {
+        s = *(pb+i);
+        for (j = *(pap+i); j < *(pap+i+1); ++j) {
+            if (*(pai+j) != i) {
+                s -= *(pax+j) * (*(px+*(pai+j)));
+            }
+        }
+        *(px+i) = s / amgdiag (pap, pai, pax, i);
+    }
+}
+
+int amgsolve (long *pmaxa, double *pss, double *pssd, double *pdd, int *pdet)
+{
+    // Initialize function variables
+    long i, it;
+    double rz, rzp, pq, alpha, bnrm, rnrm;
+
+    double *pb = alloc_dbl (NEQ);
+    double *px = alloc_dbl (NEQ);
+    double *pr = alloc_dbl (NEQ);
+    double *pz = alloc_dbl (NEQ);
+    double *pp = alloc_dbl (NEQ);
+    double *pw = alloc_dbl (NEQ);
+    if (pb == NULL || px == NULL || pr == NULL || pz == NULL || pp == NULL || pw == NULL) {
+        return -1;
+    }
+
+    /* Conjugate gradients preconditioned by one multigrid V-cycle; the products with the
+     matrix are computed on the skyline by skymult */
+    bnrm = 0;
+    for (i = 0; i < NEQ; ++i) {
+        *(pb+i) = *(pr+i) = *(pdd+i);
+        *(px+i) = 0;
+        bnrm += *(pb+i) * (*(pb+i));
+    }
+    bnrm = sqrt(bnrm);
+    rnrm = bnrm;
+    rzp = 1;
+    for (it = 0; it < AMGMAXIT && rnrm > AMGTOL * bnrm; ++it) {
+        amgcycle (0, pr, pz);
+        rz = 0;
+        for (i = 0; i < NEQ; ++i) {
+            rz += *(pr+i) * (*(pz+i));
+        }
+        for (i = 0; i < NEQ; ++i) {
+            if (it == 0) {
+                *(pp+i) = *(pz+i);
+            } else {
+                *(pp+i) = *(pz+i) + rz / rzp * (*(pp+i));
+            }
+            *(pw+i) = *(pp+i);
+        }
+        rzp = rz;
+        if (skymult (pmaxa, pss, pw) < 0) {
+            free (pb);
+            free (px);
+            free (pr);
+            free (pz);
+            free (pp);
+            free (pw);
+            return -1;
+        }
+        pq = 0;
+        for (i = 0; i < NEQ; ++i) {
+            pq += *(pp+i) * (*(pw+i));
+        }
+        if (pq <= 0) {
+            break; // The matrix is not positive definite
+        }
+        alpha = rz / pq;
+        rnrm = 0;
+        for (i = 0; i < NEQ; ++i) {
+            *(px+i) += alpha * (*(pp+i));
+            *(pr+i) -= alpha * (*(pw+i));
+            rnrm += *(pr+i) * (*(pr+i));
+        }
+        rnrm = sqrt(rnrm);
+    }
+
+    if (rnrm <= AMGTOL * bnrm) {
+        for (i = 0; i < NEQ; ++i) {
+            *(pdd+i) = *(px+i);
+        }
+        free (pb);
+        free (px);
+        free (pr);
+        free (pz);
+        free (pp);
+        free (pw);
+        return 1;
+    }
+
+    /* Factorize the skyline matrix in place and solve with it; the iterative solver is not
+     used for the remainder of the analysis */
+    fprintf(OFP[0], "\n***WARNING*** Conjugate gradient iterations did not converge; continuing");
+    fprintf(OFP[0], " with the skyline solver\n");
+    amgstall = 1;
+    amgfree ();
+    for (i = 0; i < NEQ; ++i) {
+        *(pdd+i) = *(pb+i);
+    }
+    skyfact(pmaxa, pss, pssd, pdd, 0, pdet);
+    skysolve (pmaxa, pss, pssd, pdd, 0, pdet);
+    free (pb);
+    free (px);
+    free (pr);
+    free (pz);
+    free (pp);
+    free (pw);
+
+    return 0;
+}
+
+void amgfree (void)
+{
+    // Initialize function variables
+    int lev;
+
+    // Release the multigrid hierarchy
+    for (lev = 0; lev < amgnlev; ++lev) {
+        free (amgap[lev]);
+        free (amgai[lev]);
+        free (amgax[lev]);
+        free (amgr[lev]);
+        free (amgb[lev]);
+        free (amgx[lev]);
+        if (lev < amgnlev-1) {
+            free (amgpp[lev]);
+            free (amgpi[lev]);
+            free (amgpx[lev]);
+        }
+    }
+    amgnlev = 0;
+    if (amgdc != NULL) {
+        free (amgdc);
+        free (amgpiv);
+        amgdc = NULL;
+        amgpiv = NULL;
+    }
+}
+
+void amgmodesfree (void)
+{
+    // Release the near null space modes
+    free (amgbn);
+    free (amgnod);
+    amgbn = NULL;
+    amgnod = NULL;
+}
@@ -36,9 +36,9 @@
 
 #define phitol 1e-4 // Allowable +/- deviation from 1.0 of phi
 
-extern long NJ, NE_TR, NE_FR, NE_SH, NE_SBR, NE_FBR, NEQ, SNDOF, FNDOF;
-extern int ANAFLAG, ALGFLAG, OPTFLAG, SLVFLAG, brFSI_FLAG, shFSI_FLAG;
-extern FILE *IFP[4], *OFP[8];
+extern BEN_TLS long NJ, NE_TR, NE_FR, NE_SH, NE_SBR, NE_FBR, NEQ, SNDOF, FNDOF;
+extern BEN_TLS int ANAFLAG, ALGFLAG, OPTFLAG, SLVFLAG, brFSI_FLAG, shFSI_FLAG;
+extern BEN_TLS FILE *IFP[4], *OFP[8];
 
 void prop_br (double *pemod, double *pnu, double *pyield, double *pdens, double *pfdens, double *pbmod,
 			   double *pfarea)
@@ -77,7 +77,7 @@ void prop_br (double *pemod, double *pnu, double *pyield, double *pdens, double
 
 
 void stiff_br (double *pss, double *px, double *pemod, double *pnu, long *pminc, 
-			   long *pmcode, long *pjcode, double *pJinv, double *pjac)
+			   long *pmcode, long *pjcode, double *pJinv, double *pjac, long *pmaxa)
 {
 	long NE_BR = NE_SBR + NE_FBR;
 	long ptr = NE_TR + NE_FR + NE_SH;
@@ -86,6 +86,8 @@ void stiff_br (double *pss, double *px, double *pemod, double *pnu, long *pminc,
     int  r, s, t;
 	double sum = 0;
 	
+    statbeg (ST_STIFF_BR);
+    
 	// Set up flags to determine whether the solid elements are shells or bricks
 	if (brFSI_FLAG == 1) {
 		NE_BR = NE_SBR + NE_FBR;
@@ -380,23 +382,47 @@ void stiff_br (double *pss, double *px, double *pemod, double *pnu, long *pminc,
 			}
 		}
 		
-		// Assemble system stiffness matrix - full order [NEQ][NEQ]
-		for (ie = 0; ie < 24; ++ie) {
+		if (SLVFLAG == 0 || SLVFLAG == 2) {
+			/* Assign element stiffness coefficients to the skyline stiffness array by index,
+			 mcode, and maxa */
 			for (je = 0; je < 24; ++je) {
-				
-                
-				j = *(pmcode+ptr3+i*24+ie);
 				k = *(pmcode+ptr3+i*24+je);
-                
-				if ((j != 0) && (k != 0)) {
-					*(pss+(j-1)*NEQ+k-1) += k_br[je][ie];
+				if (k != 0) {
+					// Check mcode above current entry to find rank of "k"
+					for (ie = 0; ie <= je; ++ie) {
+						j = *(pmcode+ptr3+i*24+ie);
+						if (j != 0) {
+							if (j > k) { // Find element address as diagonal address + delta
+								n = *(pmaxa+j-1) + (j - k);
+							} else {
+								n = *(pmaxa+k-1) + (k - j);
+							}
+							*(pss+n-1) += k_br[ie][je];
+						}
+					}
+				}
+			}
+		}
+		else {
+			// Assemble system stiffness matrix - full order [NEQ][NEQ]
+			for (ie = 0; ie < 24; ++ie) {
+				for (je = 0; je < 24; ++je) {
+					
+					j = *(pmcode+ptr3+i*24+ie);
+					k = *(pmcode+ptr3+i*24+je);
+					
+					if ((j != 0) && (k != 0)) {
+						*(pss+(j-1)*NEQ+k-1) += k_br[je][ie];
+					}
 				}
 			}
 		}
 	}	
+    
+    statend (ST_STIFF_BR, 0);
 }
 
-void mass_br (double *psm, double *pdens, double *px, long *pminc, long *pmcode, double *pjac)
+void mass_br (double *psm, double *pdens, double *px, long *pminc, long *pmcode, long *pmaxa, double *pjac)
 {
 	long NE_BR = NE_SBR + NE_FBR;
 	long ptr = NE_TR + NE_FR + NE_SH;
@@ -405,6 +431,8 @@ void mass_br (double *psm, double *pdens, double *px, long *pminc, long *pmcode,
     int  r, s, t;
 	double sum = 0;
 	
+    statbeg (ST_MASS_BR);
+    
 	// Set up flags to determine whether the solid elements are shells or bricks	
 	if (brFSI_FLAG == 1) {
 		NE_BR = NE_SBR + NE_FBR;
@@ -522,18 +550,55 @@ void mass_br (double *psm, double *pdens, double *px, long *pminc, long *pmcode,
 			}
 		}
 		
-		// Assemble system mass matrix - FULL ORDER [NEQ][NEQ]
-		for (ie = 0; ie < 24; ++ie) {
-			for (je = 0; je < 24; ++je) {
+		if (SLVFLAG == 0) {
+			/* The skyline solver holds the mass matrix as a diagonal vector, so that the
+			 element mass matrix is lumped by row sums */
+			for (ie = 0; ie < 24; ++ie) {
 				j = *(pmcode+ptr3+i*24+ie);
+				if (j != 0) {
+					for (je = 0; je < 24; ++je) {
+						*(psm+j-1) += m_br[ie][je];
+					}
+				}
+			}
+		}
+		else if (SLVFLAG == 2) {
+			/* Assign the consistent element mass components to the skyline mass array by index,
+			 mcode, and maxa */
+			for (je = 0; je < 24; ++je) {
 				k = *(pmcode+ptr3+i*24+je);
-				
-				if ((j != 0) && (k != 0)) {
-					*(psm+(j-1)*NEQ+k-1) += m_br[je][ie];
+				if (k != 0) {
+					// Check mcode above current entry to find rank of "k"
+					for (ie = 0; ie <= je; ++ie) {
+						j = *(pmcode+ptr3+i*24+ie);
+						if (j != 0) {
+							if (j > k) { // Find element address as diagonal address + delta
+								n = *(pmaxa+j-1) + (j - k);
+							} else {
+								n = *(pmaxa+k-1) + (k - j);
+							}
+							*(psm+n-1) += m_br[ie][je];
+						}
+					}
+				}
+			}
+		}
+		else {
+			// Assemble system mass matrix - FULL ORDER [NEQ][NEQ]
+			for (ie = 0; ie < 24; ++ie) {
+				for (je = 0; je < 24; ++je) {
+					j = *(pmcode+ptr3+i*24+ie);
+					k = *(pmcode+ptr3+i*24+je);
+					
+					if ((j != 0) && (k != 0)) {
+						*(psm+(j-1)*NEQ+k-1) += m_br[je][ie];
+					}
 				}
 			}
 		}
 	}
+    
+    statend (ST_MASS_BR, 0);
 }
 
 
@@ -34,18 +34,55 @@
 #include <math.h>
 #include "prototypes.h"
 
+#ifdef _OPENMP
+#  include <omp.h>
+#endif
+
+// CLAPACK header files
+#if defined(__APPLE__)
+#  include <Accelerate/Accelerate.h>
+#endif
+
 #define phitol 1e-4 // Allowable +/- deviation from 1.0 of phi
+#define FSITOL 1e-10 // Relative change of the interface pressures at which the coupling iterations stop
+#define FSIMAXIT 100 // Maximum number of coupling iterations per time step
+#define FSIMAXV 100 // Maximum number of secant pairs held by the interface quasi-Newton method
+#define FSIOMEGA 0.5 // Relaxation factor of the coupling iterations before a secant pair is known
+#define FSIEPS 1e-8 // Relative norm below which a secant pair is dropped as linearly dependent
+#define FSIKRYL 30 // Number of GMRES iterations between restarts
+#define FSIKRYLIT 1000 // Maximum number of GMRES iterations per time step
+
+extern BEN_TLS long NJ, NE_TR, NE_FR, NE_SH, NE_SBR, NE_FBR, NEQ, SNDOF, FNDOF, NTSTPS, ntstpsinpt;
+extern BEN_TLS double dt, ttot;
+extern BEN_TLS int ANAFLAG, ALGFLAG, OPTFLAG, SLVFLAG, ITFLAG, brFSI_FLAG, shFSI_FLAG;
+extern BEN_TLS FILE *IFP[4], *OFP[8];
+
+/* Coupling of the structure and the fluid (built by L_br): the wet fluid DOFs, i.e. the fluid
+ DOFs coupled to the structure, with the nonzero entries of the coupling matrix L = G*A held by
+ wet fluid DOF, the index of each fluid DOF among the wet fluid DOFs (-1 if it is dry), and the
+ diagonal of the area matrix A */
+static BEN_TLS long fsinw = 0;
+static BEN_TLS long *fsiwet = NULL, *fsilp = NULL, *fsils = NULL, *fsiwi = NULL;
+static BEN_TLS double *fsilx = NULL, *fsia = NULL;
+static BEN_TLS double fsirho = 0;
+
+/* Partitioned FSI solver (SLVFLAG = 0): the secant pairs of the interface quasi-Newton method
+ (differences of the interface residuals and of the fluid responses, newest first), which are
+ kept between time steps since the coupled problem is linear */
+static BEN_TLS int fsinv = 0, fsiwarn = 0;
+static BEN_TLS double *fsiv = NULL, *fsiw = NULL, *fsiq = NULL, *fsir = NULL, *fsiwk = NULL, *fsid = NULL;
 
-extern long NJ, NE_TR, NE_FR, NE_SH, NE_SBR, NE_FBR, NEQ, SNDOF, FNDOF, NTSTPS, ntstpsinpt;
-extern double dt, ttot;
-extern int ANAFLAG, ALGFLAG, OPTFLAG, SLVFLAG, brFSI_FLAG, shFSI_FLAG;
-extern FILE *IFP[4], *OFP[8];
+/* Monolithic FSI solver on the skyline arrays (SLVFLAG = 4): the Krylov basis of the restarted
+ GMRES method, the Hessenberg matrix with the Givens rotations reducing it, the row scaling of
+ the residual, and work vectors */
+static BEN_TLS double *fsikv = NULL, *fsikh = NULL, *fsikc = NULL, *fsiks = NULL, *fsikg = NULL;
+static BEN_TLS double *fsikd = NULL, *fsikz = NULL, *fsikw = NULL;
 
 void prop_fsi (double *px, double *pemod, double *pnu, double *pdens, double *pfdens, double *pbmod,
 			  double *pfarea, 
 			  double *pslength, double *pyield, long *pminc, long *pelface, long *pfsiinc, 
 			  double *pnnorm, double *ptarea, double *pss, double *pss_fsi, double *psd_fsi, double *pabspt,
-			  double *pnorpt, long *pmcode, long *pjcode, double *pL)
+			  double *pnorpt, long *pmcode, long *pjcode)
 {
 	
     // Initialize function variables
@@ -122,7 +159,7 @@ void prop_fsi (double *px, double *pemod, double *pnu, double *pdens, double *pf
     for (i = 0; i < NE_FBR; ++i) {
         for (j = 0; j < 8; ++j) {
             jt = *(pminc+ nsolids*nnps+i*8+j) - 1;
-            if (*(pabspt+jt-1) > 0) {// absorbing point
+            if (*(pabspt+jt) > 0) {// absorbing point
                 dof = *(pjcode+jt*7+6); //fdof
                 if (dof != 0) {
                     *(psd_fsi+dof-1) = *(pabspt+jt);
@@ -310,13 +347,13 @@ void prop_fsi (double *px, double *pemod, double *pnu, double *pdens, double *pf
 							*(pnnorm+(jt-1)*3+2) == *(normals+i*nfps*nnpfsif*3+j*nnpfsif*3+k*3+2)) {
 							
 							*(ptarea+jt-1) += Afact*farea[i*nfps*nnpfsif+j*nnpfsif];
-							fctyp[jt] = 1;
+							fctyp[jt-1] = 1;
 						}
 						
 						// f-s faces are on the same element
 						else {
 							*(ptarea+jt-1) += pow((Afact*farea[i*nfps*nnpfsif+j*nnpfsif]),2);
-							fctyp[jt] = 0;
+							fctyp[jt-1] = 0;
 						}
 					}
 				}
@@ -324,28 +361,40 @@ void prop_fsi (double *px, double *pemod, double *pnu, double *pdens, double *pf
 		}
         
 		
-		if (fctyp[jt] == 0) {
+		if (fctyp[jt-1] == 0) {
 			*(ptarea+jt-1) = sqrt(*(ptarea+jt-1));
 		}
 	}
 }
 
-void stiff_fsi (long *pminc, long *pmcode, long *pjcode, double *pnnorm, double *ptarea, double *pfarea, double *pthick,
-				double *pdeffarea, double *pslength, double *pdefslen, double *pL, double *pA, double *pss, double *pss_fsi, 
+void stiff_fsi (long *pminc, long *pmcode, long *pjcode, double *pnnorm, double *ptarea, double *pthick,
+				double *pshb, double *pdeffarea, double *pdefslen, double *pss, double *pss_fsi, 
 				double *px, double *pxlocal, double *pemod, double *pnu, double *pJinv, double *pjac, double *pyield, 
 				double *pc1, double *pc2, double *pc3, double *pef, double *pd, double *pchi, double *pefN, double *pefM, long *pmaxa)
 {
 
-	long i, j;
+	long i, j, k, lss;
+	
+	// Initialize the system stiffness array (skyline or full order) to zero
+	lss = (SLVFLAG == 0 || SLVFLAG == 2) ? *(pmaxa+NEQ)-1 : NEQ*NEQ;
+	for (i = 0; i < lss; ++i) {
+		*(pss+i) = 0;
+	}
 	
 	/* Pass control to the stiff_br function to build the partitioned
 	 matrix within the system stiffness matrix*/
 
-    stiff_br (pss, px, pemod, pnu, pminc, pmcode, pjcode, pJinv, pjac);	
+    stiff_br (pss, px, pemod, pnu, pminc, pmcode, pjcode, pJinv, pjac, pmaxa);	
 
 	if (shFSI_FLAG == 1) {
-		stiff_sh (pss, pemod, pnu, px, pxlocal, pthick, pfarea, pdeffarea, pslength,
-				  pdefslen, pyield, pc1, pc2, pc3, pef, pd, pchi, pefN, pefM, pmaxa, pminc, pmcode);
+		stiff_sh (pss, pemod, pnu, px, pxlocal, pthick, pshb, pdeffarea, pdefslen,
+				  pyield, pc1, pc2, pc3, pef, pd, pchi, pefN, pefM, pmaxa, pminc, pmcode);
+	}
+	
+	/* The partitioned and sparse solvers work on the skyline of the uncoupled structure and
+	 fluid (K and H) and on the coupling matrix L, so that the coupled matrix is not formed */
+	if (SLVFLAG == 0 || SLVFLAG == 2) {
+		return;
 	}
 	
 	// Initialize the system "stiffness" matrix to zero
@@ -374,35 +423,39 @@ void stiff_fsi (long *pminc, long *pmcode, long *pjcode, double *pnnorm, double
 	}
 	
 	// Assemble L
-	for (i = 0; i < SNDOF; ++i) {
-		for (j = SNDOF; j < NEQ; ++j) {
-			if (*(pL+i*FNDOF+j-SNDOF) != 0) {
-				*(pss_fsi+i*NEQ+j) = *(pL+i*FNDOF+j-SNDOF);
-			}
+	for (i = 0; i < fsinw; ++i) {
+		j = SNDOF + *(fsiwet+i);
+		for (k = *(fsilp+i); k < *(fsilp+i+1); ++k) {
+			*(pss_fsi+*(fsils+k)*NEQ+j) = *(fsilx+k);
 		}
 	}
 
 }
 
 void mass_fsi (long *pminc, long *pmcode, long *pjcode, double *pnnorm, double *ptarea, double *pcarea, double *pfarea, 
-               double *pthick, double *pslength, double *pL, double *pLT, double *psm, double *psm_fsi, double *px, 
-               double *pdens, double *pfdens, double *pJinv, double *pjac)
+               double *pthick, double *pslength, double *psm, double *psm_fsi, double *px, 
+               double *pdens, double *pfdens, double *pJinv, double *pjac, long *pmaxa)
 {
 	
-	long i, j;
+	long i, j, k;
     
-	for (i = 0; i < FNDOF; ++i) {
-		for (j = 0; j < SNDOF; ++j) {
-			*(pLT+i*SNDOF+j) = 0;
-		}
+	// Initialize the system mass array (lumped diagonal, skyline or full order) to zero
+	for (i = 0; i < ((SLVFLAG == 0) ? NEQ : ((SLVFLAG == 2) ? *(pmaxa+NEQ)-1 : NEQ*NEQ)); ++i) {
+		*(psm+i) = 0;
 	}
 	
-	mass_br (psm, pdens, px, pminc, pmcode, pjac);	
+	mass_br (psm, pdens, px, pminc, pmcode, pmaxa, pjac);	
     
     if (shFSI_FLAG == 1) {
-		mass_sh (psm, pcarea, pdens, pthick, pfarea, pslength, px, pminc, pmcode, pjac);
+		mass_sh (psm, pcarea, pdens, pthick, pfarea, pslength, px, pminc, pmcode, pmaxa, pjac);
 	}
     
+	/* The partitioned and sparse solvers work on the mass of the uncoupled structure and
+	 fluid (M and Q); the coupling -rho*L^T is applied by fsimass or merged by fsicsc */
+	if (SLVFLAG == 0 || SLVFLAG == 2) {
+		return;
+	}
+	
 	// Initialize the system "mass" matrix to zero
 	for (i = 0; i < NEQ; ++i) {
 		for (j = 0; j < NEQ; ++j) {
@@ -428,134 +481,143 @@ void mass_fsi (long *pminc, long *pmcode, long *pjcode, double *pnnorm, double *
 		}
 	}
 	
-	// Transpose(L)
-	// Assemble L
-	for (i = 0; i < SNDOF; ++i) {
-		for (j = 0; j < FNDOF; ++j) {
-			*(pLT+j*SNDOF+i) = *(pL+i*FNDOF+j);
+	// Assemble lower left corner of system "mass" matrix, -rho*Transpose(L)
+	for (i = 0; i < fsinw; ++i) {
+		j = SNDOF + *(fsiwet+i);
+		for (k = *(fsilp+i); k < *(fsilp+i+1); ++k) {
+			*(psm_fsi+j*NEQ+*(fsils+k)) = -1*(*pfdens) * (*(fsilx+k));
 		}
 	}
-	
-	// Assemble lower left corner of system "mass" matrix
-	for (i = SNDOF; i < NEQ; ++i) {
-		for (j = 0; j < SNDOF; ++j) {
-			*(psm_fsi+i*NEQ+j) = -1*(*pfdens) * (*(pLT+(i-SNDOF)*SNDOF+j));
-		}
-	}	
 }
 
-void L_br (long *pminc, long *pmcode, long *pjcode, long *pjcode_fsi, double *pnnorm, double *ptarea,
-		   double *pL, double *pA, double *pG)
+int L_br (long *pelface, long *pfsiinc, long *pjcode, double *pnnorm, double *ptarea, double *pfdens)
 {
-	long NE_BR = NE_SBR + NE_FBR;
-	long i, j, m, jt;
+	long i, j, l, m, n, f, jt;
     
     int nnpfsif; // Num nodes per FSI face; = 3 if solids are shells; = 4 if solid are bricks
-    int nnps; // Num nodes per solid
     int nfps; // Num faces per solid
     int nsolids;
-    int ndofpe; // Number of dofs per solid 
-    int ndofspn; // Number of dofs per node
     
     if (shFSI_FLAG == 1) {
         nnpfsif = 3;
-        nnps = 3;
         nfps = 1;
         nsolids = NE_SH;
-        ndofpe = 18;
-        ndofspn = 6;
     }
     
     if (brFSI_FLAG == 1) {
         nnpfsif = 4;
-        nnps = 8;
         nfps = 6;
         nsolids = NE_SBR;
-        ndofpe = 24;
-        ndofspn = 3;
     }
-    
-    NE_BR = NE_FBR+nsolids;
 	
-	// Variables for building G, A, and L matrices
-	int fdof, sdof[3];
-	int found = 0;
-	double sum = 0.0;
+	// Variables for building L = G*A, one column (fluid DOF) at a time
+	long sdof[3], ts;
+	double lx[3], tx;
 	
-	// Initialize G and L matrices
-	for (i = 0; i < SNDOF; ++i) {
-		for (j = 0; j < FNDOF; ++j) {
-     		*(pG+i*FNDOF+j) = 0;
-			*(pL+i*FNDOF+j) = 0;
-		}
+	fsirho = *pfdens;
+	
+	fsiwi = alloc_long (FNDOF+1);
+	fsia = alloc_dbl (FNDOF+1);
+	if (fsiwi == NULL || fsia == NULL) {
+		return 1;
 	}
 	
-	// Initialize A matrix
-	for (i = 0; i < FNDOF; ++i) {
-		for (j = 0; j < FNDOF; ++j) {
-			*(pA+i*FNDOF+j) = 0;
-		}
+	/* Populate the diagonal of A by looping through the joints of the f-s faces; the wet
+	 index array holds the joint of each fluid DOF until L is built */
+	for (f = 0; f < FNDOF; ++f) {
+		*(fsiwi+f) = -1;
 	}
-
-	/* Populate G and A matrices by looping through solid elements to find
-	 f-s faces*/
 	for (i = 0; i < nsolids; ++i) { // Solid elements
-		
-		for (j = 0; j < nnps; ++j) { //Solid element dofs
-			
-			jt = *(pminc+i*nnps+j) - 1; // Gloal joint
-			
-			// Check whether the joint has a pressure DOF
-            if (*(pjcode+jt*7+6) != 0) { 
-                
-				fdof = *(pjcode+jt*7+6) - SNDOF; // Fluid DOF
+		for (j = 0; j < *(pelface+i); ++j) { // f-s faces of the element
+			for (l = 0; l < nnpfsif; ++l) {
 				
-				*(pA+(fdof-1)*FNDOF+fdof-1) = *(ptarea+jt);
-				for (m = 0; m < 3; ++m) {
-					
-                    sdof[m] = *(pjcode+jt*7+m);
-					*(pG+(sdof[m]-1)*FNDOF+fdof-1) = *(pnnorm+jt*3+m);
+				jt = *(pfsiinc+i*nfps*nnpfsif+j*nnpfsif+l) - 1; // Global joint
+				
+				// Check whether the joint has a pressure DOF
+				if (jt >= 0 && *(pjcode+jt*7+6) != 0) {
+					f = *(pjcode+jt*7+6) - SNDOF - 1; // Fluid DOF
+					*(fsiwi+f) = jt;
+					*(fsia+f) = *(ptarea+jt);
 				}
 			}
 		}
 	}
-
-	for (i = 0; i < FNDOF; ++i) {
-		if (*(pA+i*FNDOF+i) != 0) {
-			for (j = 0; j < SNDOF; ++j) {
-                sum = *(pG+j*FNDOF+i) * (*(pA+i*FNDOF+i));
-				*(pL+j*FNDOF+i) = sum;
+	
+	/* Column f of G holds the joint normal on the active translational DOFs of the joint of
+	 fluid DOF f; count the wet fluid DOFs and the nonzero entries of L */
+	fsinw = n = 0;
+	for (f = 0; f < FNDOF; ++f) {
+		jt = *(fsiwi+f);
+		if (jt < 0 || *(fsia+f) == 0) {
+			continue;
+		}
+		l = 0;
+		for (m = 0; m < 3; ++m) {
+			if (*(pjcode+jt*7+m) != 0 && *(pnnorm+jt*3+m) * (*(fsia+f)) != 0) {
+				++l;
 			}
 		}
+		n += l;
+		fsinw += (l > 0) ? 1 : 0;
+	}
+	
+	fsiwet = alloc_long (fsinw+1);
+	fsilp = alloc_long (fsinw+1);
+	fsils = alloc_long (n+1);
+	fsilx = alloc_dbl (n+1);
+	if (fsiwet == NULL || fsilp == NULL || fsils == NULL || fsilx == NULL) {
+		return 1;
+	}
+	
+	// Hold the nonzero entries of L by wet fluid DOF, in ascending order of the structure DOFs
+	fsinw = n = 0;
+	*(fsilp) = 0;
+	for (f = 0; f < FNDOF; ++f) {
+		jt = *(fsiwi+f);
+		*(fsiwi+f) = -1;
+		if (jt < 0 || *(fsia+f) == 0) {
+			continue;
+		}
+		l = 0;
+		for (m = 0; m < 3; ++m) {
+			sdof[l] = *(pjcode+jt*7+m) - 1;
+			lx[l] = *(pnnorm+jt*3+m) * (*(fsia+f));
+			if (sdof[l] < 0 || lx[l] == 0) {
+				continue;
+			}
+			for (j = l; j > 0 && sdof[j-1] > sdof[j]; --j) {
+				ts = sdof[j]; sdof[j] = sdof[j-1]; sdof[j-1] = ts;
+				tx = lx[j]; lx[j] = lx[j-1]; lx[j-1] = tx;
+			}
+			++l;
+		}
+		for (m = 0; m < l; ++m) {
+			*(fsils+n) = sdof[m];
+			*(fsilx+n) = lx[m];
+			++n;
+		}
+		if (n > *(fsilp+fsinw)) {
+			*(fsiwet+fsinw) = f;
+			*(fsiwi+f) = fsinw;
+			++fsinw;
+			*(fsilp+fsinw) = n;
+		}
 	}
+	return 0;
 }
 
 
-void load_fsi (long *pjcode, double *ptinpt, double *ppinpt, double *ppresinpt, double *paccinpt, double *pfdens,
-			   double *pum, double *pvm, double *pam)
+int load_fsi (long *pjcode, double *ptinpt, long *ppinpt_h, double *ppinpt, long *ppres_h, double *ppresinpt,
+			  long *pacc_h, double *paccinpt, double *pfdens, double *pum, double *pvm, double *pam)
 
 {
 	
-	long i, j, k, kps, kpf, ks, kf, jt;
-	int dir;
+	long i, k, kps, kpf, ks, kf, jt;
+	int dir, err = 0;
 	double load, p, a;
 	
 	ntstpsinpt = ttot/dt + 1;
 	
-	// Initialize input loads, and fluid pressures and accelerations to zero
-	for (i = 0; i < SNDOF; ++i) {
-		for (j = 0; j < ntstpsinpt; ++j) {
-			*(ppinpt+i*ntstpsinpt+j) = 0;
-		}
-	}
-	
-	for (i = 0; i < FNDOF; ++i) {
-		for (j = 0; j < ntstpsinpt; ++j) {
-			*(ppresinpt+i*ntstpsinpt+j) = 0;
-			*(paccinpt+i*ntstpsinpt+j) = 0;
-		}
-	}
-
 	// Initialize first element in time array to be zero
 	*(ptinpt) = 0;
 	
@@ -595,25 +657,25 @@ void load_fsi (long *pjcode, double *ptinpt, double *ppinpt, double *ppresinpt,
                 case (0):
                     break; // Do not store loads at supports
                 default:
-					*(ppinpt+(ks-1)*ntstpsinpt+i) = load;
+					err += histput (ppinpt_h, ppinpt, ks-1, i, load);
                     break;
             }
 			kps = ks; 
-			
-			if (kf != kpf) {
-				//i = 0;
-			}
             
 			switch (kf) {
                 case (0):
                     break; // Do not store loads at supports
                 default:
-					*(ppresinpt+(kf-SNDOF-1)*ntstpsinpt+i) = p;
-					*(paccinpt+(kf-SNDOF-1)*ntstpsinpt+i) = a;
+					err += histput (ppres_h, ppresinpt, kf-SNDOF-1, i, p);
+					err += histput (pacc_h, paccinpt, kf-SNDOF-1, i, a);
                     break;
             }
 			kpf = kf;
 			
+			if (err != 0) {
+				return 1;
+			}
+			
 			++i;
 			
             fscanf(IFP[0], "%ld,%d,%lf,%lf,%lf\n", &jt, &dir, &load, &p, &a);
@@ -667,20 +729,69 @@ void load_fsi (long *pjcode, double *ptinpt, double *ppinpt, double *ppresinpt,
 	}
 	
 	NTSTPS = ttot/dt + 1;
-    
+	
+	return 0;
 }
 
 
-void q_fsi (long *pjcode, double *pqdyn, double *ptstps, double *papload, double *ppres, double *pacc, 
-			double *pL, double *pA, double *pLp, double *pAu, double *pfdens, double *ptinpt, double *ppinpt, double *ppresinpt, double *paccinpt)
+long nq_fsi (long *ppinpt_h, long *ppres_h, long *pacc_h)
 
 {
 	// Initialize function variables
-	long i, j, k;
-	double sum;
-	double load, p, a;
+	long i, n;
 	
-	double slopef, slopep, slopea; // Slopes for linear interpolation
+	// Count the DOFs of the load array which are coupled to an input load history
+	n = 0;
+	for (i = 0; i < NEQ; ++i) {
+		n += qrow_fsi (i, ppinpt_h, ppres_h, pacc_h);
+	}
+	return n;
+}
+
+
+int qrow_fsi (long i, long *ppinpt_h, long *ppres_h, long *pacc_h)
+
+{
+	// Initialize function variables
+	long j, k, f;
+	
+	if (i < SNDOF) {
+		// Solid DOF is loaded directly or through the pressure on a wetted face
+		if (histrow (ppinpt_h, i) != 0) {
+			return 1;
+		}
+		for (j = 0; j < histrows (ppres_h); ++j) {
+			f = *(fsiwi+histdof (ppres_h, j));
+			if (f < 0) {
+				continue;
+			}
+			for (k = *(fsilp+f); k < *(fsilp+f+1); ++k) {
+				if (*(fsils+k) == i) {
+					return 1;
+				}
+			}
+		}
+	} else {
+		// Fluid DOF is loaded through the incident accelerations
+		for (j = 0; j < histrows (pacc_h); ++j) {
+			f = histdof (pacc_h, j);
+			if (f == i-SNDOF && *(fsia+f) != 0) {
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+
+int q_fsi (long *pjcode, long *pqdyn_h, double *pqdyn, double *ptstps, double *pfdens,
+		   double *ptinpt, long *ppinpt_h, double *ppinpt, long *ppres_h, double *ppresinpt, long *pacc_h,
+		   double *paccinpt)
+
+{
+	// Initialize function variables
+	long i, j, k, l, m, f;
+	double sum, lx, t0, t1;
 	
 	// Assemble time array based on actual time step
 	*(ptstps) = *(ptinpt);
@@ -691,113 +802,738 @@ void q_fsi (long *pjcode, double *pqdyn, double *ptstps, double *papload, double
 	// Assign the last time value equal to the last input time value
 	*(ptstps+NTSTPS-1) = *(ptinpt+ntstpsinpt-1);
 	
-	// Initialize applied load array
-	for (i = 0; i < SNDOF; ++i) {
-		for (j = 0; j < NTSTPS; ++j) {
-			*(papload+i*NTSTPS+j) = 0;
+	/* Evaluate the load array one DOF at a time, only for those DOFs coupled to an input
+	 load history; applied loads, fluid pressures and fluid incident accelerations are
+	 linearly interpolated between the input times */
+	for (j = 0; j < NEQ; ++j) {
+		if (qrow_fsi (j, ppinpt_h, ppres_h, pacc_h) == 0) {
+			continue;
+		}
+		
+		k = 0;
+		for (i = 0; i < NTSTPS; ++i) {
+			if (i < NTSTPS-1) {
+				t0 = *(ptinpt+k);
+				t1 = *(ptinpt+k+1);
+			} else {
+				// Assign the last value to be equal to the last input value
+				k = ntstpsinpt-1;
+				t0 = *(ptstps+i);
+				t1 = t0 + 1;
+			}
+			
+			if (j < SNDOF) {
+				// Calculate the solid DOFs of the load array, q = p - L*pres
+				sum = 0;
+				for (l = 0; l < histrows (ppres_h); ++l) {
+					f = histdof (ppres_h, l);
+					if (*(fsiwi+f) < 0) {
+						continue;
+					}
+					lx = 0;
+					for (m = *(fsilp+*(fsiwi+f)); m < *(fsilp+*(fsiwi+f)+1); ++m) {
+						if (*(fsils+m) == j) {
+							lx = *(fsilx+m);
+						}
+					}
+					sum += lx * ((histval (ppres_h, ppresinpt, f, k+1) - histval (ppres_h, ppresinpt, f, k))
+						/ (t1 - t0) * (*(ptstps+i) - t0) + histval (ppres_h, ppresinpt, f, k));
+				}
+				sum = (histval (ppinpt_h, ppinpt, j, k+1) - histval (ppinpt_h, ppinpt, j, k)) / (t1 - t0)
+					* (*(ptstps+i) - t0) + histval (ppinpt_h, ppinpt, j, k) - sum;
+			} else {
+				// Evaluate the fluid DOFs of the load array, q = -rho*A*acc
+				sum = 0;
+				for (l = 0; l < histrows (pacc_h); ++l) {
+					f = histdof (pacc_h, l);
+					if (f != j-SNDOF) {
+						continue;
+					}
+					sum += *(fsia+f) * ((histval (pacc_h, paccinpt, f, k+1) - histval (pacc_h, paccinpt, f, k))
+						/ (t1 - t0) * (*(ptstps+i) - t0) + histval (pacc_h, paccinpt, f, k));
+				}
+				sum = -1*(*(pfdens)) * sum;
+			}
+			
+			if (histput (pqdyn_h, pqdyn, j, i, sum) == 1) {
+				return 1;
+			}
+			
+			if (i < NTSTPS-1 && *(ptstps+i+1) >= *(ptinpt+k+1)) {
+				++k;
+			}
 		}
 	}
+	return 0;
+}
+
+
+int fsicoup (void)
+
+{
+	fsinv = 0;
 	
-	// Initialize fluid pressure and acceleration arrays
-	for (i = 0; i < FNDOF; ++i) {
-		for (j = 0; j < NTSTPS; ++j) {
-			*(ppres+i*NTSTPS+j) = 0;
-			*(pacc+i*NTSTPS+j) = 0;
+	fsid = alloc_dbl (NEQ);
+	if (fsid == NULL) {
+		return 1;
+	}
+	if (ITFLAG == 1) {
+		fsikv = alloc_dbl (NEQ*(FSIKRYL+1));
+		fsikh = alloc_dbl ((FSIKRYL+1)*FSIKRYL);
+		fsikc = alloc_dbl (FSIKRYL);
+		fsiks = alloc_dbl (FSIKRYL);
+		fsikg = alloc_dbl (FSIKRYL+1);
+		fsikd = alloc_dbl (NEQ);
+		fsikz = alloc_dbl (NEQ);
+		fsikw = alloc_dbl (NEQ);
+		if (fsikv == NULL || fsikh == NULL || fsikc == NULL || fsiks == NULL || fsikg == NULL ||
+			fsikd == NULL || fsikz == NULL || fsikw == NULL) {
+			return 1;
+		}
+	}
+	else {
+		fsiv = alloc_dbl (fsinw*FSIMAXV+1);
+		fsiw = alloc_dbl (fsinw*FSIMAXV+1);
+		fsiq = alloc_dbl (fsinw*FSIMAXV+1);
+		fsir = alloc_dbl (FSIMAXV*FSIMAXV+FSIMAXV);
+		fsiwk = alloc_dbl (fsinw*5+1);
+		if (fsiv == NULL || fsiw == NULL || fsiq == NULL || fsir == NULL || fsiwk == NULL) {
+			return 1;
 		}
 	}
 	
-	k = 0;
-	i = 0;
-	do {
-		// Interpolate applied loads
-		for (j = 0; j < SNDOF; ++j) {			
-			slopef = (*(ppinpt+j*ntstpsinpt+k+1) - *(ppinpt+j*ntstpsinpt+k)) / (*(ptinpt+k+1) - *(ptinpt+k));			
-			*(papload+j*NTSTPS+i) = slopef*(*(ptstps+i) - *(ptinpt+k)) + *(ppinpt+j*ntstpsinpt+k);
+	if (ITFLAG == 1) {
+		fprintf(OFP[0], "\nMonolithic FSI solution by GMRES:\n\tWet fluid DOFs: %ld\n", fsinw);
+	}
+	else {
+		fprintf(OFP[0], "\nPartitioned FSI solution:\n\tWet fluid DOFs: %ld\n", fsinw);
+	}
+	return 0;
+}
+
+
+void fsimass (double *pu, double *pr, double c)
+
+{
+	// Initialize function variables
+	long i, k;
+	double sum;
+	
+	// Add c times the fluid rows of the coupled mass matrix, -rho*L^T, applied to u
+	for (i = 0; i < fsinw; ++i) {
+		sum = 0;
+		for (k = *(fsilp+i); k < *(fsilp+i+1); ++k) {
+			sum += *(fsilx+k) * (*(pu+*(fsils+k)));
 		}
-		
-		// Interpolate fluid  pressure and fluid incident accelerations
-		for (j = 0; j < FNDOF; ++j) {
+		*(pr+SNDOF+*(fsiwet+i)) -= c * fsirho * sum;
+	}
+}
+
+
+void fsicsc (int *pAp, int *pAi, double *pAx, double c0, int flag)
+
+{
+	// Initialize function variables
+	long i, k, s, f, n;
+	double v;
+	
+	/* The coupling blocks of the effective stiffness matrix are L in the rows of the structure
+	 and the columns of the fluid, and -c0*rho*L^T in the rows of the fluid and the columns of
+	 the structure. The rows of a fluid column precede its skyline entries and those of a
+	 structure column follow them, so that the columns stay sorted */
+	for (i = 0; i < fsinw; ++i) {
+		f = SNDOF + *(fsiwet+i);
+		for (k = *(fsilp+i); k < *(fsilp+i+1); ++k) {
+			s = *(fsils+k);
 			
-			slopep = (*(ppresinpt+j*ntstpsinpt+k+1) - *(ppresinpt+j*ntstpsinpt+k)) / (*(ptinpt+k+1) - *(ptinpt+k));
-			slopea = (*(paccinpt+j*ntstpsinpt+k+1) - *(paccinpt+j*ntstpsinpt+k)) / (*(ptinpt+k+1) - *(ptinpt+k));
+			// Column f, row s (flag 0 counts both entries, flag 1 appends this one)
+			v = *(fsilx+k);
+			if (fabs(v) > 1e-10 && flag == 0) {
+				(*(pAp+f+1))++;
+			}
+			else if (fabs(v) > 1e-10 && flag == 1) {
+				n = (*(pAp+f+1))++;
+				*(pAi+n) = s;
+				*(pAx+n) = v;
+			}
 			
-			*(ppres+j*NTSTPS+i) = slopep*(*(ptstps+i)-*(ptinpt+k)) + *(ppresinpt+j*ntstpsinpt+k);
-			*(pacc+j*NTSTPS+i) = slopea*(*(ptstps+i)-*(ptinpt+k)) + *(paccinpt+j*ntstpsinpt+k);
+			// Column s, row f (flag 2 appends this one)
+			v = -c0 * fsirho * (*(fsilx+k));
+			if (fabs(v) > 1e-10 && flag == 0) {
+				(*(pAp+s+1))++;
+			}
+			else if (fabs(v) > 1e-10 && flag == 2) {
+				n = (*(pAp+s+1))++;
+				*(pAi+n) = f;
+				*(pAx+n) = v;
+			}
+		}
+	}
+}
+
+
+int fsisolve (long *pmaxa, double *pKeff, double *pReff, double *pum, double c0)
+
+{
+	// Initialize function variables
+	long i, j, k, l, m, it;
+	double nrm, nrm0, rnrm, pnrm, sum;
+	
+	// Interface pressures and fluid responses, residuals, and those of the previous iteration
+	double *pxt = fsiwk;
+	double *pxh = fsiwk+fsinw;
+	double *prs = fsiwk+2*fsinw;
+	double *prm = fsiwk+3*fsinw;
+	double *pxm = fsiwk+4*fsinw;
+	double *pc = fsir+FSIMAXV*FSIMAXV;
+	
+	/* The effective stiffness matrix is [Ks L; -c0*rho*L^T Kf], where the skyline holds the
+	 factorization of the uncoupled blocks Ks and Kf; the structure is loaded by the interface
+	 pressures and the fluid by the structural accelerations (Gauss-Seidel), and the interface
+	 pressures are updated by the quasi-Newton method with an approximation of the inverse
+	 Jacobian from least squares (IQN-ILS, Degroote et al. 2009) */
+	for (i = 0; i < fsinw; ++i) {
+		*(pxt+i) = *(pum+SNDOF+*(fsiwet+i));
+	}
+	
+	for (it = 0; it < FSIMAXIT; ++it) {
+		
+		// Solve for the structure loaded by the interface pressures, Ks*u = Rs - L*p
+		for (i = 0; i < SNDOF; ++i) {
+			*(fsid+i) = *(pReff+i);
+		}
+		for (i = 0; i < fsinw; ++i) {
+			for (k = *(fsilp+i); k < *(fsilp+i+1); ++k) {
+				*(fsid+*(fsils+k)) -= *(fsilx+k) * (*(pxt+i));
+			}
+		}
+		skyrange (pmaxa, pKeff, fsid, 0, SNDOF);
+		
+		// Solve for the fluid loaded by the structure, Kf*p = Rf + c0*rho*L^T*u
+		for (i = SNDOF; i < NEQ; ++i) {
+			*(fsid+i) = *(pReff+i);
+		}
+		fsimass (fsid, fsid, -c0);
+		skyrange (pmaxa, pKeff, fsid, SNDOF, NEQ);
+		
+		// Interface residual
+		rnrm = pnrm = 0;
+		for (i = 0; i < fsinw; ++i) {
+			*(pxh+i) = *(fsid+SNDOF+*(fsiwet+i));
+			*(prs+i) = *(pxh+i) - *(pxt+i);
+			rnrm += *(prs+i) * (*(prs+i));
+			pnrm += *(pxh+i) * (*(pxh+i));
+		}
+		if (rnrm <= FSITOL * FSITOL * pnrm) {
+			break;
+		}
+		
+		/* Add the secant pair of the last two iterations, dropping the oldest pair once
+		 FSIMAXV pairs are held */
+		if (it > 0) {
+			m = (fsinv < FSIMAXV) ? fsinv : FSIMAXV-1;
+			for (j = m; j > 0; --j) {
+				for (i = 0; i < fsinw; ++i) {
+					*(fsiv+j*fsinw+i) = *(fsiv+(j-1)*fsinw+i);
+					*(fsiw+j*fsinw+i) = *(fsiw+(j-1)*fsinw+i);
+				}
+			}
+			for (i = 0; i < fsinw; ++i) {
+				*(fsiv+i) = *(prs+i) - *(prm+i);
+				*(fsiw+i) = *(pxh+i) - *(pxm+i);
+			}
+			fsinv = m+1;
+		}
+		for (i = 0; i < fsinw; ++i) {
+			*(prm+i) = *(prs+i);
+			*(pxm+i) = *(pxh+i);
 		}
-		++i;
 		
-		if (*(ptstps+i) >= *(ptinpt+k+1)) {
-			++k;
+		/* QR factorization of the residual differences by modified Gram-Schmidt; pairs which
+		 are (nearly) linearly dependent on newer pairs are dropped */
+		m = 0;
+		for (j = 0; j < fsinv; ++j) {
+			nrm0 = 0;
+			for (i = 0; i < fsinw; ++i) {
+				*(fsiq+m*fsinw+i) = *(fsiv+j*fsinw+i);
+				nrm0 += *(fsiv+j*fsinw+i) * (*(fsiv+j*fsinw+i));
+			}
+			for (l = 0; l < m; ++l) {
+				sum = 0;
+				for (i = 0; i < fsinw; ++i) {
+					sum += *(fsiq+l*fsinw+i) * (*(fsiq+m*fsinw+i));
+				}
+				*(fsir+l*FSIMAXV+m) = sum;
+				for (i = 0; i < fsinw; ++i) {
+					*(fsiq+m*fsinw+i) -= sum * (*(fsiq+l*fsinw+i));
+				}
+			}
+			nrm = 0;
+			for (i = 0; i < fsinw; ++i) {
+				nrm += *(fsiq+m*fsinw+i) * (*(fsiq+m*fsinw+i));
+			}
+			if (nrm0 == 0 || nrm <= FSIEPS * FSIEPS * nrm0) {
+				for (l = j+1; l < fsinv; ++l) {
+					for (i = 0; i < fsinw; ++i) {
+						*(fsiv+(l-1)*fsinw+i) = *(fsiv+l*fsinw+i);
+						*(fsiw+(l-1)*fsinw+i) = *(fsiw+l*fsinw+i);
+					}
+				}
+				fsinv--;
+				j--;
+				continue;
+			}
+			nrm = sqrt(nrm);
+			*(fsir+m*FSIMAXV+m) = nrm;
+			for (i = 0; i < fsinw; ++i) {
+				*(fsiq+m*fsinw+i) /= nrm;
+			}
+			m++;
 		}
-	}while(i < NTSTPS-1);
+		
+		if (fsinv == 0) {
+			// Relaxed fixed point iteration
+			for (i = 0; i < fsinw; ++i) {
+				*(pxt+i) += FSIOMEGA * (*(prs+i));
+			}
+		} else {
+			// Solve R*c = -Q^T*r, and update the interface pressures with the responses, W*c
+			for (j = 0; j < fsinv; ++j) {
+				sum = 0;
+				for (i = 0; i < fsinw; ++i) {
+					sum -= *(fsiq+j*fsinw+i) * (*(prs+i));
+				}
+				*(pc+j) = sum;
+			}
+			for (j = fsinv-1; j >= 0; --j) {
+				for (l = j+1; l < fsinv; ++l) {
+					*(pc+j) -= *(fsir+j*FSIMAXV+l) * (*(pc+l));
+				}
+				*(pc+j) /= *(fsir+j*FSIMAXV+j);
+			}
+			for (i = 0; i < fsinw; ++i) {
+				sum = *(pxh+i);
+				for (j = 0; j < fsinv; ++j) {
+					sum += *(fsiw+j*fsinw+i) * (*(pc+j));
+				}
+				*(pxt+i) = sum;
+			}
+		}
+	}
 	
-	// Assign the last load value to be equal to the last input load value
-	for (i = 0; i < SNDOF; ++i) {
-		*(papload+i*(NTSTPS)+NTSTPS-1) = *(ppinpt+i*(ntstpsinpt)+(ntstpsinpt-1));
+	if (it == FSIMAXIT && fsiwarn == 0) {
+		fprintf(OFP[0], "\n***WARNING*** Partitioned FSI coupling iterations did not converge");
+		fprintf(OFP[0], " within %d iterations\n", FSIMAXIT);
+		fsiwarn = 1;
 	}
 	
-	// Assign the last fluid pressure and acceleration values to be equal to the last input values
-	for (i = 0; i < FNDOF; ++i) {
-		*(ppres+i*NTSTPS+NTSTPS-1) = *(ppresinpt+i*ntstpsinpt+ntstpsinpt-1);
-		*(pacc+i*NTSTPS+NTSTPS-1) = *(paccinpt+i*ntstpsinpt+ntstpsinpt-1);
-	}	
-    
+	for (i = 0; i < NEQ; ++i) {
+		*(pReff+i) = *(fsid+i);
+	}
+	return 0;
+}
+
+
+int fsiprod (long *pmaxa, double *pss, double *psm, double *psd, double *px, double *py, double c0, double a1)
+
+{
+	// Initialize function variables
+	long i, k;
 	
-	// Initialize Lp matrix to zero
-	for (i = 0; i < SNDOF; ++i) {
-		for (j = 0; j < NTSTPS; ++j) {
-			*(pLp+i*NTSTPS+j) = 0;
+	/* Product of the effective stiffness matrix with x: the structure and fluid blocks on the
+	 skyline with their diagonal mass and damping, and the coupling terms L and -c0*rho*L^T */
+	for (i = 0; i < NEQ; ++i) {
+		*(py+i) = *(px+i);
+	}
+	if (skymult (pmaxa, pss, py) < 0) {
+		return -1;
+	}
+	for (i = 0; i < NEQ; ++i) {
+		*(py+i) += (c0 * (*(psm+i)) + a1 * (*(psd+i))) * (*(px+i));
+	}
+	for (i = 0; i < fsinw; ++i) {
+		for (k = *(fsilp+i); k < *(fsilp+i+1); ++k) {
+			*(py+*(fsils+k)) += *(fsilx+k) * (*(px+SNDOF+*(fsiwet+i)));
 		}
 	}
+	fsimass (px, py, c0);
+	return 0;
+}
+
+
+int fsigmres (long *pmaxa, double *pss, double *psm, double *psd, double *pKeff, double *pReff, double *pum,
+			  double c0, double a1)
+
+{
+	// Initialize function variables
+	long i, j, l, m, it, lo, hi;
+	double bnrm[2], ynrm, rnrm, h, t;
+	
+	/* Restarted GMRES on the coupled effective stiffness matrix, right preconditioned by the
+	 skyline factorization of its uncoupled (block diagonal) structure and fluid blocks, and
+	 started from the displacements and pressures of the previous time step */
+	for (i = 0; i < NEQ; ++i) {
+		*(fsid+i) = *(pum+i);
+	}
 	
-	// Initialize Au matrix to zero
-	for (i = 0; i < FNDOF; ++i) {
-		for (j = 0; j < NTSTPS; ++j) {
-			*(pAu+i*NTSTPS+j) = 0;
+	it = 0;
+	rnrm = 0;
+	while (1) {
+		// Residual of the current solution
+		if (fsiprod (pmaxa, pss, psm, psd, fsid, fsikw, c0, a1) < 0) {
+			return -1;
+		}
+		
+		/* The rows are scaled by the inverse square roots of the diagonal, and each of the
+		 structure and fluid blocks by the norm of its (scaled) load or of the product of its
+		 uncoupled block with the current solution, since the fluid rows are smaller than the
+		 structure rows by orders of magnitude; the iterations stop at a relative residual of
+		 FSITOL in both blocks */
+		for (i = 0; i < NEQ; ++i) {
+			*(fsikd+i) = 1/sqrt(fabs(*(pss+*(pmaxa+i)-1) + c0 * (*(psm+i)) + a1 * (*(psd+i))));
+			*(fsikv+i) = *(pReff+i) - *(fsikw+i);
+			*(fsikw+i) = *(fsid+i);
+		}
+		if (skymult (pmaxa, pss, fsikw) < 0) {
+			return -1;
+		}
+		for (i = 0; i < NEQ; ++i) {
+			*(fsikw+i) += (c0 * (*(psm+i)) + a1 * (*(psd+i))) * (*(fsid+i));
+		}
+		for (lo = 0; lo < NEQ; lo = hi) {
+			hi = (lo < SNDOF) ? SNDOF : NEQ;
+			*(bnrm+(lo > 0)) = ynrm = 0;
+			for (i = lo; i < hi; ++i) {
+				*(bnrm+(lo > 0)) += *(fsikd+i) * (*(fsikd+i)) * (*(pReff+i)) * (*(pReff+i));
+				ynrm += *(fsikd+i) * (*(fsikd+i)) * (*(fsikw+i)) * (*(fsikw+i));
+			}
+			*(bnrm+(lo > 0)) = sqrt((*(bnrm+(lo > 0)) > ynrm) ? *(bnrm+(lo > 0)) : ynrm);
+		}
+		
+		/* A block which is neither loaded nor displaced yet (e.g. the fluid in the first time
+		 step) is scaled by its response to the preconditioned residual */
+		if ((*(bnrm) == 0 || *(bnrm+1) == 0) && *(bnrm) + *(bnrm+1) != 0) {
+			for (i = 0; i < NEQ; ++i) {
+				*(fsikz+i) = *(fsikv+i);
+			}
+			skyrange (pmaxa, pKeff, fsikz, 0, NEQ);
+			if (fsiprod (pmaxa, pss, psm, psd, fsikz, fsikw, c0, a1) < 0) {
+				return -1;
+			}
+			lo = (*(bnrm) == 0) ? 0 : SNDOF;
+			hi = (*(bnrm) == 0) ? SNDOF : NEQ;
+			for (i = lo; i < hi; ++i) {
+				*(bnrm+(lo > 0)) += *(fsikd+i) * (*(fsikd+i)) * (*(fsikw+i)) * (*(fsikw+i));
+			}
+			*(bnrm+(lo > 0)) = sqrt(*(bnrm+(lo > 0)));
+		}
+		
+		rnrm = 0;
+		for (i = 0; i < NEQ; ++i) {
+			if (*(bnrm+(i >= SNDOF)) != 0) {
+				*(fsikd+i) /= *(bnrm+(i >= SNDOF));
+			}
+			*(fsikv+i) *= *(fsikd+i);
+			rnrm += *(fsikv+i) * (*(fsikv+i));
+		}
+		rnrm = sqrt(rnrm);
+		if (rnrm <= FSITOL || it >= FSIKRYLIT) {
+			break;
+		}
+		for (i = 0; i < NEQ; ++i) {
+			*(fsikv+i) /= rnrm;
+		}
+		*(fsikg) = rnrm;
+		
+		for (m = 0; m < FSIKRYL && it < FSIKRYLIT; ++m) {
+			++it;
+			
+			// Arnoldi step with modified Gram-Schmidt orthogonalization
+			for (i = 0; i < NEQ; ++i) {
+				*(fsikz+i) = *(fsikv+m*NEQ+i);
+			}
+			skyrange (pmaxa, pKeff, fsikz, 0, NEQ);
+			if (fsiprod (pmaxa, pss, psm, psd, fsikz, fsikv+(m+1)*NEQ, c0, a1) < 0) {
+				return -1;
+			}
+			for (i = 0; i < NEQ; ++i) {
+				*(fsikv+(m+1)*NEQ+i) *= *(fsikd+i);
+			}
+			for (l = 0; l <= m; ++l) {
+				h = 0;
+				for (i = 0; i < NEQ; ++i) {
+					h += *(fsikv+l*NEQ+i) * (*(fsikv+(m+1)*NEQ+i));
+				}
+				*(fsikh+l*FSIKRYL+m) = h;
+				for (i = 0; i < NEQ; ++i) {
+					*(fsikv+(m+1)*NEQ+i) -= h * (*(fsikv+l*NEQ+i));
+				}
+			}
+			h = 0;
+			for (i = 0; i < NEQ; ++i) {
+				h += *(fsikv+(m+1)*NEQ+i) * (*(fsikv+(m+1)*NEQ+i));
+			}
+			h = sqrt(h);
+			*(fsikh+(m+1)*FSIKRYL+m) = h;
+			if (h != 0) {
+				for (i = 0; i < NEQ; ++i) {
+					*(fsikv+(m+1)*NEQ+i) /= h;
+				}
+			}
+			
+			// Reduce the new column of the Hessenberg matrix by Givens rotations
+			for (l = 0; l < m; ++l) {
+				t = *(fsikc+l) * (*(fsikh+l*FSIKRYL+m)) + *(fsiks+l) * (*(fsikh+(l+1)*FSIKRYL+m));
+				*(fsikh+(l+1)*FSIKRYL+m) = -*(fsiks+l) * (*(fsikh+l*FSIKRYL+m)) +
+					*(fsikc+l) * (*(fsikh+(l+1)*FSIKRYL+m));
+				*(fsikh+l*FSIKRYL+m) = t;
+			}
+			t = sqrt(*(fsikh+m*FSIKRYL+m) * (*(fsikh+m*FSIKRYL+m)) + h * h);
+			*(fsikc+m) = *(fsikh+m*FSIKRYL+m) / t;
+			*(fsiks+m) = h / t;
+			*(fsikh+m*FSIKRYL+m) = t;
+			*(fsikh+(m+1)*FSIKRYL+m) = 0;
+			*(fsikg+m+1) = -*(fsiks+m) * (*(fsikg+m));
+			*(fsikg+m) *= *(fsikc+m);
+			
+			if (fabs(*(fsikg+m+1)) <= FSITOL || h == 0) {
+				++m;
+				break;
+			}
+		}
+		
+		// Solve the reduced system for the coefficients of the Krylov basis
+		for (j = m-1; j >= 0; --j) {
+			for (l = j+1; l < m; ++l) {
+				*(fsikg+j) -= *(fsikh+j*FSIKRYL+l) * (*(fsikg+l));
+			}
+			*(fsikg+j) /= *(fsikh+j*FSIKRYL+j);
+		}
+		
+		// Update the solution with the preconditioned combination of the Krylov basis
+		for (i = 0; i < NEQ; ++i) {
+			t = 0;
+			for (j = 0; j < m; ++j) {
+				t += *(fsikg+j) * (*(fsikv+j*NEQ+i));
+			}
+			*(fsikz+i) = t;
+		}
+		skyrange (pmaxa, pKeff, fsikz, 0, NEQ);
+		for (i = 0; i < NEQ; ++i) {
+			*(fsid+i) += *(fsikz+i);
 		}
 	}
 	
-	// Initialize the dynamic applied load array
+	if (rnrm > FSITOL && fsiwarn == 0) {
+		fprintf(OFP[0], "\n***WARNING*** GMRES iterations of the FSI solution did not converge");
+		fprintf(OFP[0], " within %d iterations\n", FSIKRYLIT);
+		fsiwarn = 1;
+	}
+	
 	for (i = 0; i < NEQ; ++i) {
-		for (j = 0; j < NTSTPS; ++j) {
-			*(pqdyn+i*NTSTPS+j) = 0;
-		}
+		*(pReff+i) = *(fsid+i);
 	}
+	return 0;
+}
+
+
+int harm_fsi (long *pmaxa, double *pss, double *psm, double *psd_fsi, long *pqdyn_h, double *pqdyn, long nfreq,
+			  double fmin, double fmax)
+
+{
+	// Initialize function variables
+	long i, j, k, l, m, s, lh, done = 0, neq = NEQ, sndof = SNDOF, nw = fsinw;
+	long *pwet = fsiwet, *plp = fsilp, *pls = fsils;
+	int nt, it, info, err = 0, slvflag = SLVFLAG;
+	double f, w, c, kv, mv, rho = fsirho, *plx = fsilx, pi = 3.14159265358979323846;
 	
-	// Evaluate L=L*p
-	for (i = 0; i < NTSTPS; ++i) {
-		for (j = 0; j < SNDOF; ++j) {
-			sum = 0;
-			for (k = 0; k < FNDOF; ++k) {
-				sum += *(pL+j*FNDOF+k) * (*(ppres+k*NTSTPS+i));
+	/* The coupled dynamic stiffness matrix [K-w^2*M L; w^2*rho*L^T H-w^2*Q+i*w*C] is made
+	 complex symmetric by dividing the fluid rows by w^2*rho, and is held in a skyline whose
+	 wet fluid columns are extended up to the structure DOFs they are coupled to */
+	long *phmaxa = alloc_long (NEQ+1);
+	if (phmaxa == NULL) {
+		return 1;
+	}
+	for (j = 0; j < NEQ; ++j) {
+		*(phmaxa+j+1) = *(pmaxa+j+1) - *(pmaxa+j) - 1;
+	}
+	for (i = 0; i < fsinw; ++i) {
+		j = SNDOF + *(fsiwet+i);
+		for (k = *(fsilp+i); k < *(fsilp+i+1); ++k) {
+			if (j - *(fsils+k) > *(phmaxa+j+1)) {
+				*(phmaxa+j+1) = j - *(fsils+k);
 			}
-			*(pLp+j*NTSTPS+i) = sum;
 		}
 	}
+	*phmaxa = 1;
+	for (j = 0; j < NEQ; ++j) {
+		*(phmaxa+j+1) += *(phmaxa+j) + 1;
+	}
+	lh = *(phmaxa+NEQ) - 1;
+	
+	/* The frequencies of the sweep are independent, so they are solved in parallel, each
+	 thread holding its own complex skyline */
+	nt = 1;
+#ifdef _OPENMP
+	nt = omp_get_max_threads();
+#endif
+	if (nt > nfreq) {
+		nt = nfreq;
+	}
+	double *pa = alloc_dbl (2*lh*nt);
+	double *pq = alloc_dbl (NEQ);
+	double *ph = alloc_dbl (2*NEQ*nfreq); // Transfer functions (complex responses to the load amplitudes)
+	if (pa == NULL || pq == NULL || ph == NULL) {
+		free (phmaxa);
+		free (pa);
+		free (pq);
+		free (ph);
+		return 1;
+	}
 	
-	// Evaluate Au=A*u
-	for (i = 0; i < NTSTPS; ++i) {
-		for (j = 0; j < FNDOF; ++j) {
-			sum = 0;
-			for (k = 0; k < FNDOF; ++k) {
-				sum += *(pA+j*FNDOF+k) * (*(pacc+k*NTSTPS+i));
+	fprintf(OFP[0], "\nHarmonic Response:\n\tNumber of Frequencies: %ld\n", nfreq);
+	fprintf(OFP[0], "\tFrequency Range (Hz): %e to %e\n", fmin, fmax);
+	fprintf(OFP[0], "\tLength of complex skyline: %ld\n", lh);
+	
+	/* Read the load amplitudes before the parallel region, whose threads hold their own
+	 copies of the model state (see BEN_TLS), so that the state is passed to them as locals */
+	for (i = 0; i < NEQ; ++i) {
+		*(pq+i) = histval (pqdyn_h, pqdyn, i, 0);
+	}
+	
+#pragma omp parallel for private(i, j, k, m, s, f, w, c, kv, mv, it, info) schedule(dynamic) num_threads(nt)
+	for (l = 0; l < nfreq; ++l) {
+		it = 0;
+#ifdef _OPENMP
+		it = omp_get_thread_num();
+#endif
+		double *pal = pa+2*lh*it;
+		double *phl = ph+2*neq*l;
+		f = (nfreq > 1) ? fmin + (fmax-fmin)*l/(nfreq-1) : fmin;
+		w = 2*pi*f;
+		
+		/* Assemble K - w^2*M + i*w*C from the skyline (slvflag == 0 with the lumped mass, or 2)
+		 or full order (slvflag == 1) arrays of the uncoupled structure and fluid */
+		for (i = 0; i < 2*lh; ++i) {
+			*(pal+i) = 0;
+		}
+		for (j = 0; j < neq; ++j) {
+			c = (j >= sndof && w > 0) ? 1/(w*w*rho) : 1;
+			for (k = *(pmaxa+j); k < *(pmaxa+j+1); ++k) {
+				i = j - (k - *(pmaxa+j));
+				if (slvflag == 1) {
+					kv = *(pss+i*neq+j);
+					mv = *(psm+i*neq+j);
+				}
+				else {
+					kv = *(pss+k-1);
+					mv = (slvflag == 2) ? *(psm+k-1) : ((i == j) ? *(psm+j) : 0);
+				}
+				*(pal+2*(*(phmaxa+j)+j-i-1)) = c*(kv - w*w*mv);
 			}
-			*(pAu+j*NTSTPS+i) = sum;
+			*(pal+2*(*(phmaxa+j)-1)+1) = c*w*(*(psd_fsi+j));
+			*(phl+2*j) = c*(*(pq+j));
+			*(phl+2*j+1) = 0;
 		}
-	}	
-	
-	// Calculate the solid DOFs of the load array
-	for (i = 0; i < SNDOF; ++i) {
-		for (j = 0; j < NTSTPS; ++j) {
-			*(pqdyn+i*NTSTPS+j) = *(papload+i*NTSTPS+j) - *(pLp+i*NTSTPS+j);
+		
+		/* Add the coupling L, which is symmetric once the fluid rows are scaled; at w = 0 the
+		 fluid is not loaded by the structure, so that the uncoupled blocks are solved and
+		 the structure is solved again for the interface pressures */
+		if (w > 0) {
+			for (i = 0; i < nw; ++i) {
+				j = sndof + *(pwet+i);
+				for (k = *(plp+i); k < *(plp+i+1); ++k) {
+					*(pal+2*(*(phmaxa+j)+j-*(pls+k)-1)) = *(plx+k);
+				}
+			}
+		}
+		
+		// Solve for the complex response at the current frequency
+		info = zskyfact (neq, phmaxa, pal);
+		if (info == 0) {
+			zskysolve (neq, phmaxa, pal, phl);
+		}
+		if (info == 0 && w == 0) {
+			for (j = 0; j < sndof; ++j) {
+				*(phl+2*j) = *(pq+j);
+				*(phl+2*j+1) = 0;
+			}
+			for (i = 0; i < nw; ++i) {
+				m = sndof + *(pwet+i);
+				for (k = *(plp+i); k < *(plp+i+1); ++k) {
+					s = *(pls+k);
+					*(phl+2*s) -= *(plx+k) * (*(phl+2*m));
+					*(phl+2*s+1) -= *(plx+k) * (*(phl+2*m+1));
+				}
+			}
+			for (j = sndof; j < neq; ++j) {
+				*(phl+2*j) = *(pq+j);
+				*(phl+2*j+1) = 0;
+			}
+			zskysolve (neq, phmaxa, pal, phl);
+		}
+		
+#pragma omp critical
+		{
+			if (info != 0) {
+				err++;
+			}
+			done++;
+			printf("Frequency %ld of %ld (%e Hz) complete\n", done, nfreq, f);
+			fflush(stdout);
 		}
 	}
 	
-	// Evaluate the fluid DOFs of the load array
-	for (i = SNDOF; i < NEQ; ++i) {
-		for (j = 0; j < NTSTPS; ++j) {
-			*(pqdyn+i*NTSTPS+j) = -1*(*(pfdens)) * (*(pAu+(i-SNDOF)*NTSTPS+j));
+	if (err != 0) {
+		fprintf(OFP[0], "\n***WARNING*** Dynamic stiffness matrix singular at %d of the frequencies\n", err);
+	}
+	
+	// Output the amplitude and phase (degrees) of the transfer functions at each frequency
+	fprintf(OFP[1], "Model Transfer Functions:\n\tFrequency");
+	for (i = 0; i < NEQ; ++i) {
+		fprintf(OFP[1], "\tDOF %ld Amp\tDOF %ld Phase", i + 1, i + 1);
+	}
+	for (l = 0; l < nfreq; ++l) {
+		f = (nfreq > 1) ? fmin + (fmax-fmin)*l/(nfreq-1) : fmin;
+		fprintf(OFP[1], "\n\t%e", f);
+		for (i = 0; i < NEQ; ++i) {
+			fprintf(OFP[1], "\t%e\t%e", hypot(*(ph+2*NEQ*l+2*i), *(ph+2*NEQ*l+2*i+1)),
+					atan2(*(ph+2*NEQ*l+2*i+1), *(ph+2*NEQ*l+2*i)) * 180 / pi);
 		}
-	}    
+	}
+	
+	free (phmaxa);
+	free (pa);
+	free (pq);
+	free (ph);
+	return 0;
 }
 
+void fsifree (void)
+{
+	// Release the workspace of the partitioned and monolithic FSI solvers
+	free (fsiwet);
+	free (fsilp);
+	free (fsils);
+	free (fsilx);
+	free (fsiwi);
+	free (fsia);
+	free (fsid);
+	free (fsiv);
+	free (fsiw);
+	free (fsiq);
+	free (fsir);
+	free (fsiwk);
+	free (fsikv);
+	free (fsikh);
+	free (fsikc);
+	free (fsiks);
+	free (fsikg);
+	free (fsikd);
+	free (fsikz);
+	free (fsikw);
+	fsiwet = fsilp = fsils = fsiwi = NULL;
+	fsilx = fsia = fsid = fsiv = fsiw = fsiq = fsir = fsiwk = NULL;
+	fsikv = fsikh = fsikc = fsiks = fsikg = fsikd = fsikz = fsikw = NULL;
+	fsinw = fsinv = 0;
+}
@@ -0,0 +1,336 @@
+//********************************************************************************
+//**                                                                            **
+//**  Pertains to CU-BEN ver 4.0                                                **
+//**                                                                            **
+//**  CU-BENs: a ship hull modeling finite element library                      **
+//**  Copyright (c) 2019 C. J. Earls                                            **
+//**  Developed by C. J. Earls, Cornell University                              **
+//**  All rights reserved.                                                      **
+//**                                                                            **
+//**  Contributors:                                                             **
+//**    Christopher Stull                                                       **
+//**    Heather Reed                                                            **
+//**    Justyna Kosianka                                                        **
+//**    Wensi Wu                                                                **
+//**                                                                            **
+//**  This program is free software: you can redistribute it and/or modify it   **
+//**  under the terms of the GNU General Public License as published by the     **
+//**  Free Software Foundation, either version 3 of the License, or (at your    **
+//**  option) any later version.                                                **
+//**                                                                            **
+//**  This program is distributed in the hope that it will be useful, but       **
+//**  WITHOUT ANY WARRANTY; without even the implied warranty of                **
+//**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General  **
+//**  Public License for more details.                                          **
+//**                                                                            **
+//**  You should have received a copy of the GNU General Public License along   **
+//**  with this program. If not, see <https://www.gnu.org/licenses/>.           **
+//**                                                                            **
+//********************************************************************************
+
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "prototypes.h"
+
+/* Layout of the index array of a load history; the header is followed by a map from DOF
+   to row number (offset by one so that zero denotes an unloaded DOF) and then by the DOF
+   and number of stored time steps of each row */
+#define HDR 9 // Length of header
+#define NROW 0 // Number of rows for which memory is allocated
+#define NUSE 1 // Number of rows in use
+#define NSTP 2 // Number of time steps in the history
+#define NWIN 3 // Number of time steps held in memory; zero if the history is held in core
+#define KWIN 4 // First time step currently held in memory; negative if none
+#define SLOT 5 // Scratch file slot for a streamed history
+#define NDOF 6 // Number of DOFs addressed by the history
+#define KPOS 7 // Next sequential write position in the scratch file; negative if unknown
+#define FAIL 8 // Set once a window of a streamed history cannot be read from the scratch file
+
+extern BEN_TLS long NEQ, SNDOF, FNDOF;
+extern BEN_TLS int ANAFLAG;
+extern BEN_TLS FILE *IFP[4], *OFP[8];
+
+BEN_TLS FILE *HFP[8]; // Pointers to scratch files of streamed load histories
+BEN_TLS int nhfp = 0; // Number of scratch files opened
+
+int histscan (long *pjcode, long *pnrow)
+{
+    // Initialize function variables
+    long jt, ks, kf, kps, kpf, pos;
+    int dir, blk;
+    double d, v, a;
+    
+    *(pnrow) = *(pnrow+1) = 0;
+    
+    // Remember the current position so that the load input may be read again
+    pos = ftell(IFP[0]);
+    
+    if (ANAFLAG == 4) {
+        /* Count the solid DOFs subjected to applied forces and the fluid DOFs subjected
+           to incident pressures and accelerations */
+        kps = kpf = 0;
+        fscanf(IFP[0], "%ld,%d,%lf,%lf,%lf\n", &jt, &dir, &d, &v, &a);
+        while (jt != 0) {
+            if (dir == 4) {
+                ks = 0;
+            } else {
+                ks = *(pjcode+(jt-1)*7+dir-1);
+            }
+            kf = *(pjcode+(jt-1)*7+6);
+            if (ks != kps || kf != kpf) {
+                if (ks != 0) {
+                    ++(*(pnrow));
+                }
+                if (kf != 0) {
+                    ++(*(pnrow+1));
+                }
+            }
+            kps = ks;
+            kpf = kf;
+            fscanf(IFP[0], "%ld,%d,%lf,%lf,%lf\n", &jt, &dir, &d, &v, &a);
+        }
+    } else {
+        /* Count the DOFs subjected to applied forces (blk = 0) and to nonzero
+           displacements (blk = 1) */
+        for (blk = 0; blk < 2; ++blk) {
+            kps = 0;
+            fscanf(IFP[0], "%ld,%d,%lf\n", &jt, &dir, &d);
+            while (jt != 0) {
+                ks = *(pjcode+(jt-1)*7+dir-1);
+                if (ks != 0 && ks != kps) {
+                    ++(*(pnrow+blk));
+                }
+                kps = ks;
+                fscanf(IFP[0], "%ld,%d,%lf\n", &jt, &dir, &d);
+            }
+        }
+    }
+    
+    if (pos < 0 || fseek(IFP[0], pos, SEEK_SET) != 0) {
+        fprintf(OFP[0], "\n***ERROR*** Unable to rewind input file to read load history\n");
+        return 1;
+    }
+    return 0;
+}
+
+long histlen (long ndof, long nrow)
+{
+    return HDR + ndof + 2*nrow;
+}
+
+long histvlen (long nrow, long nstep, long nwin)
+{
+    // The window is at least two time steps long (see histinit)
+    if (nwin > 0 && nwin < nstep) {
+        nstep = (nwin < 2) ? 2 : nwin;
+    }
+    if (nrow*nstep > 0) {
+        return nrow*nstep;
+    } else {
+        return 1;
+    }
+}
+
+int histinit (long *ph, double *pv, long ndof, long nrow, long nstep, long nwin)
+{
+    // Initialize function variables
+    long i;
+    
+    // A window no shorter than the history is equivalent to holding it in core
+    if (nwin >= nstep) {
+        nwin = 0;
+    } else if (nwin > 0 && nwin < 2) {
+        nwin = 2; // Current and previous time steps must be held together
+    }
+    
+    *(ph+NROW) = nrow;
+    *(ph+NUSE) = 0;
+    *(ph+NSTP) = nstep;
+    *(ph+NWIN) = nwin;
+    *(ph+KWIN) = -1;
+    *(ph+SLOT) = -1;
+    *(ph+NDOF) = ndof;
+    *(ph+KPOS) = -1;
+    *(ph+FAIL) = 0;
+    
+    for (i = 0; i < ndof+2*nrow; ++i) {
+        *(ph+HDR+i) = 0;
+    }
+    for (i = 0; i < histvlen(nrow, nstep, nwin); ++i) {
+        *(pv+i) = 0;
+    }
+    
+    // Open scratch file to which the full history is written
+    if (nwin > 0 && nrow > 0) {
+        if (nhfp == 8) {
+            fprintf(OFP[0], "\n***ERROR*** Too many streamed load histories\n");
+            return 1;
+        }
+        HFP[nhfp] = tmpfile();
+        if (HFP[nhfp] == NULL) {
+            fprintf(OFP[0], "\n***ERROR*** Unable to open scratch file for load history\n");
+            return 1;
+        }
+        *(ph+SLOT) = nhfp;
+        nhfp++;
+    }
+    return 0;
+}
+
+int histput (long *ph, double *pv, long dof, long step, double val)
+{
+    // Initialize function variables
+    long row, pos, *prow;
+    FILE *fp;
+    
+    if (step < 0 || step >= *(ph+NSTP)) {
+        return 0; // Values beyond the analysis time are ignored
+    }
+    
+    // Assign a new row to a DOF which has not yet been loaded
+    row = *(ph+HDR+dof);
+    if (row == 0) {
+        if (*(ph+NUSE) == *(ph+NROW)) {
+            fprintf(OFP[0], "\n***ERROR*** Load history row count exceeded\n");
+            return 1;
+        }
+        row = ++(*(ph+NUSE));
+        *(ph+HDR+dof) = row;
+        *(ph+HDR+*(ph+NDOF)+(row-1)*2) = dof;
+    }
+    row--;
+    prow = ph+HDR+*(ph+NDOF)+row*2;
+    if (step+1 > *(prow+1)) {
+        *(prow+1) = step+1;
+    }
+    
+    if (*(ph+NWIN) == 0) {
+        *(pv+row*(*(ph+NSTP))+step) = val;
+    } else {
+        /* Write to scratch file; the input is read one DOF at a time, so consecutive values
+           are usually contiguous and no repositioning is needed */
+        fp = HFP[*(ph+SLOT)];
+        pos = row*(*(ph+NSTP))+step;
+        if (pos != *(ph+KPOS)) {
+            if (fseek(fp, pos*(long)sizeof(double), SEEK_SET) != 0) {
+                fprintf(OFP[0], "\n***ERROR*** Unable to write load history\n");
+                return 1;
+            }
+        }
+        if (fwrite(&val, sizeof(double), 1, fp) != 1) {
+            fprintf(OFP[0], "\n***ERROR*** Unable to write load history\n");
+            return 1;
+        }
+        *(ph+KPOS) = pos+1;
+        *(ph+KWIN) = -1; // Window no longer reflects the scratch file
+    }
+    return 0;
+}
+
+int histwin (long *ph, double *pv, long step)
+{
+    // Initialize function variables
+    long i, j, n, len, nstep, nwin;
+    FILE *fp;
+    
+    nstep = *(ph+NSTP);
+    nwin = *(ph+NWIN);
+    fp = HFP[*(ph+SLOT)];
+    
+    // Read the window of time steps step:step+nwin-1 of each row from the scratch file
+    for (i = 0; i < *(ph+NUSE); ++i) {
+        len = *(ph+HDR+*(ph+NDOF)+i*2+1);
+        n = len - step;
+        if (n > nwin) {
+            n = nwin;
+        } else if (n < 0) {
+            n = 0;
+        }
+        if (n > 0) {
+            if (fseek(fp, (i*nstep+step)*(long)sizeof(double), SEEK_SET) != 0 ||
+                fread(pv+i*nwin, sizeof(double), n, fp) != (size_t) n) {
+                fprintf(OFP[0], "\n***ERROR*** Unable to read load history\n");
+                *(ph+FAIL) = 1;
+                return 1;
+            }
+        }
+        for (j = n; j < nwin; ++j) {
+            *(pv+i*nwin+j) = 0;
+        }
+    }
+    *(ph+KWIN) = step;
+    *(ph+KPOS) = -1;
+    return 0;
+}
+
+double histval (long *ph, double *pv, long dof, long step)
+{
+    // Initialize function variables
+    long row, k0;
+    
+    row = *(ph+HDR+dof);
+    if (row == 0) {
+        return 0; // DOF is not loaded
+    }
+    row--;
+    if (step < 0 || step >= *(ph+HDR+*(ph+NDOF)+row*2+1)) {
+        return 0; // Time step beyond the input for this DOF
+    }
+    
+    if (*(ph+NWIN) == 0) {
+        return *(pv+row*(*(ph+NSTP))+step);
+    }
+    
+    /* Pull a new window from disk once the step leaves the current one; the window starts
+       one step back so that the previous step remains available for interpolation */
+    if (*(ph+FAIL) == 1) {
+        return 0;
+    }
+    k0 = *(ph+KWIN);
+    if (k0 < 0 || step < k0 || step >= k0+*(ph+NWIN)) {
+        if (step > 0) {
+            k0 = step-1;
+        } else {
+            k0 = step;
+        }
+        if (histwin(ph, pv, k0) == 1) {
+            return 0; // The failure is reported by histfail
+        }
+    }
+    return *(pv+row*(*(ph+NWIN))+step-k0);
+}
+
+int histfail (long *ph)
+{
+    return (int) *(ph+FAIL);
+}
+
+long histrow (long *ph, long dof)
+{
+    return *(ph+HDR+dof);
+}
+
+long histrows (long *ph)
+{
+    return *(ph+NUSE);
+}
+
+long histdof (long *ph, long row)
+{
+    return *(ph+HDR+*(ph+NDOF)+row*2);
+}
+
+void histclose (void)
+{
+    // Initialize function variables
+    int i;
+    
+    // Close (and thereby remove) the scratch files
+    for (i = 0; i < nhfp; ++i) {
+        fclose(HFP[i]);
+    }
+    nhfp = 0;
+}
@@ -0,0 +1,186 @@
+//********************************************************************************
+//**                                                                            **
+//**  Pertains to CU-BEN ver 4.0                                                **
+//**                                                                            **
+//**  CU-BENs: a ship hull modeling finite element library                      **
+//**  Copyright (c) 2019 C. J. Earls                                            **
+//**  Developed by C. J. Earls, Cornell University                              **
+//**  All rights reserved.                                                      **
+//**                                                                            **
+//**  Contributors:                                                             **
+//**    Christopher Stull                                                       **
+//**    Heather Reed                                                            **
+//**    Justyna Kosianka                                                        **
+//**    Wensi Wu                                                                **
+//**                                                                            **
+//**  This program is free software: you can redistribute it and/or modify it   **
+//**  under the terms of the GNU General Public License as published by the     **
+//**  Free Software Foundation, either version 3 of the License, or (at your    **
+//**  option) any later version.                                                **
+//**                                                                            **
+//**  This program is distributed in the hope that it will be useful, but       **
+//**  WITHOUT ANY WARRANTY; without even the implied warranty of                **
+//**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General  **
+//**  Public License for more details.                                          **
+//**                                                                            **
+//**  You should have received a copy of the GNU General Public License along   **
+//**  with this program. If not, see <https://www.gnu.org/licenses/>.           **
+//**                                                                            **
+//********************************************************************************
+
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "prototypes.h"
+
+/* Library interface of the solver (make libben.a): a model is created from the text of an
+   input file, analyzed by ben_run, and its output files and statistics read from memory by
+   ben_result and ben_stats, e.g.
+
+       BENMODEL *pbm = ben_create (text, strlen (text));
+       if (pbm != NULL && ben_run (pbm) == 0) {
+           displ = ben_result (pbm, 2, &len);
+           stats = ben_stats (pbm, &len);
+       }
+       ben_free (pbm);
+
+   Separate models may be analyzed concurrently from separate threads. The input and output
+   files are held in memory, while the scratch files of out-of-core arrays and streamed load
+   histories and fsiinc.txt remain on disk; checkpoint and restart are not available. */
+
+#define BENSTACK 8388608 // Stack size of the analysis threads (that of the main thread of ben.exe)
+
+void * benthread (void *arg)
+{
+    // Initialize function variables
+    long err;
+    
+    err = analysis ((BENMODEL *) arg);
+    solvefree ();
+    fsifree ();
+    
+    return (void *) err;
+}
+
+BENMODEL * ben_create (const char *text, size_t len)
+{
+    // Initialize function variables
+    BENMODEL *pbm;
+    int i;
+    
+    if (text == NULL || len == 0) {
+        return NULL;
+    }
+    pbm = (BENMODEL *) malloc (sizeof (BENMODEL));
+    if (pbm == NULL) {
+        return NULL;
+    }
+    pbm->input = (char *) malloc (len + 1);
+    if (pbm->input == NULL) {
+        free (pbm);
+        return NULL;
+    }
+    memcpy (pbm->input, text, len);
+    *(pbm->input+len) = '\0';
+    pbm->ninput = len;
+    for (i = 0; i < 7; ++i) {
+        pbm->res[i] = NULL;
+        pbm->nres[i] = 0;
+    }
+    pbm->jnt = NULL;
+    pbm->setup = 0;
+    pbm->nov = 0;
+    pbm->povk = NULL;
+    pbm->povv = NULL;
+    pbm->stats = NULL;
+    pbm->nstats = 0;
+    
+    return pbm;
+}
+
+int ben_run (BENMODEL *pbm)
+{
+    // Initialize function variables
+    pthread_t thread;
+    pthread_attr_t attr;
+    void *err;
+    int i;
+    
+#ifdef BEN_MPI
+    // The domain decomposition of MPI builds runs on all ranks from main
+    return 1;
+#endif
+    if (pbm == NULL) {
+        return 1;
+    }
+    
+    // Discard the output of a previous analysis of the model
+    for (i = 0; i < 7; ++i) {
+        free (pbm->res[i]);
+        pbm->res[i] = NULL;
+        pbm->nres[i] = 0;
+    }
+    free (pbm->stats);
+    pbm->stats = NULL;
+    pbm->nstats = 0;
+    
+    /* Each analysis runs on a thread of its own, so that it starts from the initial model
+     state and keeps it apart from the concurrent analyses (see BEN_TLS) */
+    pthread_attr_init (&attr);
+    pthread_attr_setstacksize (&attr, BENSTACK);
+    i = pthread_create (&thread, &attr, benthread, pbm);
+    pthread_attr_destroy (&attr);
+    if (i != 0) {
+        return 1;
+    }
+    pthread_join (thread, &err);
+    
+    return (int) (long) err;
+}
+
+const char * ben_result (BENMODEL *pbm, int i, size_t *plen)
+{
+    if (pbm == NULL || i < 1 || i > 7 || pbm->res[i-1] == NULL) {
+        return NULL;
+    }
+    if (plen != NULL) {
+        *plen = pbm->nres[i-1];
+    }
+    
+    return pbm->res[i-1];
+}
+
+const char * ben_stats (BENMODEL *pbm, size_t *plen)
+{
+    if (pbm == NULL || pbm->stats == NULL) {
+        return NULL;
+    }
+    if (plen != NULL) {
+        *plen = pbm->nstats;
+    }
+    
+    return pbm->stats;
+}
+
+void ben_free (BENMODEL *pbm)
+{
+    // Initialize function variables
+    int i;
+    
+    if (pbm == NULL) {
+        return;
+    }
+    for (i = 0; i < 7; ++i) {
+        free (pbm->res[i]);
+    }
+    free (pbm->jnt);
+    free (pbm->povk);
+    free (pbm->povv);
+    free (pbm->stats);
+    free (pbm->input);
+    free (pbm);
+}
@@ -30,9 +30,14 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <math.h>
 #include "prototypes.h"
 
+#ifdef BEN_MPI
+#  include <mpi.h>
+#endif
+
 
 #if defined(__APPLE__)
 #  include <Accelerate/Accelerate.h>
@@ -67,7 +72,7 @@
         3 - 2nd order inelastic
         *** for 1st order elastic analysis, all 2nd order / inelastic analysis related variables must be entered (for consistency in input files), but will be ignored during solution
         4 - Fluid-structure interaction
-        *** for FSI analysis, also enter (on same line), flag for fsi incidence array - FSIINCFLAG tracks which elements have FSI nodes, then which face of the element (if the element is a brick) is on the FSI interface, and then the (global) nodes that are on the interface.  This is used later in the assembly of the global A and G matrices that translate the normal pressures into x, y, and z, displacements (i.e. the off-diagonal matrices in the monolithic K and M matrices.)
+        *** for FSI analysis, also enter (on same line), flag for fsi incidence array - FSIINCFLAG tracks which elements have FSI nodes, then which face of the element (if the element is a brick) is on the FSI interface, and then the (global) nodes that are on the interface.  This is used later in the assembly of the coupling matrix L = G*A, held by wet fluid DOF, whose area matrix A and direction cosines G translate the normal pressures into x, y, and z, displacements (i.e. the off-diagonal matrices in the monolithic K and M matrices.)
             0 - Input fsi incidence array in fsiinc.txt
             1 - Allow BEN to calculate fsi incidence array
     enter flag for solution algorithm type (in main) - ALGFLAG
@@ -76,8 +81,9 @@
         3 - (Static) Modified Spherical Arc Length
         4 - (Dynamic) Newmark Implicit Integration Method
         5 - (Dynamic) Nonlinear Newmark Implicit Integration Method
+        6 - (Frequency domain) Harmonic response over a frequency sweep (FSI analysis only; solved on a complex skyline with the mass matrices of SLVFLAG)
         *** for 1st order elastic analysis, ALGFLAG is automatically set to 0
-    if (ALGFLAG > 3) {
+    if (ALGFLAG == 4 || ALGFLAG == 5) {
         enter checkpoint and restart flag (in main) - CHKPT, RFLAG
             CHKPT specifies frequency of writes of the analysis state 
             RFLAG signals whether the current alnalysis is a "restart" of a previously checkpointed analysis.
@@ -88,8 +94,14 @@
                 1 - restart write on
     }
     enter flag for solver algorithm type (in main) - SLVFLAG
-        0 - CU_BEN for symmetric matrices
+        0 - CU_BEN for symmetric matrices; for FSI analysis, the structure and the fluid are solved separately on the skyline arrays (with lumped mass matrices) and coupled by interface quasi-Newton iterations within each time step (no prescribed displacements)
         1 - CLAPACK solver for symmetric and non-symmetric matrices
+        2 - UMFPACK sparse solver for symmetric and non-symmetric matrices; the stiffness and (consistent) mass matrices are assembled on the skyline arrays and compressed by columns for the factorization, with the FSI coupling terms added to the compressed columns
+        3 - CHOLMOD sparse Cholesky solver for symmetric matrices (non-FSI analysis only); the stiffness and (consistent) mass matrices are assembled on the skyline arrays, whose nonzero entries form the upper triangle for the factorization
+        4 - Conjugate gradient solver with smoothed aggregation multigrid preconditioner, on the skyline arrays, for symmetric positive definite matrices (ALGFLAG other than 3 only); for FSI analysis, restarted GMRES on the coupled system, preconditioned by the skyline factorization of the structure and the fluid (with lumped mass matrices; no prescribed displacements)
+        *** for SLVFLAG = 0, optionally append a flag for factorizing the skyline matrix in single precision, with iterative refinement of the solution against the double precision matrix (0 - off, 1 - on), and a flag for holding the skyline stiffness, mass, and effective stiffness arrays out-of-core in memory-mapped scratch files in the working directory (0 - off, 1 - on) - SLVFLAG,MPFLAG,OOCFLAG
+        *** for SLVFLAG = 0 and 2nd order inelastic analysis with ALGFLAG = 1 or 2, optionally append the maximum rank of the low-rank updates of the factorized tangent stiffness matrix (0 - off); the factorization is kept, the changes of the frame and shell elements whose yield state changed are applied to it with the Woodbury formula, and the system is solved by conjugate gradients preconditioned by the updated factorization; the matrix is refactorized when the number of equations of the update exceeds the maximum rank or the iterations exceed 10 or do not converge (MPFLAG = OOCFLAG = 0 only) - SLVFLAG,MPFLAG,OOCFLAG,LRMAX
+        *** for SLVFLAG = 0, when built with MPI (make MPI=1) and run on several ranks (mpirun -np N), a static analysis (ALGFLAG = 0, 1, or 2, without bricks, substructures, or the multigrid solver) is run by domain decomposition: the joints are partitioned by recursive bisection of their graph, each rank assembles the skyline arrays of the elements of its subdomain only and factorizes its interior equations, and the interface problem is solved by conjugate gradients, or directly if it is small or conjugate gradients fail (MPFLAG = LRMAX = 0); the input, the element arrays, and the solution vectors are held on every rank, and the other analyses are solved in full on every rank
     enter flag for execution of node-renumbering algorithm (in main) - optflag
         1 - no
         2 - yes
@@ -101,6 +113,7 @@
         solid brick - NE_SBR
         fluid brick - NE_FBR
         *** enter on single line as: NE_TR, NE_FR, NE_SH, NE_SBR, NE_FBR
+        *** for 1st order elastic static analysis with SLVFLAG = 0, 2, or 3, optionally append the number of substructure instances (see below) - NE_TR, NE_FR, NE_SH, NE_SBR, NE_FBR, NSUP
     enter truss element member incidences (in struc) - minc[i,1],minc[i,2];
         i = 1 to NE_TR
     enter frame element member incidences (in struc) - minc[i,1],minc[i,2];
@@ -116,6 +129,16 @@
         *** for warping DOFs - jnum,jdir,restrnt
             0 - fixed
             1 - free
+    if (NSUP > 0) {
+        enter substructure instances (in superin); i = 1 to NSUP:
+            first truss element and number of truss elements - tr1[i], ntr[i]
+            first frame element and number of frame elements - fr1[i], nfr[i]
+            first shell element and number of shell elements - sh1[i], nsh[i]
+            substructure number - sub[i]
+            *** enter on single line as: tr1[i],ntr[i],fr1[i],nfr[i],sh1[i],nsh[i],sub[i]
+            *** the joints whose elements all belong to an instance are its interior joints; the stiffness matrix of a substructure is condensed onto its boundary DOFs once, by the skyline factorization of its interior DOFs, and is cached in super_<hash>.bin in the working directory; the interior displacements are recovered for output, and are numbered after the NEQ DOFs of the structure
+            *** the first instance of each substructure number defines the substructure; the other instances repeat it, i.e. their elements are entered in the same sequence, with the same properties, and their joints are translated copies
+    }
     if (ALGFLAG > 3) {
         enter joint nonzero displacement(s) on boundary (in skylin) - jnum,jdir; end = 0,0
     }
@@ -199,13 +222,17 @@
             *** enter on single line as: norpt[i,1],norpt[i,2],norpt[i,3]
         enter number of time steps (in main) and total time for analysis (s);
             *** enter on single line as: ntstpsinpt, ttot
+            *** optionally append the number of time steps of the load history held in memory at a time, in which case the remainder is streamed from a scratch file (zero or omitted holds the full history in memory) - ntstpsinpt, ttot, HWIN
+            *** for ALGFLAG = 6, enter instead the number of frequencies and the first and last frequency (Hz) of the sweep, equally spaced - nfreq, fmin, fmax
         enter concentrated load, nodal acceleration(s) and fluid incident pressure(s) applied during time step on joints for each time step (in load_fsi) - i = 0:ntstpsinpt
             joint,dir,force,fpress,facc;
             end = 0,0,0,0,0
+            *** for ALGFLAG = 6, enter one line per joint and direction, with the (real) load amplitudes of the harmonic excitation; the transfer functions (amplitude and phase of each DOF) are written to results2.txt
         enter initial conditions for node displacement or pressure and 1st or 2nd derivatives.  If dir = 4, initial condition refers to a fluid DOF (in load_fsi)
             joint,dir,disp,vel,acc;
             end = 0,0,0,0,0
-        enter Newmark time integration scheme option and spectral radius
+            *** for ALGFLAG = 6, only enter the end line
+        enter Newmark time integration scheme option and spectral radius (not for ALGFLAG = 6)
             numopt,spectrds
             0, 1 - standard Newmark
             1, 1 - standard Newmark
@@ -239,6 +266,7 @@
                     maximum number of times to step back load due to unconverged solution - submax
                     minimum number of converged solutions before increasing increment of lambda - solmin
                     *** enter on single line as: itemax,submax,solmin
+                    *** optionally append the number of BFGS update pairs held between reformations of the tangent stiffness matrix (ALGFLAG = 2 only), a flag for the energy line search on the incremental displacements (0 - off, 1 - on), and a flag for the predictor of each load increment (0 - tangent, 1 - secant extrapolation from the last two converged increments) - itemax,submax,solmin,mbfgs,lsflag,prdflag
             }
             else { //MSAL
                 enter MSAL parameters:
@@ -253,12 +281,14 @@
                     maximum number of times to step back load due to arc length criterion producing imaginary roots - imagmax
                     maximum number of times to step back load due to arc length criterion producing two negative roots - negmax
                     *** enter on single line as: itemax,submax,imagmax,negmax
+                    *** optionally append a flag for the predictor of each load increment (0 - tangent, 1 - secant extrapolation from the last converged increment scaled to the arc length) - itemax,submax,imagmax,negmax,prdflag
             }
         }
         else { // Dynamic Analysis
             if (ALGFLAG == 4){
                 enter initial number of time steps (in load) and total time for analysis (s);
                     *** enter on single line as: ntstpsinpt, ttot
+                    *** optionally append the number of time steps of the load history held in memory at a time (see FSI input above) - ntstpsinpt, ttot, HWIN
                 enter reference concentrated load(s) on joints for each time step (in load); i = 0:ntstpsinpt
                     joint,dir,force;
                     end = 0,0,0
@@ -281,6 +311,7 @@
             if (ALGFLAG == 5){
                 enter initial number of time steps (in load) and total time for analysis (s);
                     *** enter on single line as: ntstpsinpt, ttot
+                    *** optionally append the number of time steps of the load history held in memory at a time (see FSI input above) - ntstpsinpt, ttot, HWIN
                     *** load history is under linear interpolation assumption in the case when damping scheme is applied, limit the size of delta T that may be used to maintain fidelity with load history
                 enter reference concentrated load(s) on joints for each time step (in load); i = 0:ntstpsinpt
                     joint,dir,force;
@@ -312,6 +343,7 @@
                     maximum number of times to step back load due to unconverged solution - submax
                     minimum number of converged solutions before increasing increment of lambda - solmin
                     *** enter on single line as: itemax,submax,solmin
+                    *** optionally append a flag for modified Newton iterations reusing the factorized effective stiffness matrix across iterations and time steps (0 - off, 1 - on; NBC = 0 only), the number of iterations within a load increment after which it is reformed (default 4), and the maximum ratio of the residual norms of two successive iterations before it is reformed (default 0.5) - itemax,submax,solmin,mnrflag,itemnr,ratmax
             }
         }
     }
@@ -320,20 +352,56 @@
  */
 
 // Number of joints, number of truss, frame, and shell elements, and number of equations, and number of nonzero boundary conditions
-long NJ, NE_TR, NE_FR, NE_SH, NE_SBR, NE_FBR, NE_BR, NEQ, NBC, SNDOF, FNDOF, NTSTPS, ntstpsinpt;
-double dt, ttot;
+BEN_TLS long NJ, NE_TR, NE_FR, NE_SH, NE_SBR, NE_FBR, NE_BR, NEQ, NBC, SNDOF, FNDOF, NTSTPS, ntstpsinpt;
+BEN_TLS long HWIN; // Number of time steps of a streamed load history held in memory
+BEN_TLS long BAND; // Half-bandwidth of the skyline stiffness matrix when it is factorized in LAPACK band storage
+BEN_TLS long NSUP; // Number of substructure instances (see super.c)
+BEN_TLS long NEQI; // Number of interior equations of the substructure instances, numbered after the NEQ equations
+BEN_TLS double dt, ttot;
 // "666" is an unlikely mistake; initialization allows for assumption of empty input file
-int ANAFLAG = 666, ALGFLAG, OPTFLAG, SLVFLAG, FSIFLAG, FSIINCFLAG, brFSI_FLAG, shFSI_FLAG;
-FILE *IFP[4], *OFP[8]; // Pointers to input and output file
-int CHKPT, RFLAG; // checkpoint and restart flag for file backup and restoration
+BEN_TLS int ANAFLAG = 666, ALGFLAG, OPTFLAG, SLVFLAG, FSIFLAG, FSIINCFLAG, brFSI_FLAG, shFSI_FLAG;
+BEN_TLS int MPFLAG; // Flag for the single precision skyline factorization with iterative refinement
+BEN_TLS int OOCFLAG; // Flag for the out-of-core (memory-mapped) skyline arrays
+BEN_TLS int ITFLAG; // Flag for the iterative solvers on the skyline arrays (conjugate gradients with multigrid preconditioner, or GMRES for FSI analysis)
+BEN_TLS int LRMAX; // Maximum rank of the low-rank updates of the factorized skyline tangent stiffness matrix
+BEN_TLS FILE *IFP[4], *OFP[8]; // Pointers to input and output file
+BEN_TLS int CHKPT, RFLAG; // checkpoint and restart flag for file backup and restoration
+BEN_TLS int MPIRANK; // Rank of this process when built with MPI (make MPI=1); only rank 0 writes output files
+BEN_TLS int MPISIZE; // Number of MPI ranks when built with MPI (make MPI=1)
+BEN_TLS int DDFLAG; // Flag for the domain decomposition of a static analysis over the MPI ranks (see ddcodes)
 
+// The library (make libben.a) leaves out main, and analyses are run by ben_run (see library.c)
+#ifndef BEN_LIB
 int main (int argc, char **argv)
+{
+    
+#ifdef BEN_MPI
+    /* All ranks read the input and form the structure arrays; static analyses are assembled
+     and solved by domain decomposition over the ranks (see ddcodes) */
+    MPI_Init (&argc, &argv);
+    MPI_Comm_rank (MPI_COMM_WORLD, &MPIRANK);
+    MPI_Comm_size (MPI_COMM_WORLD, &MPISIZE);
+#endif
+    
+    return analysis (NULL);
+}
+#endif
+
+int analysis (BENMODEL *pbm)
 {
     int i, j; // Counter variables
     
+    // Start the statistics of the analysis (see stats.c)
+    statinit (pbm);
+    statbeg (ST_INPUT);
+    
     // Open I/O for business!
     do {
-        IFP[0] = fopen("model_def.txt", "r"); // Open input file for reading
+        if (pbm != NULL) {
+            IFP[0] = fmemopen(pbm->input, pbm->ninput, "r"); // Read input from the model handle
+        } else {
+            IFP[0] = fopen("model_def.txt", "r"); // Open input file for reading
+        }
     } while (IFP[0] == 0);
     
     // Read in analysis / algorithm type from input file
@@ -344,18 +412,9 @@ int main (int argc, char **argv)
     fscanf(IFP[0], "%d\n", &ALGFLAG);
     
     // If dynamic analysis, read in restart information
-    if (ALGFLAG > 3){
+    if (ALGFLAG == 4 || ALGFLAG == 5){
         fscanf (IFP[0], "%d,%d\n", &CHKPT, &RFLAG);
-        if (CHKPT < 0) {
-            fprintf(OFP[0], "\n***ERROR*** Invalid checkpoint value\n");
-            goto EXIT1;
-        }
-        if (RFLAG != 0 && RFLAG != 1) {
-            fprintf(OFP[0], "\n***ERROR*** Invalid restart flag\n");
-            goto EXIT1;
-        }
-        
-        if (RFLAG == 1) {
+        if (RFLAG == 1 && MPIRANK == 0 && pbm == NULL) {
             int errchk;
             char oldname[] = "results2.txt";
             char newname[] = "results2(old).txt";
@@ -374,12 +433,62 @@ int main (int argc, char **argv)
     for (i = 0; i < 7; ++i) {
         sprintf(file, "results%d.txt", i + 1);
         do {
-            OFP[i] = fopen(file, "w"); // Open output file for writing
+            if (pbm != NULL) {
+                // Write output to the model handle, which holds it once the file is closed
+                OFP[i] = open_memstream(&pbm->res[i], &pbm->nres[i]);
+            } else if (MPIRANK == 0) {
+                OFP[i] = fopen(file, "w"); // Open output file for writing
+            } else {
+                OFP[i] = tmpfile(); // The output of the other ranks replicates that of rank 0
+            }
         } while (OFP[i] == 0);
     }
     
+    // Check the restart information once the output files are open to report errors
+    if (CHKPT < 0) {
+        fprintf(OFP[0], "\n***ERROR*** Invalid checkpoint value\n");
+        goto EXIT1;
+    }
+    if (RFLAG != 0 && RFLAG != 1) {
+        fprintf(OFP[0], "\n***ERROR*** Invalid restart flag\n");
+        goto EXIT1;
+    }
+    
+    /* Checkpoint files are written to the working directory, which the models analyzed
+     concurrently through the library interface would share */
+    if (pbm != NULL && RFLAG == 1) {
+        fprintf(OFP[0], "\n***ERROR*** Restart is not available through the library interface\n");
+        goto EXIT1;
+    }
+    if (pbm != NULL && CHKPT != 0) {
+        fprintf(OFP[0], "\n***WARNING*** Checkpoint files are not written through the library interface\n");
+        CHKPT = 0;
+    }
+    
     // Read in solver type from input file
-    fscanf(IFP[0], "%d\n", &SLVFLAG);
+    fscanf(IFP[0], "%d", &SLVFLAG);
+    MPFLAG = OOCFLAG = LRMAX = 0;
+    if (fscanf(IFP[0], ",%d", &MPFLAG) == 1 && fscanf(IFP[0], ",%d", &OOCFLAG) == 1) {
+        fscanf(IFP[0], ",%d", &LRMAX);
+    }
+    fscanf(IFP[0], "\n");
+    /* The iterative solver works on the skyline matrix, and is otherwise treated as the
+     skyline solver */
+    ITFLAG = 0;
+    if (SLVFLAG == 4) {
+        SLVFLAG = 0;
+        ITFLAG = 1;
+        MPFLAG = 0;
+    }
+    if (SLVFLAG != 0) {
+        MPFLAG = OOCFLAG = 0;
+    }
+    /* The low-rank updates apply to the in-core double precision factorization of the
+     inelastic tangent stiffness matrix under NR and MNR iterations */
+    if (SLVFLAG != 0 || ITFLAG == 1 || MPFLAG != 0 || OOCFLAG != 0 || ANAFLAG != 3 ||
+        (ALGFLAG != 1 && ALGFLAG != 2) || LRMAX < 0) {
+        LRMAX = 0;
+    }
     
     if (ALGFLAG < 4) { // Static analysis
         if (ANAFLAG == 1 && ALGFLAG != 4) {
@@ -416,21 +525,65 @@ int main (int argc, char **argv)
         fprintf(OFP[0], "\nAlgorithm Type:\n\tModified Spherical Arc Length\n");
     } else if (ALGFLAG == 4 || ALGFLAG == 5)   {
         fprintf(OFP[0], "\nAlgorithm Type:\n\tDynamic (Newmark)\n");
+    } else if (ALGFLAG == 6 && ANAFLAG == 4) {
+        fprintf(OFP[0], "\nAlgorithm Type:\n\tHarmonic (Frequency Domain)\n");
     } else {
         fprintf(OFP[0], "\n***ERROR*** Invalid entry for algorithm type\n");
         goto EXIT1;
     }
     
+    // The CHOLMOD solver requires symmetric matrices, which FSI analysis does not produce
+    if (SLVFLAG == 3 && ANAFLAG == 4) {
+        fprintf(OFP[0], "\n***ERROR*** CHOLMOD solver is not available for FSI analysis\n");
+        goto EXIT1;
+    }
+    /* The partitioned FSI solver works on the skyline factors of the structure and fluid
+     blocks, so they are factorized in double precision */
+    if (SLVFLAG == 0 && ANAFLAG == 4) {
+        MPFLAG = 0;
+    }
+    if (ITFLAG == 1 && ALGFLAG == 3) {
+        fprintf(OFP[0], "\n***ERROR*** Iterative solver is not available for arc length analysis\n");
+        goto EXIT1;
+    }
+    
     // Read in optimization flag, number of joints and elements from input file
     fscanf(IFP[0], "%d\n", &OPTFLAG);
     fscanf(IFP[0], "%ld\n", &NJ);
-    fscanf(IFP[0], "%ld,%ld,%ld,%ld,%ld\n", &NE_TR, &NE_FR, &NE_SH, &NE_SBR, &NE_FBR);
+    fscanf(IFP[0], "%ld,%ld,%ld,%ld,%ld", &NE_TR, &NE_FR, &NE_SH, &NE_SBR, &NE_FBR);
+    NSUP = NEQI = 0;
+    if (fscanf(IFP[0], ",%ld", &NSUP) != 1 || NSUP < 0) {
+        NSUP = 0;
+    }
+    fscanf(IFP[0], "\n");
     fprintf(OFP[0], "\nControl Variables:\n\tNumber of Joints: %ld\n", NJ);
     fprintf(OFP[0], "\tNumber of Truss Elements: %ld\n", NE_TR);
     fprintf(OFP[0], "\tNumber of Frame Elements: %ld\n", NE_FR);
     fprintf(OFP[0], "\tNumber of Shell Elements: %ld\n", NE_SH);
     fprintf(OFP[0], "\tNumber of Solid Brick Elements: %ld\n", NE_SBR);
     fprintf(OFP[0], "\tNumber of Fluid Brick Elements: %ld\n", NE_FBR);
+    if (NSUP > 0) {
+        fprintf(OFP[0], "\tNumber of Substructure Instances: %ld\n", NSUP);
+    }
+    
+    /* The substructures are condensed from their linear-elastic stiffness matrices, which
+     are assembled on the skyline arrays */
+    if (NSUP > 0 && (ANAFLAG != 1 || ALGFLAG != 0 || SLVFLAG == 1 || ITFLAG == 1)) {
+        fprintf(OFP[0], "\n***ERROR*** Substructures are only available for 1st order elastic");
+        fprintf(OFP[0], " static analysis with SLVFLAG = 0, 2, or 3\n");
+        goto EXIT1;
+    }
+    
+    /* Static analyses with the skyline solver are run by domain decomposition over the MPI
+     ranks, each of which assembles the elements of its subdomain; the single precision
+     factorization and the low-rank updates work on the complete matrix, so they are not
+     used */
+    DDFLAG = 0;
+    if (MPISIZE > 1 && ANAFLAG != 4 && ALGFLAG < 3 && SLVFLAG == 0 && ITFLAG == 0 &&
+        NE_SBR + NE_FBR == 0 && NSUP == 0) {
+        DDFLAG = 1;
+        MPFLAG = LRMAX = 0;
+    }
     
     // Total number of bricks
     NE_BR = NE_SBR + NE_FBR;
@@ -447,28 +600,45 @@ int main (int argc, char **argv)
         // Open I/O for business!
         do {
             // Open optimized input file for writing
-            IFP[1] = fopen("model_def_OPT.txt", "w");
+            if (MPIRANK == 0 && pbm == NULL) {
+                IFP[1] = fopen("model_def_OPT.txt", "w");
+            } else {
+                IFP[1] = tmpfile();
+            }
         } while (IFP[1] == 0);
         
         // Write control variables to optimized input file
-        fprintf(IFP[1], "%d\n%d\n%d\n1\n%ld\n%ld,%ld,%ld,%ld,%ld\n", ANAFLAG, ALGFLAG, SLVFLAG, NJ,
-                NE_TR, NE_FR, NE_SH, NE_BR, NE_FBR);
+        fprintf(IFP[1], "%d\n%d\n%d", ANAFLAG, ALGFLAG, (ITFLAG == 1) ? 4 : SLVFLAG);
+        if (MPFLAG != 0 || OOCFLAG != 0 || LRMAX != 0) {
+            fprintf(IFP[1], ",%d", MPFLAG);
+        }
+        if (OOCFLAG != 0 || LRMAX != 0) {
+            fprintf(IFP[1], ",%d", OOCFLAG);
+        }
+        if (LRMAX != 0) {
+            fprintf(IFP[1], ",%d", LRMAX);
+        }
+        fprintf(IFP[1], "\n1\n%ld\n%ld,%ld,%ld,%ld,%ld", NJ, NE_TR, NE_FR, NE_SH, NE_BR, NE_FBR);
+        if (NSUP > 0) {
+            fprintf(IFP[1], ",%ld", NSUP);
+        }
+        fprintf(IFP[1], "\n");
     }
     
     // Memory management variables
-    /* Pointer-to-pointer-to-int array (9 arrays of type int are defined during program
+    /* Pointer-to-pointer-to-int array (11 arrays of type int are defined during program
      execution) */
-    int *p2p2i[9];
+    int *p2p2i[11];
     // Counter to track number of arrays of type int for which memory is allocated
     int ni = 0;
-    /* Pointer-to-pointer-to-long array (9 arrays of type long are defined during program
+    /* Pointer-to-pointer-to-long array (21 arrays of type long are defined during program
      execution) */
-    long *p2p2l[9];
+    long *p2p2l[21];
     // Counter to track number of arrays of type long for which memory is allocated
     int nl = 0;
-    /* Pointer-to-pointer-to-double array (111 arrays of type double are defined during
+    /* Pointer-to-pointer-to-double array (122 arrays of type double are defined during
      program execution) */
-    double *p2p2d[111];
+    double *p2p2d[122];
     // Counter to track number of arrays of type double for which memory is allocated
     int nd = 0;
     
@@ -551,6 +721,13 @@ int main (int argc, char **argv)
     }
     p2p2d[nd] = xlocal;
     nd++;
+    // Shell block of the batched shell element kernels (shell elements only)
+    double *shb = alloc_dbl_al ((NE_SH+SHB-1)/SHB*SHB*SH_NFLD);
+    if (shb == NULL) {
+        goto EXIT2;
+    }
+    p2p2d[nd] = shb;
+    nd++;
     
     /*
      Variables related to element material properties
@@ -940,6 +1117,13 @@ int main (int argc, char **argv)
     }
     p2p2l[nl] = jnt;
     nl++;
+    // Subdomains of the joints in the domain decomposition over the MPI ranks
+    long *jpart = alloc_long ((DDFLAG == 1) ? NJ : 1);
+    if (jpart == NULL) {
+        goto EXIT2;
+    }
+    p2p2l[nl] = jpart;
+    nl++;
     // Member global DOF code
     long *mcode = alloc_long (NE_TR*6+NE_FR*14+NE_SH*18+NE_SBR*24+NE_FBR*24);
     if (mcode == NULL) {
@@ -969,11 +1153,58 @@ int main (int argc, char **argv)
     p2p2i[ni] = wrpres;
     ni++;
     
+    /*
+     Substructure related variables (see super.c)
+     */
+    // Substructure instances
+    long *sup = alloc_long ((NSUP > 0) ? NSUP*SUPLEN : 1);
+    if (sup == NULL) {
+        goto EXIT2;
+    }
+    p2p2l[nl] = sup;
+    nl++;
+    // Boundary maps of the instances
+    long *supmap = alloc_long ((NSUP > 0) ? NE_TR*6+NE_FR*14+NE_SH*18 : 1);
+    if (supmap == NULL) {
+        goto EXIT2;
+    }
+    p2p2l[nl] = supmap;
+    nl++;
+    /* Member global DOF code of the elements assembled on the skyline arrays of this process,
+     i.e. without the elements of the instances, or only the elements of the subdomain of this
+     MPI rank; it is mcode itself otherwise */
+    long *mcodeg = alloc_long ((NSUP > 0 || DDFLAG == 1) ?
+                              NE_TR*6+NE_FR*14+NE_SH*18+NE_SBR*24+NE_FBR*24 : 1);
+    if (mcodeg == NULL) {
+        goto EXIT2;
+    }
+    p2p2l[nl] = mcodeg;
+    nl++;
+    if (NSUP == 0 && DDFLAG == 0) {
+        mcodeg = mcode;
+    }
+    // Member local DOF code of the substructures
+    long *mcodel = alloc_long ((NSUP > 0) ? NE_TR*6+NE_FR*14+NE_SH*18+NE_SBR*24+NE_FBR*24 : 1);
+    if (mcodel == NULL) {
+        goto EXIT2;
+    }
+    p2p2l[nl] = mcodel;
+    nl++;
+    // Diagonal addresses of the local skyline of the substructures
+    long *maxal = alloc_long ((NSUP > 0) ? NE_TR*6+NE_FR*14+NE_SH*18+1 : 1);
+    if (maxal == NULL) {
+        goto EXIT2;
+    }
+    p2p2l[nl] = maxal;
+    nl++;
+    // Lengths of the local skyline and of the condensed stiffness matrices
+    long lssl = 1, lsupv = 1;
+    
     /*
      Fluid-structure interaction related variables
      */
     // FSI incidences
-    long *fsiinc = alloc_long (NE_SBR*6*4+NE_SH*3*1e5);
+    long *fsiinc = alloc_long ((ANAFLAG == 4) ? NE_SBR*6*4+NE_SH*3 : 1);
     if (fsiinc == NULL) {
         goto EXIT2;
     }
@@ -1021,18 +1252,73 @@ int main (int argc, char **argv)
     nd++;
     
     // Pass control to struc function
-    int errchk = struc (jcode, minc, wrpres, jnt);
+    int errchk = struc (jcode, minc, wrpres, jnt, (pbm != NULL) ? pbm->jnt : NULL, jpart);
     
     // Terminate program if errors encountered
     if (errchk == 1) {
         goto EXIT2;
     }
     
+    /* The setup of a parameter sweep stops here, handing its node-numbering scheme to the
+       variants (see sweep.c) */
+    if (pbm != NULL && pbm->setup == 1) {
+        free (pbm->jnt);
+        pbm->jnt = NULL;
+        if (OPTFLAG == 2) {
+            pbm->jnt = alloc_long (NJ);
+            if (pbm->jnt == NULL) {
+                goto EXIT2;
+            }
+            for (i = 0; i < NJ; ++i) {
+                *(pbm->jnt+i) = *(jnt+i);
+            }
+        }
+        return free_all (p2p2i, ni, p2p2l, nl, p2p2d, nd, 0);
+    }
+    
+    // Pass control to superin function
+    if (NSUP > 0) {
+        errchk = superin (sup);
+        
+        // Terminate program if errors encountered
+        if (errchk == 1) {
+            goto EXIT2;
+        }
+    }
+    
     // Pass control to codes function
     codes (mcode, jcode, minc, wrpres);
     
+    // Pass control to supercodes function
+    if (NSUP > 0) {
+        errchk = supercodes (sup, supmap, mcode, mcodeg, mcodel, maxal, jcode, minc, wrpres,
+                             &lssl, &lsupv);
+        
+        // Terminate program if errors encountered
+        if (errchk == 1) {
+            goto EXIT2;
+        }
+    }
+    
+    // Pass control to ddcodes function
+    if (DDFLAG == 1) {
+        errchk = ddcodes (mcode, mcodeg, jpart, minc);
+        
+        // Terminate program if errors encountered
+        if (errchk < 0) {
+            goto EXIT2;
+        } else if (errchk == 0) {
+            DDFLAG = 0;
+            mcodeg = mcode;
+        }
+    }
+    
     // Print number of equations
     fprintf(OFP[0], "\nNumber of equations (system DOFs): %ld\n", NEQ);
+    if (NSUP > 0) {
+        fprintf(OFP[0], "Number of interior equations of the substructure instances: %ld\n",
+                NEQI);
+    }
     
     // Pass control to fsi function
     if (ANAFLAG == 4) {
@@ -1060,14 +1346,16 @@ int main (int argc, char **argv)
     if (ALGFLAG == 4 || ALGFLAG == 5) {NEQ_dyn = NEQ;}
     if (ANAFLAG == 4) {NEQ_FSI = NEQ;}
     
-    double *q = alloc_dbl (NEQ); // Generalized joint reference load vector
+    /* The load, displacement, and internal force vectors also hold the interior DOFs of the
+     substructure instances, after the NEQ DOFs */
+    double *q = alloc_dbl (NEQ+NEQI); // Generalized joint reference load vector
     if (q == NULL) {
         goto EXIT2;
     }
     p2p2d[nd] = q;
     nd++;
     // Generalized joint total load vector, i.e. lpf * q[NEQ]
-    double *qtot = alloc_dbl (NEQ);
+    double *qtot = alloc_dbl (NEQ+NEQI);
     if (qtot == NULL) {
         goto EXIT2;
     }
@@ -1083,7 +1371,7 @@ int main (int argc, char **argv)
     nd++;
     
     // Total and incremental generalized nodal displacement vectors
-    double *d = alloc_dbl (NEQ);
+    double *d = alloc_dbl (NEQ+NEQI);
     if (d == NULL) {
         goto EXIT2;
     }
@@ -1102,7 +1390,7 @@ int main (int argc, char **argv)
     p2p2d[nd] = d_temp;
     nd++;
     // Generalized internal force vector
-    double *f = alloc_dbl (NEQ);
+    double *f = alloc_dbl (NEQ+NEQI);
     if (f == NULL) {
         goto EXIT2;
     }
@@ -1161,28 +1449,18 @@ int main (int argc, char **argv)
     }
     p2p2l[nl] = pmot;
     nl++;
-    int *ii = alloc_int (NEQ-NBC);
-    if (ii == NULL) {
-        goto EXIT2;
-    }
-    p2p2i[ni] = ii;
-    ni++;
-    int *ij = alloc_int (NBC);
-    if (ij == NULL) {
-        goto EXIT2;
-    }
-    p2p2i[ni] = ij;
-    ni++;
     long lss;
     // Full system stiffness matrix
-    double *ss_fsi = alloc_dbl (NEQ_FSI*NEQ_FSI);
+    /* The coupled FSI stiffness and mass matrices are only held for the monolithic full order
+     solution */
+    double *ss_fsi = alloc_dbl ((SLVFLAG == 1) ? NEQ_FSI*NEQ_FSI : 1);
     if (ss_fsi == NULL) {
         goto EXIT2;
     }
     p2p2d[nd] = ss_fsi;
     nd++;
     // Full system mass matrix
-    double *sm_fsi = alloc_dbl (NEQ_FSI*NEQ_FSI);
+    double *sm_fsi = alloc_dbl ((SLVFLAG == 1) ? NEQ_FSI*NEQ_FSI : 1);
     if (sm_fsi == NULL) {
         goto EXIT2;
     }
@@ -1272,32 +1550,6 @@ int main (int argc, char **argv)
     }
     p2p2d[nd] = ac_i;
     nd++;
-    // L matrix
-    double *L = alloc_dbl (SNDOF*FNDOF); // L matrix = G*A
-    if (L == NULL) {
-        goto EXIT2;
-    }
-    p2p2d[nd] = L;
-    nd++;
-    double *LT = alloc_dbl (FNDOF*SNDOF); // L transpose
-    if (LT == NULL) {
-        goto EXIT2;
-    }
-    p2p2d[nd] = LT;
-    nd++;
-    double *G = alloc_dbl (SNDOF*FNDOF); // Matrix of direction cosines
-    if (G == NULL) {
-        goto EXIT2;
-    }
-    p2p2d[nd] = G;
-    nd++;
-    // Diagonal area matrix
-    double *A = alloc_dbl (FNDOF*FNDOF); //
-    if (A == NULL) {
-        goto EXIT2;
-    }
-    p2p2d[nd] = A;
-    nd++;
     // Effective load vector (for use in dynamic analysis)
     double *Reff = alloc_dbl (NEQ); //
     if (Reff == NULL) {
@@ -1320,24 +1572,79 @@ int main (int argc, char **argv)
     }
     p2p2i[ni] = Ap;
     ni++;
-    int *Ai = alloc_int (NEQ*NEQ); //
+    // Newmark integration constants
+    double alphaf, alpham, numopt, spectrds;
+    
+    // Pass control to skylin function
+    statbeg (ST_SKYLIN);
+    errchk = skylin (maxa, mcodeg, &lss, jcode, kht, pmot, sup, supmap);
+    statend (ST_SKYLIN, 0);
+    
+    // Print length of stiffness array
+    fprintf(OFP[0], "\nLength of stiffness array: %ld\n", lss);
+    if (BAND != 0) {
+        fprintf(OFP[0], "Half-bandwidth of stiffness array: %ld (LAPACK band storage)\n", BAND);
+    }
+    
+    // Terminate program if errors encountered
+    if (errchk == 1) {
+        goto EXIT2;
+    }
+    
+    /* Compressed column arrays are only needed by the sparse direct solvers; for UMFPACK they
+     hold both triangles of the skyline and, for FSI analysis, the two coupling blocks, of at
+     most three entries per fluid DOF each, and for CHOLMOD the upper triangle held by the
+     skyline */
+    long NZ_SP = 1;
+    if (SLVFLAG == 2) {
+        NZ_SP = 2*lss-NEQ + ((ANAFLAG == 4) ? 6*FNDOF : 0);
+    } else if (SLVFLAG == 3) {
+        NZ_SP = lss;
+    }
+    // The sparse solvers are called with int indices into the compressed columns
+    if (NZ_SP > INT_MAX) {
+        fprintf(OFP[0], "\n***ERROR*** Too many nonzero entries for the sparse solver\n");
+        goto EXIT2;
+    }
+    int *Ai = alloc_int (NZ_SP); //
     if (Ai == NULL) {
         goto EXIT2;
     }
     p2p2i[ni] = Ai;
     ni++;
-    double *Ax = alloc_dbl (NEQ*NEQ); //
+    double *Ax = alloc_dbl (NZ_SP); //
     if (Ax == NULL) {
         goto EXIT2;
     }
     p2p2d[nd] = Ax;
     nd++;
     
-    // Newmark integration constants
-    double alphaf, alpham, numopt, spectrds;
+    if (SLVFLAG == 0 && ANAFLAG == 4 && NBC != 0) {
+        fprintf(OFP[0], "\n***ERROR*** Prescribed displacements are not available for FSI analysis");
+        fprintf(OFP[0], " with the skyline solver\n");
+        goto EXIT2;
+    }
     
-    // Pass control to skylin function
-    errchk = skylin (maxa, mcode, &lss, jcode, kht, pmot);
+    // Rigid body modes of the joints for the multigrid preconditioner of the iterative solver
+    if (ITFLAG == 1 && ANAFLAG != 4) {
+        if (amgmodes (x, jcode) == 1) {
+            goto EXIT2;
+        }
+    }
+    
+    // Define variables which depend upon NBC (known once skylin has been called)
+    int *ii = alloc_int (NEQ-NBC+1);
+    if (ii == NULL) {
+        goto EXIT2;
+    }
+    p2p2i[ni] = ii;
+    ni++;
+    int *ij = alloc_int (NBC+1);
+    if (ij == NULL) {
+        goto EXIT2;
+    }
+    p2p2i[ni] = ij;
+    ni++;
     
     // Seperate interior dofs and boundary dofs for nonzero displacement matrix computation
     int cii, cij;
@@ -1353,26 +1660,37 @@ int main (int argc, char **argv)
         }
     }
     
-    // Print length of stiffness array
-    fprintf(OFP[0], "\nLength of stiffness array: %ld\n", lss);
-    
-    // Terminate program if errors encountered
-    if (errchk == 1) {
+    /* Skyline entries coupling the constrained DOFs to the remaining DOFs, collected once
+     so that partitioning the stiffness matrix is a single sweep over these entries */
+    long *part = alloc_long (1+3*matpartlist (maxa, pmot, ii, ij, NULL));
+    if (part == NULL) {
         goto EXIT2;
     }
+    p2p2l[nl] = part;
+    nl++;
+    matpartlist (maxa, pmot, ii, ij, part);
     
-    //Define variable which depends upon lss
+    /* Define variable which depends upon lss; with OOCFLAG = 1 the arrays of length lss are
+     mapped to scratch files, so that the skyline may exceed the available memory */
     // Effective stiffness matrix (for use in dynamic analysis)
-    double *Keff = alloc_dbl (lss); //
+    double *Keff = (OOCFLAG == 1) ? map_dbl (lss) : alloc_dbl (lss); //
     if (Keff == NULL) {
         goto EXIT2;
     }
     p2p2d[nd] = Keff;
     nd++;
     
+    // Stiffness matrix in LAPACK symmetric band storage (for use with the banded solver)
+    double *ab = alloc_dbl ((BAND != 0) ? NEQ*(BAND+1) : 1);
+    if (ab == NULL) {
+        goto EXIT2;
+    }
+    p2p2d[nd] = ab;
+    nd++;
+    
     // Define secondary variable which depends upon lss
     // Generalized stiffness array
-    double *ss = alloc_dbl (lss);
+    double *ss = (OOCFLAG == 1) ? map_dbl (lss) : alloc_dbl (lss);
     if (ss == NULL) {
         goto EXIT2;
     }
@@ -1381,13 +1699,29 @@ int main (int argc, char **argv)
     
     // Define secondary variable which depends upon lss
     // Generalized mass array
-    double *sm = alloc_dbl (lss);
+    double *sm = (OOCFLAG == 1) ? map_dbl (lss) : alloc_dbl (lss);
     if (sm == NULL) {
         goto EXIT2;
     }
     p2p2d[nd] = sm;
     nd++;
     
+    // Define secondary variables which depend upon lssl and lsupv
+    // Local stiffness array of the substructures
+    double *ssl = alloc_dbl (lssl);
+    if (ssl == NULL) {
+        goto EXIT2;
+    }
+    p2p2d[nd] = ssl;
+    nd++;
+    // Condensed stiffness matrices of the substructures
+    double *supv = alloc_dbl (lsupv);
+    if (supv == NULL) {
+        goto EXIT2;
+    }
+    p2p2d[nd] = supv;
+    nd++;
+    
     // Read in joint coordinates from input file
     fprintf(OFP[0], "\nJoint Coordinates:\n\tJoint\t\tDirection-1\tDirection-2\t");
     fprintf(OFP[0], "Direction-3\n");
@@ -1436,20 +1770,59 @@ int main (int argc, char **argv)
         prop_br (emod, nu, yield, dens, fdens, bmod, farea);
     }
     
+    // Apply the overrides of a variant of a parameter sweep
+    if (pbm != NULL && pbm->nov > 0) {
+        if (ovrprop (pbm->nov, pbm->povk, pbm->povv, emod, gmod, nu, carea, thick, dens, yield,
+                     istrong, iweak, ipolar, iwarp, zstrong, zweak) == 1) {
+            goto EXIT2;
+        }
+    }
+    
+    if (NE_SH > 0) {
+        // Pack the shell element properties into the shell block
+        pack_sh (shb, emod, nu, xlocal, thick, farea, slength);
+    }
+    
     // If fluid-structure interaction analysis
     if (ANAFLAG == 4){
         // Pass control to prop_fsi function
         prop_fsi (x, emod, nu, dens, fdens, bmod, farea, slength, yield, minc, elface, fsiinc, nnorm, tarea,
-                  ss, ss_fsi, sd_fsi, abspt, norpt, mcode, jcode, L);
+                  ss, ss_fsi, sd_fsi, abspt, norpt, mcode, jcode);
         
-        // Scan in the user desired number of time steps and total analysis
-        fscanf(IFP[0], "%ld,%lf\n", &ntstpsinpt, &ttot);
-        
-        // Calculate dt
-        dt = ttot/ntstpsinpt;
-        ntstpsinpt += 1;
+        long nfreq = 0;
+        double fmin = 0, fmax = 0;
+        if (ALGFLAG == 6) {
+            /* Scan in the frequency sweep; the load amplitudes are held as a load history of
+             a single time step */
+            fscanf(IFP[0], "%ld,%lf,%lf\n", &nfreq, &fmin, &fmax);
+            if (nfreq < 1 || fmin < 0 || fmax < fmin) {
+                fprintf(OFP[0], "\n***ERROR*** Invalid frequency sweep\n");
+                goto EXIT2;
+            }
+            ttot = 0;
+            dt = 1;
+            ntstpsinpt = 1;
+            HWIN = 0;
+        } else {
+            // Scan in the user desired number of time steps and total analysis
+            fscanf(IFP[0], "%ld,%lf", &ntstpsinpt, &ttot);
+            
+            // Scan in the optional load history window
+            if (fscanf(IFP[0], ",%ld", &HWIN) != 1) {
+                HWIN = 0;
+            }
+            fscanf(IFP[0], "\n");
+            if (HWIN < 0) {
+                fprintf(OFP[0], "\n***ERROR*** Negative load history window\n");
+                goto EXIT2;
+            }
+            
+            // Calculate dt
+            dt = ttot/ntstpsinpt;
+            ntstpsinpt += 1;
+        }
         
-        // Allocate memory to arrays of input times, applied forces, pressures and accelerations
+        // Allocate memory to arrays of input times
         double *tinpt = alloc_dbl (ntstpsinpt); // Time array
         if (tinpt == NULL) {
             goto EXIT2;
@@ -1457,29 +1830,63 @@ int main (int argc, char **argv)
         p2p2d[nd] = tinpt;
         nd++;
         
-        double *pinpt = alloc_dbl (SNDOF*ntstpsinpt); // Applied mechanical forces acting on solid nodes
+        /* Allocate memory to load histories of applied forces, pressures and accelerations;
+         only the loaded DOFs are stored */
+        long nrow[2];
+        if (histscan (jcode, nrow) == 1) {
+            goto EXIT2;
+        }
+        
+        long *pinpt_h = alloc_long (histlen (SNDOF, nrow[0])); // Index of applied mechanical forces
+        if (pinpt_h == NULL) {
+            goto EXIT2;
+        }
+        p2p2l[nl] = pinpt_h;
+        nl++;
+        
+        double *pinpt = alloc_dbl (histvlen (nrow[0], ntstpsinpt, 0)); // Applied mechanical forces acting on solid nodes
         if (pinpt == NULL) {
             goto EXIT2;
         }
         p2p2d[nd] = pinpt;
         nd++;
         
-        double *presinpt = alloc_dbl (FNDOF*ntstpsinpt); // Applied fluid pressures acting on fluid nodes
+        long *presinpt_h = alloc_long (histlen (FNDOF, nrow[1])); // Index of applied fluid pressures
+        if (presinpt_h == NULL) {
+            goto EXIT2;
+        }
+        p2p2l[nl] = presinpt_h;
+        nl++;
+        
+        double *presinpt = alloc_dbl (histvlen (nrow[1], ntstpsinpt, 0)); // Applied fluid pressures acting on fluid nodes
         if (presinpt == NULL) {
             goto EXIT2;
         }
         p2p2d[nd] = presinpt;
         nd++;
         
-        double *accinpt = alloc_dbl (FNDOF*ntstpsinpt); // Applied normal, incident fluid pressures acting on fluid nodes
+        long *accinpt_h = alloc_long (histlen (FNDOF, nrow[1])); // Index of applied fluid accelerations
+        if (accinpt_h == NULL) {
+            goto EXIT2;
+        }
+        p2p2l[nl] = accinpt_h;
+        nl++;
+        
+        double *accinpt = alloc_dbl (histvlen (nrow[1], ntstpsinpt, 0)); // Applied normal, incident fluid pressures acting on fluid nodes
         if (accinpt == NULL) {
             goto EXIT2;
         }
         p2p2d[nd] = accinpt;
         nd++;
         
+        histinit (pinpt_h, pinpt, SNDOF, nrow[0], ntstpsinpt, 0);
+        histinit (presinpt_h, presinpt, FNDOF, nrow[1], ntstpsinpt, 0);
+        histinit (accinpt_h, accinpt, FNDOF, nrow[1], ntstpsinpt, 0);
+        
         // Pass control to the L_br function
-        L_br(minc, mcode, jcode, jcode, nnorm, tarea, L, A, G);
+        if (L_br (elface, fsiinc, jcode, nnorm, tarea, fdens) == 1) {
+            goto EXIT2;
+        }
         
         // Initialize previous displacements, velocities, and accelerations
         for (i = 0; i < NEQ; ++i) {
@@ -1487,10 +1894,17 @@ int main (int argc, char **argv)
         }
         
         // Pass control to load_fsi function
-        load_fsi (jcode, tinpt, pinpt, presinpt, accinpt, fdens, um, vm, am);
+        errchk = load_fsi (jcode, tinpt, pinpt_h, pinpt, presinpt_h, presinpt, accinpt_h, accinpt, fdens, um, vm, am);
+        
+        // Terminate program if errors encountered
+        if (errchk == 1) {
+            goto EXIT2;
+        }
+        statend (ST_INPUT, 0);
         
-        /* Allocate memory to arrays of linearly interpolated loads, pressures and accelerations
-         based on the actual time step for transient analysis */
+        /* Allocate memory to the array of time steps and to the load history of external
+         agencies, linearly interpolated based on the actual time step for transient analysis;
+         the load history may be streamed from disk */
         double *tstps = alloc_dbl (NTSTPS); // Time array based on actual dt
         if (tstps == NULL) {
             goto EXIT2;
@@ -1498,60 +1912,54 @@ int main (int argc, char **argv)
         p2p2d[nd] = tstps;
         nd++;
         
-        double *qdyn = alloc_dbl (NEQ*NTSTPS); // Array of external agencies acting on the structure/fluid
-        if (qdyn == NULL) {
-            goto EXIT2;
-        }
-        p2p2d[nd] = qdyn;
-        nd++;
+        nrow[0] = nq_fsi (pinpt_h, presinpt_h, accinpt_h);
         
-        double *apload = alloc_dbl (SNDOF*NTSTPS); // Array of linearly interpolated appled mechanical forces
-        if (apload == NULL) {
+        long *qdyn_h = alloc_long (histlen (NEQ, nrow[0])); // Index of external agencies
+        if (qdyn_h == NULL) {
             goto EXIT2;
         }
-        p2p2d[nd] = apload;
-        nd++;
+        p2p2l[nl] = qdyn_h;
+        nl++;
         
-        double *pres = alloc_dbl (FNDOF*NTSTPS); // Array of linearly interpolated fluid pressures
-        if (pres == NULL) {
+        double *qdyn = alloc_dbl (histvlen (nrow[0], NTSTPS, HWIN)); // External agencies acting on the structure/fluid
+        if (qdyn == NULL) {
             goto EXIT2;
         }
-        p2p2d[nd] = pres;
+        p2p2d[nd] = qdyn;
         nd++;
         
-        double *acc = alloc_dbl (FNDOF*NTSTPS); // Array of linearly interpolated fluid incident accelerations
-        if (acc == NULL) {
+        long *pdisp_h = alloc_long (histlen (NEQ, 0)); // Index of nonzero displacements acting on boundary nodes
+        if (pdisp_h == NULL) {
             goto EXIT2;
         }
-        p2p2d[nd] = acc;
-        nd++;
+        p2p2l[nl] = pdisp_h;
+        nl++;
         
-        double *Lp = alloc_dbl (SNDOF*NTSTPS); // Array of linearly interpolated fluid incident accelerations
-        if (Lp == NULL) {
+        double *pdisp = alloc_dbl (histvlen (0, NTSTPS, 0)); // Nonzero displacements acting on boundary nodes
+        if (pdisp == NULL) {
             goto EXIT2;
         }
-        p2p2d[nd] = Lp;
+        p2p2d[nd] = pdisp;
         nd++;
         
-        double *Au = alloc_dbl (FNDOF*NTSTPS); // Array of linearly interpolated fluid incident accelerations
-        if (Au == NULL) {
+        histinit (pdisp_h, pdisp, NEQ, 0, NTSTPS, 0);
+        if (histinit (qdyn_h, qdyn, NEQ, nrow[0], NTSTPS, HWIN) == 1) {
             goto EXIT2;
         }
-        p2p2d[nd] = Au;
-        nd++;
         
-        double *pdisp = alloc_dbl (NEQ*NTSTPS); // Array of nonzero displacements acting on boundary nodes
-        if (pdisp == NULL) {
+        // Pass control to q_fsi function
+        if (q_fsi (jcode, qdyn_h, qdyn, tstps, fdens, tinpt, pinpt_h, pinpt, presinpt_h, presinpt,
+                   accinpt_h, accinpt) == 1) {
             goto EXIT2;
         }
-        p2p2d[nd] = pdisp;
-        nd++;
-        
-        // Pass control to q_fsi function
-        q_fsi (jcode, qdyn, tstps, apload, pres, acc, L, A, Lp, Au, fdens, tinpt, pinpt, presinpt, accinpt);
         
         // Time integration parameters
-        fscanf(IFP[0], "%lf,%lf\n", &numopt, &spectrds);
+        if (ALGFLAG == 6) {
+            numopt = 0;
+            spectrds = 1;
+        } else {
+            fscanf(IFP[0], "%lf,%lf\n", &numopt, &spectrds);
+        }
         
         if (numopt == 0 && spectrds != 1) {
             fprintf(OFP[0], "\n***ERROR*** Invalid spectral radius value for Newmark");
@@ -1576,9 +1984,14 @@ int main (int argc, char **argv)
         }
         
         // Pass control to stiff_fsi and mass_fsi functions
-        stiff_fsi(minc, mcode, jcode, nnorm, tarea,farea, thick, deffarea, slength, defslen, L, A, ss, ss_fsi,
+        stiff_fsi(minc, mcode, jcode, nnorm, tarea, thick, shb, deffarea, defslen, ss, ss_fsi,
                   x, xlocal, emod, nu, Jinv, jac, yield, c1, c2, c3, ef, d, chi, efN, efM, maxa);
-        mass_fsi (minc, mcode, jcode, nnorm, tarea, carea, farea, thick, slength, L, LT, sm, sm_fsi, x, dens, fdens, Jinv, jac);
+        mass_fsi (minc, mcode, jcode, nnorm, tarea, carea, farea, thick, slength, sm, sm_fsi, x, dens, fdens, Jinv, jac, maxa);
+        
+        // Pass control to fsicoup function for the partitioned solution on the skyline arrays
+        if (SLVFLAG == 0 && fsicoup () == 1) {
+            goto EXIT2;
+        }
         
         double ssd; // Dummy variable for solve function
         int det; // Flag for sign of determinant of tangent stiffness matrix
@@ -1587,21 +2000,44 @@ int main (int argc, char **argv)
         double time = *(tstps);
         int dum = 0;
         
-        // Pass control to output function
-        output (&time, &dum, uc, ef, 0);
-        
-        // Pass control to solve function
-        errchk = solve (jcode, ss, ss_fsi, sm, sm_fsi, sd_fsi, r, dd, maxa, &ssd, &det, um, vm, am, uc, vc, ac, qdyn, tstps,
-                        Keff, Reff, Meff, Ap, Ai, Ax, alpham, alphaf, ipiv, 0, 1, pdisp, kht, 0, ii, ij, 0);
+        if (ALGFLAG == 6) {
+            // Pass control to harm_fsi function
+            errchk = harm_fsi (maxa, ss, sm, sd_fsi, qdyn_h, qdyn, nfreq, fmin, fmax);
+            if (errchk == 1) {
+                goto EXIT2;
+            }
+        } else {
+            // Pass control to output function
+            output (&time, &dum, uc, ef, 0);
+            
+            // Pass control to solve function
+            errchk = solve (jcode, ss, ss_fsi, sm, sm_fsi, sm, sd_fsi, r, dd, maxa, &ssd, &det, um, vm, am, uc, vc, ac, qdyn_h, qdyn,
+                            Keff, Reff, Meff, ab, Ap, Ai, Ax, alpham, alphaf, ipiv, 0, 1, pdisp_h, pdisp, part, 0, ii, ij, 0);
+        }
     }
     
     // Analysis for non-FSI
     if (ANAFLAG != 4) {
         
+        // Number of DOFs subjected to applied forces and nonzero displacements
+        long nrow[2];
+        nrow[0] = nrow[1] = 0;
+        HWIN = 0;
+        
         if (ALGFLAG > 3) { // Dynamic analysis
             
             // Scan in the user desired number of time steps and total analysis
-            fscanf(IFP[0], "%ld,%lf\n", &ntstpsinpt, &ttot);
+            fscanf(IFP[0], "%ld,%lf", &ntstpsinpt, &ttot);
+            
+            // Scan in the optional load history window
+            if (fscanf(IFP[0], ",%ld", &HWIN) != 1) {
+                HWIN = 0;
+            }
+            fscanf(IFP[0], "\n");
+            if (HWIN < 0) {
+                fprintf(OFP[0], "\n***ERROR*** Negative load history window\n");
+                goto EXIT2;
+            }
             
             // Calculate dt
             dt = ttot/ntstpsinpt;
@@ -1611,6 +2047,11 @@ int main (int argc, char **argv)
                 CHKPT = ntstpsinpt + 1;
             }
             
+            // Count the loaded DOFs so that only their load histories are stored
+            if (histscan (jcode, nrow) == 1) {
+                goto EXIT2;
+            }
+            
         } else {
             ntstpsinpt = 0;
         }
@@ -1623,35 +2064,52 @@ int main (int argc, char **argv)
         p2p2d[nd] = tinpt;
         nd++;
         
-        double *pinpt = alloc_dbl (NEQ*ntstpsinpt); // Applied mechanical forces acting on nodes
+        long *pinpt_h = alloc_long (histlen (NEQ, nrow[0])); // Index of applied mechanical forces
+        if (pinpt_h == NULL) {
+            goto EXIT2;
+        }
+        p2p2l[nl] = pinpt_h;
+        nl++;
+        
+        double *pinpt = alloc_dbl (histvlen (nrow[0], ntstpsinpt, HWIN)); // Applied mechanical forces acting on nodes
         if (pinpt == NULL) {
             goto EXIT2;
         }
         p2p2d[nd] = pinpt;
         nd++;
         
-        double *dinpt = alloc_dbl (NEQ*ntstpsinpt); // Applied distributed loads acting on frame elements
-        if (dinpt == NULL) {
+        long *pdisp_h = alloc_long (histlen (NEQ, nrow[1])); // Index of applied nonzero displacements
+        if (pdisp_h == NULL) {
             goto EXIT2;
         }
-        p2p2d[nd] = dinpt;
-        nd++;
+        p2p2l[nl] = pdisp_h;
+        nl++;
         
-        double *pdisp = alloc_dbl (NEQ*ntstpsinpt); // Applied nonzero displacements acting on boundary nodes
+        double *pdisp = alloc_dbl (histvlen (nrow[1], ntstpsinpt, HWIN)); // Applied nonzero displacements acting on boundary nodes
         if (pdisp == NULL) {
             goto EXIT2;
         }
         p2p2d[nd] = pdisp;
         nd++;
         
+        if (histinit (pinpt_h, pinpt, NEQ, nrow[0], ntstpsinpt, HWIN) == 1 ||
+            histinit (pdisp_h, pdisp, NEQ, nrow[1], ntstpsinpt, HWIN) == 1) {
+            goto EXIT2;
+        }
+        
         // Pass control to load function
-        errchk = load (q, efFE_ref, x, llength, offset, osflag, c1, c2, c3, jnt, mcode, jcode, minc, tinpt, pinpt, dinpt, pdisp, um, vm, am);
+        errchk = load (q, efFE_ref, x, llength, offset, osflag, c1, c2, c3, jnt, mcode, jcode, minc, tinpt, pinpt_h, pinpt, pdisp_h, pdisp, um, vm, am);
         
         // Terminate program if errors encountered
         if (errchk == 1) {
             goto EXIT2;
         }
         
+        if (pbm != NULL && pbm->nov > 0) {
+            ovrload (pbm->nov, pbm->povk, pbm->povv, q, jnt, jcode);
+        }
+        statend (ST_INPUT, 0);
+        
         /*
          Define secondary non-array variables, common to both NR and MSAL algorithms
          */
@@ -1674,7 +2132,7 @@ int main (int argc, char **argv)
         
         if (ALGFLAG < 3) { // Static analysis
             // Initialize generalized total nodal displacement and internal force vectors
-            for (i = 0; i < NEQ; ++i) {
+            for (i = 0; i < NEQ + NEQI; ++i) {
                 d[i] = 0;
                 f[i] = 0;
             }
@@ -1721,10 +2179,48 @@ int main (int argc, char **argv)
                 
                 /* Compute generalized total external load vector, accounting for
                  generalized fixed-end load vector */
-                for (i = 0; i < NEQ; ++i) {
+                for (i = 0; i < NEQ + NEQI; ++i) {
                     qtot[i] = q[i] * lpfmax;
                 }
                 
+                if (NSUP > 0) {
+                    // Pass control to superchk function
+                    errchk = superchk (sup, minc, x, emod, gmod, nu, carea, thick, istrong,
+                                       iweak, ipolar, iwarp, offset, osflag, mendrel, c1, c2, c3);
+                    
+                    // Terminate program if errors encountered
+                    if (errchk == 1) {
+                        goto EXIT2;
+                    }
+                    
+                    /* Assemble the stiffness matrices of the substructures on the local
+                     skyline, by the local mcode */
+                    for (i = 0; i < lssl; ++i) {
+                        ssl[i] = 0;
+                    }
+                    if (NE_TR > 0) {
+                        stiff_tr (ssl, emod, carea, llength, defllen, yield, c1, c2, c3, ef,
+                                  maxal, mcodel);
+                    }
+                    if (NE_FR > 0) {
+                        stiff_fr (ssl, emod, gmod, carea, offset, osflag, llength, defllen,
+                                  istrong, iweak, ipolar, iwarp, yldflag, yield, zstrong, zweak,
+                                  c1, c2, c3, ef, efFE, mendrel, maxal, mcodel);
+                    }
+                    if (NE_SH > 0) {
+                        stiff_sh (ssl, emod, nu, x, xlocal, thick, shb, deffarea, defslen,
+                                  yield, c1, c2, c3, ef, d, chi, efN, efM, maxal, minc, mcodel);
+                    }
+                    
+                    // Pass control to supercond function
+                    errchk = supercond (sup, maxal, ssl, supv);
+                    
+                    // Terminate program if errors encountered
+                    if (errchk == 1) {
+                        goto EXIT2;
+                    }
+                }
+                
                 // Initialize tangent stiffness matrix to zero
                 for (i = 0; i < lss; ++i) {
                     ss[i] = 0;
@@ -1733,24 +2229,35 @@ int main (int argc, char **argv)
                 if (NE_TR > 0) {
                     // Pass control to stiff_tr function
                     stiff_tr (ss, emod, carea, llength, defllen, yield, c1, c2, c3, ef, maxa,
-                              mcode);
+                              mcodeg);
                 }
                 
                 if (NE_FR > 0) {
                     // Pass control to stiff_fr function
                     stiff_fr (ss, emod, gmod, carea, offset, osflag, llength, defllen,
                               istrong, iweak, ipolar, iwarp, yldflag, yield, zstrong, zweak, c1,
-                              c2, c3, ef, efFE, mendrel, maxa, mcode);
+                              c2, c3, ef, efFE, mendrel, maxa, mcodeg);
                 }
                 if (NE_SH > 0) {
                     // Pass control to stiff_sh function
-                    stiff_sh (ss, emod, nu, x, xlocal, thick, farea, deffarea, slength,
-                              defslen, yield, c1, c2, c3, ef, d, chi, efN, efM, maxa, minc, mcode);
+                    stiff_sh (ss, emod, nu, x, xlocal, thick, shb, deffarea,
+                              defslen, yield, c1, c2, c3, ef, d, chi, efN, efM, maxa, minc, mcodeg);
                 }
                 
                 if (NE_BR > 0) {
                     // Pass control to stiff_sh function
-                    stiff_br (ss, x, emod, nu, minc, mcode, jcode, Jinv, jac);
+                    stiff_br (ss, x, emod, nu, minc, mcodeg, jcode, Jinv, jac, maxa);
+                }
+                
+                if (NSUP > 0) {
+                    /* Pass control to superasm function, which adds the condensed stiffness
+                     matrices and loads of the instances */
+                    errchk = superasm (ss, qtot, maxa, sup, supmap, maxal, ssl, supv);
+                    
+                    // Terminate program if errors encountered
+                    if (errchk == 1) {
+                        goto EXIT2;
+                    }
                 }
                 
                 double ssd;
@@ -1763,7 +2270,19 @@ int main (int argc, char **argv)
                 } else {
                     
                     // Pass control to solve function
-                    errchk = solve (jcode, ss, ss_fsi, sm, sm_fsi, sd_fsi, qtot, d, maxa, &ssd, &det, um, vm, am, uc, vc, ac, pinpt, tinpt, Keff, Reff, Meff, Ap, Ai, Ax, alpham, alphaf, ipiv, 0, 1, pdisp, kht, 0, ii, ij, 0);
+                    errchk = solve (jcode, ss, ss_fsi, sm, sm_fsi, sm, sd_fsi, qtot, d, maxa, &ssd, &det, um, vm, am, uc, vc, ac, pinpt_h, pinpt, Keff, Reff, Meff, ab, Ap, Ai, Ax, alpham, alphaf, ipiv, 0, 1, pdisp_h, pdisp, part, 0, ii, ij, 0);
+                    
+                    // Terminate program if errors encountered
+                    if (errchk == 1) {
+                        goto EXIT2;
+                    }
+                }
+                
+                /* Recover the interior displacements of the substructure instances for the
+                 element forces and output */
+                if (NSUP > 0) {
+                    // Pass control to superrec function
+                    errchk = superrec (d, qtot, sup, supmap, maxal, ssl);
                     
                     // Terminate program if errors encountered
                     if (errchk == 1) {
@@ -1788,7 +2307,7 @@ int main (int argc, char **argv)
                 if (NE_SH > 0) {
                     // Pass control to forces_sh function
                     forces_sh (f, ef, ef, efN, efM, d, d, chi, x, x, emod, nu, xlocal, thick,
-                               farea, deffarea, slength, defslen, yield, c1, c2, c3, c1, c2, c3,
+                               shb, deffarea, defslen, yield, c1, c2, c3, c1, c2, c3,
                                minc, mcode, jcode);
                 }
                 
@@ -1804,18 +2323,108 @@ int main (int argc, char **argv)
                 double ssd; // Dummy variable for solve function
                 int inccnt; // Load increment counter
                 int solcnt, solmin; // Solution counter and minimum number of solutions
+                // Maximum and current number of BFGS vector pairs, and slot of next pair
+                int mbfgs, nbfgs, kbfgs;
+                int lsflag, lscnt, lschk; // Line search flag, counter and check
+                /* Line search step factors and energies along the search direction; current,
+                 previous, and retained end of the search interval */
+                double lsfac, lsfacb, lsfacp, ener0, ener, enerb, enerp;
+                /* Line search tolerance on the energy ratio, bounds on the step factor, and
+                 maximum number of line search iterations */
+                double lstol = 0.5, lsfacmin = 0.1, lsfacmax = 2;
+                int lsmax = 5;
+                // Predictor flag and check on the secant predictor in the current iteration
+                int prdflag, prdchk;
+                // Load proportionality factors of the last two converged load increments
+                double lpfcv, lpfcvp;
                 
                 // Read in solver parameters from input file
                 fscanf(IFP[0], "%lf,%lf,%lf,%lf,%lf\n", &lpfmax, &lpf, &dlpf, &dlpfmax,
                        &dlpfmin);
-                fscanf(IFP[0], "%d,%d,%d\n", &itemax, &submax, &solmin);
+                fscanf(IFP[0], "%d,%d,%d", &itemax, &submax, &solmin);
+                mbfgs = lsflag = prdflag = 0;
+                if (fscanf(IFP[0], ",%d", &mbfgs) == 1 && fscanf(IFP[0], ",%d", &lsflag) == 1) {
+                    fscanf(IFP[0], ",%d", &prdflag);
+                }
+                fscanf(IFP[0], "\n");
                 fscanf(IFP[0], "%lf,%lf,%lf\n", &toldisp, &tolforc, &tolener);
                 if (OPTFLAG == 2) {
                     fprintf(IFP[1], "%le,%le,%le,%le,%le\n", lpfmax,
                             lpf, dlpf, dlpfmax, dlpfmin);
-                    fprintf(IFP[1], "%d,%d,%d\n", itemax, submax, solmin);
+                    if (mbfgs != 0 || lsflag != 0 || prdflag != 0) {
+                        fprintf(IFP[1], "%d,%d,%d,%d,%d,%d\n", itemax, submax, solmin, mbfgs,
+                                lsflag, prdflag);
+                    } else {
+                        fprintf(IFP[1], "%d,%d,%d\n", itemax, submax, solmin);
+                    }
                     fprintf(IFP[1], "%lf,%lf,%lf\n", toldisp, tolforc, tolener);
                 }
+                /* BFGS updates only apply when the factorized tangent stiffness matrix is
+                 reused between iterations */
+                if (ALGFLAG != 2 || mbfgs < 0) {
+                    mbfgs = 0;
+                }
+                
+                /* BFGS vector pairs, i.e. incremental displacements and changes in internal
+                 force, stored column-wise */
+                double *sbfgs = alloc_dbl (NEQ*mbfgs);
+                if (sbfgs == NULL) {
+                    goto EXIT2;
+                }
+                p2p2d[nd] = sbfgs;
+                nd++;
+                double *ybfgs = alloc_dbl (NEQ*mbfgs);
+                if (ybfgs == NULL) {
+                    goto EXIT2;
+                }
+                p2p2d[nd] = ybfgs;
+                nd++;
+                // Reciprocal products of the BFGS vector pairs, followed by work factors
+                double *rhobfgs = alloc_dbl (mbfgs*2);
+                if (rhobfgs == NULL) {
+                    goto EXIT2;
+                }
+                p2p2d[nd] = rhobfgs;
+                nd++;
+                // Full incremental displacement vector before line search
+                double *ddls = alloc_dbl (NEQ);
+                if (ddls == NULL) {
+                    goto EXIT2;
+                }
+                p2p2d[nd] = ddls;
+                nd++;
+                /* Shell element curvatures and resultants, and frame element yield flags,
+                 at the start of the line search */
+                double *shls = alloc_dbl (NE_SH*21);
+                if (shls == NULL) {
+                    goto EXIT2;
+                }
+                p2p2d[nd] = shls;
+                nd++;
+                int *yldls = alloc_int (NE_FR*2);
+                if (yldls == NULL) {
+                    goto EXIT2;
+                }
+                p2p2i[ni] = yldls;
+                ni++;
+                nbfgs = kbfgs = 0;
+                /* Yielded vertices of the shell elements of the tangent stiffness matrix, read by
+                 the low-rank updates of its factorization (see lrelem) */
+                int *yvlr = alloc_int (NE_SH);
+                if (yvlr == NULL) {
+                    goto EXIT2;
+                }
+                p2p2i[ni] = yvlr;
+                ni++;
+                /* Generalized total nodal displacement vector from previous converged load
+                 increment */
+                double *dp = alloc_dbl (NEQ);
+                if (dp == NULL) {
+                    goto EXIT2;
+                }
+                p2p2d[nd] = dp;
+                nd++;
+                lpfcv = lpfcvp = 0;
                 
                 // Initialize load step, converged solution, and subdivision counters
                 inccnt = solcnt = subcnt = 0;
@@ -1894,30 +2503,49 @@ int main (int argc, char **argv)
                             r[i] = qtot[i] - f_temp[i];
                         }
                         
-                        if (ALGFLAG == 1 || (ALGFLAG == 2 && itecnt == 0)) {
+                        /* The first iteration of a load increment is replaced by the secant
+                         predictor once two converged configurations are available, unless
+                         the increment is being re-attempted after a subdivision */
+                        prdchk = 0;
+                        if (prdflag == 1 && itecnt == 0 && inccnt > 0 && subcnt == 0 &&
+                            lpfcv != lpfcvp) {
+                            prdchk = 1;
+                        }
+                        
+                        if ((ALGFLAG == 1 && prdchk == 0) || (ALGFLAG == 2 && itecnt == 0)) {
                             // Initialize tangent stiffness matrix to zero
                             for (i = 0; i < lss; ++i) {
                                 ss[i] = 0;
                             }
+                            // Discard BFGS vector pairs of the previous tangent stiffness matrix
+                            nbfgs = kbfgs = 0;
                             
                             if (NE_TR > 0) {
                                 // Pass control to stiff_tr function
                                 stiff_tr (ss, emod, carea, llength, defllen_ip, yield, c1_ip,
-                                          c2_ip, c3_ip, ef_ip, maxa, mcode);
+                                          c2_ip, c3_ip, ef_ip, maxa, mcodeg);
                             }
                             if (NE_FR > 0) {
                                 // Pass control to stiff_fr function
                                 stiff_fr (ss, emod, gmod, carea, offset, osflag, llength,
                                           defllen_ip, istrong, iweak, ipolar, iwarp, yldflag,
                                           yield, zstrong, zweak, c1_ip, c2_ip, c3_ip, ef_ip,
-                                          efFE_ip, mendrel, maxa, mcode);
+                                          efFE_ip, mendrel, maxa, mcodeg);
                             }
                             if (NE_SH > 0) {
                                 // Pass control to stiff_sh function
-                                stiff_sh (ss, emod, nu, x_temp, xlocal, thick, farea,
-                                          deffarea_ip, slength, defslen_ip, yield, c1_ip, c2_ip,
+                                stiff_sh (ss, emod, nu, x_temp, xlocal, thick, shb,
+                                          deffarea_ip, defslen_ip, yield, c1_ip, c2_ip,
                                           c3_ip, ef_ip, d_temp, chi_temp, efN_temp, efM_temp, maxa,
-                                          minc, mcode);
+                                          minc, mcodeg);
+                            }
+                            if (LRMAX > 0) {
+                                if (NE_SH > 0) {
+                                    // Pass control to yldvtx_sh function
+                                    yldvtx_sh (yvlr, yield, thick, chi_temp, efN_temp, efM_temp);
+                                }
+                                // Pass control to lrelem function
+                                lrelem (mcode, yldflag, yvlr);
                             }
                         }
                         
@@ -1926,15 +2554,25 @@ int main (int argc, char **argv)
                             /* Carry out computation of incremental displacement directly for
                              lss = 1 */
                             dd[0] = r[0] / ss[0];
-                        } else {
+                        } else if (ALGFLAG == 2 || prdchk == 0) {
                             if (ALGFLAG == 1 || (ALGFLAG == 2 && itecnt == 0)) {
                                 // Pass control to solve function
-                                errchk = solve (jcode, ss, ss_fsi, sm, sm_fsi, sd_fsi, r, dd, maxa, &ssd, &det, um, vm, am, uc, vc, ac, pinpt, tinpt,
-                                                Keff, Reff, Meff, Ap, Ai, Ax, alpham, alphaf, ipiv, 0, 1, pdisp, kht, 0, ii, ij, 0);
+                                errchk = solve (jcode, ss, ss_fsi, sm, sm_fsi, sm, sd_fsi, r, dd, maxa, &ssd, &det, um, vm, am, uc, vc, ac, pinpt_h, pinpt,
+                                                Keff, Reff, Meff, ab, Ap, Ai, Ax, alpham, alphaf, ipiv, 0, 1, pdisp_h, pdisp, part, 0, ii, ij, 0);
                             } else {
+                                if (nbfgs > 0) {
+                                    // Pass control to bfgsfwd function
+                                    bfgsfwd (r, sbfgs, ybfgs, rhobfgs, rhobfgs+mbfgs, nbfgs,
+                                             kbfgs, mbfgs);
+                                }
                                 // Pass control to solve function
-                                errchk = solve (jcode, ss, ss_fsi, sm, sm_fsi, sd_fsi, r, dd, maxa, &ssd, &det, um, vm, am, uc, vc, ac, pinpt, tinpt,
-                                                Keff, Reff, Meff, Ap, Ai, Ax, alpham, alphaf, ipiv, 1, 1, pdisp, kht, 0, ii, ij, 0);
+                                errchk = solve (jcode, ss, ss_fsi, sm, sm_fsi, sm, sd_fsi, r, dd, maxa, &ssd, &det, um, vm, am, uc, vc, ac, pinpt_h, pinpt,
+                                                Keff, Reff, Meff, ab, Ap, Ai, Ax, alpham, alphaf, ipiv, 1, 1, pdisp_h, pdisp, part, 0, ii, ij, 0);
+                                if (nbfgs > 0) {
+                                    // Pass control to bfgsbwd function
+                                    bfgsbwd (dd, sbfgs, ybfgs, rhobfgs, rhobfgs+mbfgs, nbfgs,
+                                             kbfgs, mbfgs);
+                                }
                             }
                             // Terminate program if errors encountered
                             if (errchk == 1) {
@@ -1942,40 +2580,149 @@ int main (int argc, char **argv)
                             }
                         }
                         
-                        /* Update generalized total nodal displacement vector, store
-                         generalized internal force vector from previous iteration, and
-                         re-initialize generalized internal force vector */
+                        if (prdchk == 1) {
+                            /* Extrapolate the incremental displacement vector from the last two
+                             converged configurations in proportion to the increment in load
+                             proportionality factor (secant predictor); under MNR the tangent
+                             stiffness matrix above is only factorized for the corrector */
+                            for (i = 0; i < NEQ; ++i) {
+                                dd[i] = (d[i] - dp[i]) * (lpf - lpfcv) / (lpfcv - lpfcvp);
+                            }
+                        }
+                        
+                        // Store generalized internal force vector from previous iteration
                         for (i = 0; i < NEQ; ++i) {
-                            d_temp[i] += dd[i];
                             f_ip[i] = f_temp[i];
-                            f_temp[i] = 0;
                         }
                         
-                        // Pass control to updatc function
-                        updatc (x_temp, x_ip, xfr_temp, dd, defllen_i, deffarea_i, defslen_i,
-                                offset, osflag, auxpt, c1_i, c2_i, c3_i, minc, jcode);
-                        
-                        if (NE_TR > 0) {
-                            // Pass control to forces_tr function
-                            forces_tr (f_temp, ef_i, d, emod, carea, llength, defllen_i,
-                                       yield, c1_i, c2_i, c3_i, mcode);
+                        /* Store the full incremental displacement vector, its energy against the
+                         residual force vector, and the state modified by the forces_fr and
+                         forces_sh functions, so that the increment may be scaled by the energy
+                         line search (Crisfield 1991, Sec. 9.3) */
+                        ener0 = 0;
+                        if (lsflag == 1) {
+                            for (i = 0; i < NEQ; ++i) {
+                                ddls[i] = dd[i];
+                                ener0 += dd[i] * (qtot[i] - f_ip[i]);
+                            }
+                            for (i = 0; i < NE_FR*2; ++i) {
+                                yldls[i] = yldflag[i];
+                            }
+                            for (i = 0; i < NE_SH; ++i) {
+                                for (j = 0; j < 3; ++j) {
+                                    shls[i*21+j] = chi_temp[i*3+j];
+                                }
+                                for (j = 0; j < 9; ++j) {
+                                    shls[i*21+3+j] = efN_temp[i*9+j];
+                                    shls[i*21+12+j] = efM_temp[i*9+j];
+                                }
+                            }
                         }
+                        lsfac = lsfacb = 1;
+                        lsfacp = 0;
+                        enerp = enerb = ener0;
+                        lscnt = 0;
                         
-                        if (NE_FR > 0) {
-                            // Pass control to forces_fr function
-                            frcchk_fr = forces_fr (f_temp, ef_ip, ef_i, efFE_ref, efFE_ip,
-                                                   efFE_i, yldflag, dd, emod, gmod, carea, offset, osflag,
-                                                   llength, defllen_ip, istrong, iweak, ipolar, iwarp, yield,
-                                                   zstrong, zweak, c1_ip, c2_ip, c3_ip, c1_i, c2_i, c3_i,
-                                                   mendrel, mcode, &dlpf, &itecnt);
-                        }
+                        do {
+                            /* Update generalized total nodal displacement vector and
+                             re-initialize generalized internal force vector */
+                            for (i = 0; i < NEQ; ++i) {
+                                d_temp[i] += dd[i];
+                                f_temp[i] = 0;
+                            }
+                            
+                            // Pass control to updatc function
+                            updatc (x_temp, x_ip, xfr_temp, dd, defllen_i, deffarea_i, defslen_i,
+                                    offset, osflag, auxpt, c1_i, c2_i, c3_i, minc, jcode);
+                            
+                            if (NE_TR > 0) {
+                                // Pass control to forces_tr function
+                                forces_tr (f_temp, ef_i, d, emod, carea, llength, defllen_i,
+                                           yield, c1_i, c2_i, c3_i, mcode);
+                            }
+                            
+                            if (NE_FR > 0) {
+                                // Pass control to forces_fr function
+                                frcchk_fr = forces_fr (f_temp, ef_ip, ef_i, efFE_ref, efFE_ip,
+                                                       efFE_i, yldflag, dd, emod, gmod, carea, offset, osflag,
+                                                       llength, defllen_ip, istrong, iweak, ipolar, iwarp, yield,
+                                                       zstrong, zweak, c1_ip, c2_ip, c3_ip, c1_i, c2_i, c3_i,
+                                                       mendrel, mcode, &dlpf, &itecnt);
+                            }
+                            
+                            if (NE_SH > 0) {
+                                // Pass control to forces_sh function
+                                frcchk_sh = forces_sh (f_temp, ef_ip, ef_i, efN_temp, efM_temp,
+                                                       dd, d_temp, chi_temp, x_temp, x_ip, emod, nu, xlocal, thick,
+                                                       shb, deffarea_ip, defslen_ip, yield, c1_ip, c2_ip,
+                                                       c3_ip, c1_i, c2_i, c3_i, minc, mcode, jcode);
+                            }
+                            
+                            /* Unless the increment is accepted, compute a new step factor by
+                             interpolation of the energy along the search direction (Illinois
+                             variant of regula falsi once the root is bracketed, secant otherwise)
+                             and restore the state at the start of the line search */
+                            lschk = 0;
+                            if (lsflag == 1 && ener0 > 0 && frcchk_fr == 0 && frcchk_sh == 0 &&
+                                lscnt < lsmax) {
+                                ener = 0;
+                                for (i = 0; i < NEQ; ++i) {
+                                    ener += ddls[i] * (qtot[i] - f_temp[i]);
+                                }
+                                if (fabs(ener) > lstol * ener0) {
+                                    lschk = 1;
+                                }
+                            }
+                            if (lschk == 1) {
+                                if (lscnt > 0) {
+                                    if (ener * enerb >= 0 && enerb * enerp < 0) {
+                                        enerp /= 2;
+                                    } else {
+                                        lsfacp = lsfacb;
+                                        enerp = enerb;
+                                    }
+                                }
+                                lsfacb = lsfac;
+                                enerb = ener;
+                                if (ener == enerp) {
+                                    lschk = 0;
+                                }
+                            }
+                            if (lschk == 1) {
+                                lsfac = lsfacb - enerb * (lsfacb - lsfacp) / (enerb - enerp);
+                                if (lsfac < lsfacmin) {
+                                    lsfac = lsfacmin;
+                                } else if (lsfac > lsfacmax) {
+                                    lsfac = lsfacmax;
+                                }
+                                
+                                for (i = 0; i < NEQ; ++i) {
+                                    d_temp[i] -= dd[i];
+                                    dd[i] = ddls[i] * lsfac;
+                                }
+                                for (i = 0; i < NJ*3; ++i) {
+                                    x_temp[i] = x_ip[i];
+                                }
+                                for (i = 0; i < NE_FR*2; ++i) {
+                                    yldflag[i] = yldls[i];
+                                }
+                                for (i = 0; i < NE_SH; ++i) {
+                                    for (j = 0; j < 3; ++j) {
+                                        chi_temp[i*3+j] = shls[i*21+j];
+                                    }
+                                    for (j = 0; j < 9; ++j) {
+                                        efN_temp[i*9+j] = shls[i*21+3+j];
+                                        efM_temp[i*9+j] = shls[i*21+12+j];
+                                    }
+                                }
+                                lscnt++;
+                            }
+                        } while (lschk == 1);
                         
-                        if (NE_SH > 0) {
-                            // Pass control to forces_sh function
-                            frcchk_sh = forces_sh (f_temp, ef_ip, ef_i, efN_temp, efM_temp,
-                                                   dd, d_temp, chi_temp, x_temp, x_ip, emod, nu, xlocal, thick,
-                                                   farea, deffarea_ip, slength, defslen_ip, yield, c1_ip, c2_ip,
-                                                   c3_ip, c1_i, c2_i, c3_i, minc, mcode, jcode);
+                        if (mbfgs > 0 && frcchk_fr == 0 && frcchk_sh == 0) {
+                            // Pass control to bfgsupd function
+                            bfgsupd (sbfgs, ybfgs, rhobfgs, dd, f_temp, f_ip, &nbfgs, &kbfgs,
+                                     mbfgs);
                         }
                         
                         // Update element internal forces from previous iteration
@@ -2072,9 +2819,12 @@ int main (int argc, char **argv)
                         /* Update all permanent variables to values which represent structure
                          in its current configuration */
                         for (i = 0; i < NEQ; ++i) {
+                            dp[i] = d[i];
                             d[i] = d_temp[i];
                             f[i] = f_temp[i];
                         }
+                        lpfcvp = lpfcv;
+                        lpfcv = lpf;
                         // General
                         for (i = 0; i < NE_TR*2+NE_FR*14+NE_SH*18; ++i) {
                             ef[i] = ef_i[i];
@@ -2217,7 +2967,7 @@ int main (int argc, char **argv)
             double alpha, temp, psi, psi_thresh; // Miscellaneous factors
             int iteopt; // Optimum number of eqilibrium iterations
             double dnorm, dnormallow; // Generic incremental displacement norms
-            double dotprod; // Generic dot product
+            double dotprod = 0; // Generic dot product
             // Load proportionality parameters
             double lpfc; // Current (absolute value)
             double lpf_temp;
@@ -2227,6 +2977,9 @@ int main (int argc, char **argv)
             // Subdivisions due to two neg. roots in arc length criterion
             int negcnt, negmax;
             int errchk2; // Error check on quad function
+            // Predictor flag and check on the secant predictor in the current increment
+            int prdflag, prdchk;
+            double prdfac = 0; // Scale factor of the secant predictor
             
             // Pass control to msal function
             errchk = msal (&dk, &dkdof, jnt, jcode);
@@ -2241,14 +2994,23 @@ int main (int argc, char **argv)
             fscanf(IFP[0], "%lf\n", &psi_thresh);
             fscanf(IFP[0], "%d\n", &iteopt);
             fscanf(IFP[0], "%lf,%lf\n", &lpfmax, &dkimax);
-            fscanf(IFP[0], "%d,%d,%d,%d\n", &itemax, &submax, &imagmax, &negmax);
+            fscanf(IFP[0], "%d,%d,%d,%d", &itemax, &submax, &imagmax, &negmax);
+            if (fscanf(IFP[0], ",%d", &prdflag) != 1) {
+                prdflag = 0;
+            }
+            fscanf(IFP[0], "\n");
             fscanf(IFP[0], "%lf,%lf,%lf\n", &toldisp, &tolforc, &tolener);
             if (OPTFLAG == 2) {
                 fprintf(IFP[1], "%le\n", alpha);
                 fprintf(IFP[1], "%le\n", psi_thresh);
                 fprintf(IFP[1], "%d\n", iteopt);
                 fprintf(IFP[1], "%le,%le\n", lpfmax, dkimax);
-                fprintf(IFP[1], "%d,%d,%d,%d\n", itemax, submax, imagmax, negmax);
+                if (prdflag != 0) {
+                    fprintf(IFP[1], "%d,%d,%d,%d,%d\n", itemax, submax, imagmax, negmax,
+                            prdflag);
+                } else {
+                    fprintf(IFP[1], "%d,%d,%d,%d\n", itemax, submax, imagmax, negmax);
+                }
                 fprintf(IFP[1], "%le,%le,%le\n", toldisp, tolforc, tolener);
             }
             
@@ -2316,7 +3078,7 @@ int main (int argc, char **argv)
             
             if (NE_SH > 0) {
                 // Pass control to stiff_sh function
-                stiff_sh (ss, emod, nu, x, xlocal, thick, farea, deffarea, slength, defslen,
+                stiff_sh (ss, emod, nu, x, xlocal, thick, shb, deffarea, defslen,
                           yield, c1, c2, c3, ef, d, chi, efN, efM, maxa, minc, mcode);
             }
             
@@ -2328,8 +3090,8 @@ int main (int argc, char **argv)
                 ssd[0] = ss[0];
             } else {
                 // Pass control to solve function
-                errchk = solve (jcode, ss, ss_fsi, sm, sm_fsi, sd_fsi, q, ddq, maxa, ssd, &det, um, vm, am, uc, vc, ac, pinpt, tinpt,
-                                Keff, Reff, Meff, Ap, Ai, Ax, alpham, alphaf, ipiv, 0, 1, pdisp, kht, 0, ii, ij, 0);
+                errchk = solve (jcode, ss, ss_fsi, sm, sm_fsi, sm, sd_fsi, q, ddq, maxa, ssd, &det, um, vm, am, uc, vc, ac, pinpt_h, pinpt,
+                                Keff, Reff, Meff, ab, Ap, Ai, Ax, alpham, alphaf, ipiv, 0, 1, pdisp_h, pdisp, part, 0, ii, ij, 0);
                 
                 // Terminate program if errors encountered
                 if (errchk == 1) {
@@ -2371,7 +3133,7 @@ int main (int argc, char **argv)
             if (NE_SH > 0) {
                 // Pass control to forces_sh function
                 frcchk_sh = forces_sh (f, ef_ip, ef_i, efN, efM, dd, d, chi, x, x_ip, emod,
-                                       nu, xlocal, thick, farea, deffarea_ip, slength, defslen_ip, yield, c1_ip,
+                                       nu, xlocal, thick, shb, deffarea_ip, defslen_ip, yield, c1_ip,
                                        c2_ip, c3_ip, c1_i, c2_i, c3_i, minc, mcode, jcode);
             }
             
@@ -2426,8 +3188,8 @@ int main (int argc, char **argv)
                     ssd[0] = ss[0];
                 } else {
                     // Pass control to solve function
-                    errchk = solve (jcode, ss, ss_fsi, sm, sm_fsi, sd_fsi, r, ddr, maxa, ssd, &det, um, vm, am, uc, vc, ac, pinpt, tinpt,
-                                    Keff, Reff, Meff, Ap, Ai, Ax, alpham, alphaf, ipiv, 1, 1, pdisp, kht, 0, ii, ij, 0);
+                    errchk = solve (jcode, ss, ss_fsi, sm, sm_fsi, sm, sd_fsi, r, ddr, maxa, ssd, &det, um, vm, am, uc, vc, ac, pinpt_h, pinpt,
+                                    Keff, Reff, Meff, ab, Ap, Ai, Ax, alpham, alphaf, ipiv, 1, 1, pdisp_h, pdisp, part, 0, ii, ij, 0);
                     
                     // Terminate program if errors encountered
                     if (errchk == 1) {
@@ -2471,7 +3233,7 @@ int main (int argc, char **argv)
                 if (NE_SH > 0) {
                     // Pass control to forces_sh function
                     frcchk_sh = forces_sh (f, ef_ip, ef_i, efN, efM, dd, d, chi, x, x_ip,
-                                           emod, nu, xlocal, thick, farea, deffarea_ip, slength, defslen_ip,
+                                           emod, nu, xlocal, thick, shb, deffarea_ip, defslen_ip,
                                            yield, c1_ip, c2_ip, c3_ip, c1_i, c2_i, c3_i, minc, mcode, jcode);
                 }
                 
@@ -2653,6 +3415,8 @@ int main (int argc, char **argv)
                 lpf_temp = lpf;
                 
                 if (errchk2 == 0) {
+                    prdchk = prdflag;
+                    
                     // Compute arc length
                     dotprod = 0;
                     for (i = 0; i < NEQ; ++i) {
@@ -2707,6 +3471,7 @@ int main (int argc, char **argv)
                     }
                     
                     errchk2 = 0; // Re-initialize at start of each increment
+                    prdchk = 0; // Re-attempted increments start from the tangent predictor
                 }
                 
                 // Initialize tangent stiffness matrix to zero
@@ -2729,7 +3494,7 @@ int main (int argc, char **argv)
                 
                 if (NE_SH > 0) {
                     // Pass control to stiff_sh function
-                    stiff_sh (ss, emod, nu, x, xlocal, thick, farea, deffarea, slength,
+                    stiff_sh (ss, emod, nu, x, xlocal, thick, shb, deffarea,
                               defslen, yield, c1, c2, c3, ef, d, chi, efN, efM, maxa, minc, mcode);
                 }
                 
@@ -2745,8 +3510,8 @@ int main (int argc, char **argv)
                     }
                 } else {
                     // Pass control to solve function
-                    errchk = solve (jcode, ss, ss_fsi, sm, sm_fsi, sd_fsi, q, ddq, maxa, ssd, &det, um, vm, am, uc, vc, ac, pinpt, tinpt,
-                                    Keff, Reff, Meff, Ap, Ai, Ax, alpham, alphaf, ipiv, 0, 1, pdisp, kht, 0, ii, ij, 0);
+                    errchk = solve (jcode, ss, ss_fsi, sm, sm_fsi, sm, sd_fsi, q, ddq, maxa, ssd, &det, um, vm, am, uc, vc, ac, pinpt_h, pinpt,
+                                    Keff, Reff, Meff, ab, Ap, Ai, Ax, alpham, alphaf, ipiv, 0, 1, pdisp_h, pdisp, part, 0, ii, ij, 0);
                     
                     // Terminate program if errors encountered
                     if (errchk == 1) {
@@ -2761,8 +3526,27 @@ int main (int argc, char **argv)
                     a = dot (ddq, ddq, NEQ);
                 }
                 
-                // Compute load proportionality factor for first iteration
-                if (det == 0) {
+                /* Compute scale factor of the secant predictor, which satisfies the arc length
+                 criterion with the last converged increment */
+                if (prdchk == 1) {
+                    if (psi >= psi_thresh) {
+                        prdfac = dotprod + (lpfp - lpfpp) * (lpfp - lpfpp) * dot(q, q, NEQ);
+                    } else {
+                        prdfac = dotprod;
+                    }
+                    if (prdfac > 0) {
+                        prdfac = arc / sqrt(prdfac);
+                    } else {
+                        prdchk = 0;
+                    }
+                }
+                
+                /* Compute load proportionality factor for first iteration; the secant
+                 predictor carries the sign of the load increment from the last converged
+                 increment, the tangent predictor takes it from the sign of the determinant */
+                if (prdchk == 1) {
+                    dlpf = prdfac * (lpfp - lpfpp);
+                } else if (det == 0) {
                     dlpf = arc * sqrt(1 / a);
                 } else {
                     dlpf = -arc * sqrt(1 / a);
@@ -2773,7 +3557,11 @@ int main (int argc, char **argv)
                 for (i = 0; i < NEQ; ++i) {
                     /* Compute generalized incremental nodal displacement vector and update
                      generalized total nodal displacement vector */
-                    dd[i] = dlpf * ddq[i];
+                    if (prdchk == 1) {
+                        dd[i] = prdfac * (dp[i] - dpp[i]);
+                    } else {
+                        dd[i] = dlpf * ddq[i];
+                    }
                     d_temp[i] += dd[i];
                     // Compute internal energy from the first iteration
                     intener1 += dd[i] * (dlpf * q[i]);
@@ -2802,7 +3590,7 @@ int main (int argc, char **argv)
                 if (NE_SH > 0) {
                     // Pass control to forces_sh function
                     forces_sh (f_temp, ef_ip, ef_i, efN_temp, efM_temp, dd, d_temp, chi_temp,
-                               x_temp, x_ip, emod, nu, xlocal, thick, farea, deffarea_ip, slength,
+                               x_temp, x_ip, emod, nu, xlocal, thick, shb, deffarea_ip,
                                defslen_ip, yield, c1_ip, c2_ip, c3_ip, c1_i, c2_i, c3_i, minc,
                                mcode, jcode);
                 }
@@ -2861,8 +3649,8 @@ int main (int argc, char **argv)
                         ddr[0] = r[0] / ss[0];
                     } else {
                         // Pass control to solve function
-                        errchk = solve (jcode, ss, ss_fsi, sm, sm_fsi, sd_fsi, r, ddr, maxa, ssd, &det, um, vm, am, uc, vc, ac, pinpt, tinpt,
-                                        Keff, Reff, Meff, Ap, Ai, Ax, alpham, alphaf, ipiv, 1, 1, pdisp, kht, 0, ii, ij, 0);
+                        errchk = solve (jcode, ss, ss_fsi, sm, sm_fsi, sm, sd_fsi, r, ddr, maxa, ssd, &det, um, vm, am, uc, vc, ac, pinpt_h, pinpt,
+                                        Keff, Reff, Meff, ab, Ap, Ai, Ax, alpham, alphaf, ipiv, 1, 1, pdisp_h, pdisp, part, 0, ii, ij, 0);
                         
                         // Terminate program if errors encountered
                         if (errchk == 1) {
@@ -2915,7 +3703,7 @@ int main (int argc, char **argv)
                             // Pass control to forces_sh function
                             frcchk_sh = forces_sh (f_temp, ef_ip, ef_i, efN_temp, efM_temp,
                                                    dd, d_temp, chi_temp, x_temp, x_ip, emod, nu, xlocal, thick,
-                                                   farea, deffarea_ip, slength, defslen_ip, yield, c1_ip, c2_ip,
+                                                   shb, deffarea_ip, defslen_ip, yield, c1_ip, c2_ip,
                                                    c3_ip, c1_i, c2_i, c3_i, minc, mcode, jcode);
                         }
                         
@@ -3227,7 +4015,7 @@ int main (int argc, char **argv)
                 // Pass control to stiff_tr function
                 stiff_tr (ss, emod, carea, llength, defllen, yield, c1, c2, c3, ef, maxa,
                           mcode);
-                mass_tr (sm, carea, llength, dens, x, minc, mcode, jac);
+                mass_tr (sm, carea, llength, dens, x, minc, mcode, maxa, jac);
             }
             
             if (NE_FR > 0) {
@@ -3236,21 +4024,23 @@ int main (int argc, char **argv)
                           istrong, iweak, ipolar, iwarp, yldflag, yield, zstrong, zweak, c1,
                           c2, c3, ef, efFE, mendrel, maxa, mcode);
                 mass_fr (sm, carea, llength, istrong, iweak, ipolar, iwarp, dens, osflag,
-                         offset, x, xfr, minc, mcode, jac);
+                         offset, x, xfr, minc, mcode, maxa, jac);
             }
             
             
             if (NE_SH > 0) {
                 // Pass control to stiff_sh function
-                stiff_sh (ss, emod, nu, x, xlocal, thick, farea, deffarea, slength,
+                stiff_sh (ss, emod, nu, x, xlocal, thick, shb, deffarea,
                           defslen, yield, c1, c2, c3, ef, d, chi, efN, efM, maxa, minc, mcode);
-                mass_sh (sm, carea, dens, thick, farea, slength, x, minc, mcode, jac);
+                mass_sh (sm, carea, dens, thick, farea, slength, x, minc, mcode, maxa, jac);
+                // mass_sh updates the face areas and side-lengths, so repack them
+                pack_sh (shb, emod, nu, xlocal, thick, farea, slength);
             }
             
             if (NE_BR > 0) {
                 // Pass control to stiff and mass functions
-                stiff_br (ss, x, emod, nu, minc, mcode, jcode, Jinv, jac);
-                mass_br (sm, dens, x, minc, mcode, jac);
+                stiff_br (ss, x, emod, nu, minc, mcode, jcode, Jinv, jac, maxa);
+                mass_br (sm, dens, x, minc, mcode, maxa, jac);
             }
             
             /* Evaluate expression for actual dt. If actual dt < input dt, then linearlly
@@ -3267,8 +4057,8 @@ int main (int argc, char **argv)
             double ssd;
             
             // Pass control to solve function
-            errchk = solve (jcode, ss, ss, sm, sm, sd_fsi, r, dd, maxa, &ssd, &det, um, vm, am, uc, vc, ac, pinpt, tinpt,
-                            Keff, Reff, Meff, Ap, Ai, Ax, alpham, alphaf, ipiv, 0, 1, pdisp, kht, 0, ii, ij, 0);
+            errchk = solve (jcode, ss, ss, sm, sm, sm, sd_fsi, r, dd, maxa, &ssd, &det, um, vm, am, uc, vc, ac, pinpt_h, pinpt,
+                            Keff, Reff, Meff, ab, Ap, Ai, Ax, alpham, alphaf, ipiv, 0, 1, pdisp_h, pdisp, part, 0, ii, ij, 0);
             
             // Terminate program if errors encountered
             if (errchk == 1) {
@@ -3292,7 +4082,7 @@ int main (int argc, char **argv)
             if (NE_SH > 0) {
                 // Pass control to forces_sh function
                 forces_sh (f, ef, ef, efN, efM, d, d, chi, x, x, emod, nu, xlocal, thick,
-                           farea, deffarea, slength, defslen, yield, c1, c2, c3, c1, c2, c3,
+                           shb, deffarea, defslen, yield, c1, c2, c3, c1, c2, c3,
                            minc, mcode, jcode);
             }
             
@@ -3313,6 +4103,19 @@ int main (int argc, char **argv)
             int inccnt; //Load increment counter
             int solcnt, solmin; // Minimum number of solutions
             int i, k;
+            int mflag; // Mass reassembly flag; set whenever the converged geometry changes
+            /* Modified Newton flag, number of iterations within a load increment after which
+             the effective stiffness matrix is reformed, and iterations since its reformation */
+            int mnrflag, itemnr, itesnc;
+            // Reformation check in the current iteration, and flag forcing a reformation
+            int refchk, refflag;
+            /* Maximum ratio of successive residual norms, residual norms of the current and
+             previous iterations, and time increment of the factorized matrix */
+            double ratmax, rnorm, rnormp, dtref;
+            /* Iteration statistics: total iterations, factorizations, and reformations due to
+             a new time increment or failed increment, the iteration count, the residual
+             contraction rate, and changes of yield state */
+            long nite, nfct, nrefs, nrefi, nrefr, nrefy;
             
             long tstep; // time step in checkpoint file
             
@@ -3322,11 +4125,29 @@ int main (int argc, char **argv)
             // Read in solver parameters from input file
             fscanf(IFP[0], "%lf,%lf,%lf,%lf,%lf\n", &lpfmax, &lpf, &dlpf, &dlpfmax,
                    &dlpfmin);
-            fscanf(IFP[0], "%d,%d,%d\n", &itemax, &submax, &solmin);
+            fscanf(IFP[0], "%d,%d,%d", &itemax, &submax, &solmin);
+            mnrflag = 0;
+            itemnr = 4;
+            ratmax = 0.5;
+            if (fscanf(IFP[0], ",%d", &mnrflag) == 1 && fscanf(IFP[0], ",%d", &itemnr) == 1) {
+                fscanf(IFP[0], ",%lf", &ratmax);
+            }
+            fscanf(IFP[0], "\n");
             fscanf(IFP[0], "%lf,%lf,%lf\n", &toldisp, &tolforc, &tolener);
             
             if (OPTFLAG == 2) {
-                fprintf(IFP[1], "%d,%d,%d\n", itemax, submax, solmin);
+                if (mnrflag != 0) {
+                    fprintf(IFP[1], "%d,%d,%d,%d,%d,%lf\n", itemax, submax, solmin, mnrflag,
+                            itemnr, ratmax);
+                } else {
+                    fprintf(IFP[1], "%d,%d,%d\n", itemax, submax, solmin);
+                }
+            }
+            
+            /* The coupling terms of prescribed displacements are removed from the effective
+             stiffness matrix when it is partitioned, so it is only reused if NBC = 0 */
+            if (mnrflag != 1 || NBC != 0 || lss == 1 || itemnr < 1) {
+                mnrflag = 0;
             }
             
             if (numopt == 0 && spectrds != 1) {
@@ -3365,6 +4186,49 @@ int main (int argc, char **argv)
             
             NTSTPS = ttot/dt + 1;
             
+            /* Lumped (row-summed) mass vector; with SLVFLAG == 0 it equals the assembled
+             mass array, otherwise it replaces the row sums of the full order mass matrix
+             so all solvers share the same residual computations */
+            double *sml = alloc_dbl (NEQ);
+            if (sml == NULL) {
+                goto EXIT2;
+            }
+            p2p2d[nd] = sml;
+            nd++;
+            
+            /* Mass array and lumped mass vector (stored after it) as assembled for the
+             current converged geometry; solve scales the masses at DOFs with prescribed
+             displacements in place, so a copy is only kept when NBC != 0 */
+            double *sm0 = alloc_dbl ((NBC != 0) ? lss+NEQ : 1);
+            if (sm0 == NULL) {
+                goto EXIT2;
+            }
+            p2p2d[nd] = sm0;
+            nd++;
+            
+            mflag = 1;
+            
+            // Frame element yield states at the last reformation of the effective stiffness matrix
+            int *yldref = alloc_int (NE_FR*2);
+            if (yldref == NULL) {
+                goto EXIT2;
+            }
+            p2p2i[ni] = yldref;
+            ni++;
+            
+            /* Yielded vertices of the shell elements at the last reformation, and in the
+             current iteration */
+            int *yvref = alloc_int (NE_SH*2);
+            if (yvref == NULL) {
+                goto EXIT2;
+            }
+            p2p2i[ni] = yvref;
+            ni++;
+            
+            refflag = 1;
+            rnorm = dtref = 0;
+            nite = nfct = nrefs = nrefi = nrefr = nrefy = 0;
+            
             // Initialize time stepping variables
             ddt = sub_dt = 1;
             dt_temp = dt;
@@ -3384,7 +4248,7 @@ int main (int argc, char **argv)
                 fscanf(IFP[3], "%ld\n", &tstep);
                 
                 // Pass control to restart step function to read in last stored information
-                restartStep(lss, uc, vc, ac, ss, sm, d, f, ef, x, c1, c2, c3, defllen,
+                restartStep(lss, uc, vc, ac, ss, d, f, ef, x, c1, c2, c3, defllen,
                             llength, efFE, xfr, yldflag, deffarea, defslen, chi, efN, efM);
                 
                 if (tstep+1 == NTSTPS) {
@@ -3534,7 +4398,7 @@ int main (int argc, char **argv)
                         }
                         
                         // Re-initialize iteration counter at the start of each increment
-                        itecnt = 0;
+                        itecnt = itesnc = 0;
                         
                         /* Start of each equilibrium iteration within load increment; iterations
                          will continue until convergence is reached or iteration count exceeds
@@ -3544,8 +4408,8 @@ int main (int argc, char **argv)
                         do {
                             // Apply nonzero displacement boundary conditions
                             for (i = 0; i < NEQ; ++i) {
-                                if (pdisp[i*NTSTPS+k] != 0) {
-                                    uc_i[i] = (pdisp[i*NTSTPS+k]-um[i])*sub_dt*lpf;
+                                if (histval(pdisp_h, pdisp, i, k) != 0) {
+                                    uc_i[i] = (histval(pdisp_h, pdisp, i, k)-um[i])*sub_dt*lpf;
                                 }
                             }
                             
@@ -3555,7 +4419,7 @@ int main (int argc, char **argv)
                                     for (i = 0; i < NEQ; ++i){
                                         /* Compute generalized total external load vector, accounting for
                                          generalized fixed-end load vector */
-                                        qtot[i] = pinpt[i*NTSTPS+k]*sub_dt*lpf;
+                                        qtot[i] = histval(pinpt_h, pinpt, i, k)*sub_dt*lpf;
                                         // Compute residual force vector
                                         r[i] = qtot[i] - f_temp[i];
                                     }
@@ -3563,60 +4427,177 @@ int main (int argc, char **argv)
                                     for (i = 0; i < NEQ; ++i) {
                                         /* Compute generalized total external load vector, accounting for
                                          generalized fixed-end load vector */
-                                        qtot[i] = (pinpt[i*NTSTPS+k-1]+(pinpt[i*NTSTPS+k]-pinpt[i*NTSTPS+k-1])*(sub_dt))*lpf;
+                                        qtot[i] = (histval(pinpt_h, pinpt, i, k-1)+(histval(pinpt_h, pinpt, i, k)-histval(pinpt_h, pinpt, i, k-1))*(sub_dt))*lpf;
                                         // Compute residual force vector
-                                        r[i] = (qtot[i]-f_temp[i]) + alphaf/(1-alphaf)*(pinpt[i*NTSTPS+k-1]-f_temp[i]);
+                                        r[i] = (qtot[i]-f_temp[i]) + alphaf/(1-alphaf)*(histval(pinpt_h, pinpt, i, k-1)-f_temp[i]);
                                     }
                                 }
                             } else { // Corrector steps
                                 // Compute residual force vector
+                                for (i = 0; i< NEQ; ++i){
+                                    r[i] = (f_temp[i]-qtot[i]);
+                                    r[i] = r[i]+sml[i]*ac_i[i]-sml[i]*((a2*vc_i[i]+a3*ac_i[i])*(1-alpham)-ac_i[i]*alpham)/(1-alphaf);
+                                }
+                            }
+                            
+                            /* The mass depends only on the last converged geometry x, so it is
+                             reassembled only after x has been updated; mass_tr and mass_fr also
+                             refresh the element lengths in llength_temp and xfr from x */
+                            if (mflag == 1) {
+                                for (i = 0; i < lss; ++i) {
+                                    sm[i] = 0;
+                                }
+                                
+                                if (NE_TR > 0) {
+                                    // Pass control to mass_tr function
+                                    mass_tr (sm, carea, llength_temp, dens, x, minc, mcode, maxa, jac);
+                                }
+                                
+                                if (NE_FR > 0) {
+                                    // Pass control to mass_fr function
+                                    mass_fr (sm, carea, llength_temp, istrong, iweak, ipolar, iwarp, dens, osflag,
+                                             offset, x, xfr, minc, mcode, maxa, jac);
+                                }
+                                
+                                if (NE_SH > 0) {
+                                    // Pass control to mass_sh function
+                                    mass_sh (sm, carea, dens, thick, farea, slength, x, minc, mcode, maxa, jac);
+                                    // mass_sh updates the face areas and side-lengths, so repack them
+                                    pack_sh (shb, emod, nu, xlocal, thick, farea, slength);
+                                }
+                                
+                                // Compute lumped mass vector
                                 if (SLVFLAG == 0) {
-                                    for (i = 0; i< NEQ; ++i){
-                                        r[i] = (f_temp[i]-qtot[i]);
-                                        r[i] = r[i]+sm[i]*ac_i[i]-sm[i]*((a2*vc_i[i]+a3*ac_i[i])*(1-alpham)-ac_i[i]*alpham)/(1-alphaf);
+                                    for (i = 0; i < NEQ; ++i) {
+                                        sml[i] = sm[i];
+                                    }
+                                } else if (SLVFLAG == 2 || SLVFLAG == 3) {
+                                    /* Row sums of the symmetric skyline mass array; each entry
+                                     above the diagonal adds to its row and to its column */
+                                    long l;
+                                    for (i = 0; i < NEQ; ++i) {
+                                        sml[i] = 0;
+                                    }
+                                    for (j = 0; j < NEQ; ++j) {
+                                        for (l = maxa[j]; l < maxa[j+1]; ++l) {
+                                            i = j - (l - maxa[j]);
+                                            sml[i] += sm[l-1];
+                                            if (i != j) {
+                                                sml[j] += sm[l-1];
+                                            }
+                                        }
                                     }
-                                } else if (SLVFLAG == 1){
+                                } else {
                                     for (i = 0; i < NEQ; ++i) {
                                         sum = 0;
                                         for (j = 0; j < NEQ; ++j) {
                                             sum += sm[i*NEQ+j];
                                         }
-                                        r[i] = (f_temp[i]-qtot[i]);
-                                        r[i] = r[i]+sum*ac_i[i]-sum*((a2*vc_i[i]+a3*ac_i[i])*(1-alpham)-ac_i[i]*alpham)/(1-alphaf);
+                                        sml[i] = sum;
                                     }
                                 }
+                                
+                                if (NBC != 0) {
+                                    for (i = 0; i < lss; ++i) {
+                                        sm0[i] = sm[i];
+                                    }
+                                    for (i = 0; i < NEQ; ++i) {
+                                        sm0[lss+i] = sml[i];
+                                    }
+                                }
+                                mflag = 0;
+                            } else if (NBC != 0) {
+                                // Restore the masses scaled by the previous call to solve
+                                for (i = 0; i < lss; ++i) {
+                                    sm[i] = sm0[i];
+                                }
+                                for (i = 0; i < NEQ; ++i) {
+                                    sml[i] = sm0[lss+i];
+                                }
                             }
                             
-                            for (i = 0; i < lss; ++i) {
-                                ss[i] = 0;
-                                sm[i] = 0;
-                            }
-                            
-                            if (NE_TR > 0) {
-                                // Pass control to stiff_tr and mass_tr function
-                                stiff_tr (ss, emod, carea, llength_temp, defllen_ip, yield, c1_ip,
-                                          c2_ip, c3_ip, ef_ip, maxa, mcode);
-                                mass_tr (sm, carea, llength_temp, dens, x, minc, mcode, jac);
-                            }
-                            
-                            if (NE_FR > 0) {
-                                // Pass control to stiff_fr and mass_fr function
-                                stiff_fr (ss, emod, gmod, carea, offset, osflag, llength_temp,
-                                          defllen_ip, istrong, iweak, ipolar, iwarp, yldflag,
-                                          yield, zstrong, zweak, c1_ip, c2_ip, c3_ip, ef_ip,
-                                          efFE_ip, mendrel, maxa, mcode);
-                                mass_fr (sm, carea, llength_temp, istrong, iweak, ipolar, iwarp, dens, osflag,
-                                         offset, x, xfr, minc, mcode, jac);
+                            /* Decide whether to reform the effective stiffness matrix; with the
+                             modified Newton option, the factorized matrix is reused until the
+                             time increment changes or an increment fails, itemnr iterations
+                             of the current increment have passed, the residual contracts by
+                             less than ratmax, a frame element changes its yield state, or a
+                             shell element changes its yielded vertex */
+                            rnormp = rnorm;
+                            rnorm = sqrt(dot(r, r, NEQ));
+                            refchk = 1;
+                            if (mnrflag == 1) {
+                                refchk = 0;
+                                if (refflag == 1 || dt_temp != dtref) {
+                                    refchk = 1;
+                                    nrefs++;
+                                } else if (itesnc >= itemnr) {
+                                    refchk = 1;
+                                    nrefi++;
+                                } else if (itecnt > 1 && rnorm > ratmax*rnormp) {
+                                    refchk = 1;
+                                    nrefr++;
+                                } else {
+                                    for (i = 0; i < NE_FR*2; ++i) {
+                                        if (yldflag[i] != yldref[i]) {
+                                            refchk = 1;
+                                        }
+                                    }
+                                    if (ANAFLAG == 3 && NE_SH > 0) {
+                                        // Pass control to yldvtx_sh function
+                                        yldvtx_sh (yvref+NE_SH, yield, thick, chi_temp, efN_temp,
+                                                   efM_temp);
+                                        for (i = 0; i < NE_SH; ++i) {
+                                            if (yvref[NE_SH+i] != yvref[i]) {
+                                                refchk = 1;
+                                            }
+                                        }
+                                    }
+                                    if (refchk == 1) {
+                                        nrefy++;
+                                    }
+                                }
                             }
                             
-                            if (NE_SH > 0) {
-                                // Pass control to stiff_sh and mass_sh function
-                                stiff_sh (ss, emod, nu, x_temp, xlocal, thick, farea,
-                                          deffarea_ip, slength, defslen_ip, yield, c1_ip, c2_ip,
-                                          c3_ip, ef_ip, d_temp, chi_temp, efN_temp, efM_temp, maxa,
-                                          minc, mcode);
-                                mass_sh (sm, carea, dens, thick, farea, slength, x, minc, mcode, jac);
+                            if (refchk == 1) {
+                                for (i = 0; i < lss; ++i) {
+                                    ss[i] = 0;
+                                }
+                                
+                                if (NE_TR > 0) {
+                                    // Pass control to stiff_tr function
+                                    stiff_tr (ss, emod, carea, llength_temp, defllen_ip, yield, c1_ip,
+                                              c2_ip, c3_ip, ef_ip, maxa, mcode);
+                                }
+                                
+                                if (NE_FR > 0) {
+                                    // Pass control to stiff_fr function
+                                    stiff_fr (ss, emod, gmod, carea, offset, osflag, llength_temp,
+                                              defllen_ip, istrong, iweak, ipolar, iwarp, yldflag,
+                                              yield, zstrong, zweak, c1_ip, c2_ip, c3_ip, ef_ip,
+                                              efFE_ip, mendrel, maxa, mcode);
+                                }
+                                
+                                if (NE_SH > 0) {
+                                    // Pass control to stiff_sh function
+                                    stiff_sh (ss, emod, nu, x_temp, xlocal, thick, shb,
+                                              deffarea_ip, defslen_ip, yield, c1_ip, c2_ip,
+                                              c3_ip, ef_ip, d_temp, chi_temp, efN_temp, efM_temp, maxa,
+                                              minc, mcode);
+                                }
+                                
+                                for (i = 0; i < NE_FR*2; ++i) {
+                                    yldref[i] = yldflag[i];
+                                }
+                                if (ANAFLAG == 3 && NE_SH > 0) {
+                                    // Pass control to yldvtx_sh function
+                                    yldvtx_sh (yvref, yield, thick, chi_temp, efN_temp, efM_temp);
+                                }
+                                dtref = dt_temp;
+                                refflag = itesnc = 0;
+                                nfct++;
                             }
+                            itesnc++;
+                            nite++;
                             
                             if (lss == 1) {
                                 /* Carry out computation of incremental displacement directly for
@@ -3624,8 +4605,8 @@ int main (int argc, char **argv)
                                 dd[0] = r[0] / ss[0];
                             } else {
                                 // Pass control to solve function
-                                errchk = solve (jcode, ss, ss, sm, sm, sd_fsi, r, dd, maxa, &ssd, &det, uc_i, vc_i, ac_i, um, vm, am, qtot, tinpt,
-                                                Keff, Reff, Meff, Ap, Ai, Ax, alpham, alphaf, ipiv, 0, ddt, pdisp, kht, &itecnt, ii, ij, k);
+                                errchk = solve (jcode, ss, ss, sm, sm, sml, sd_fsi, r, dd, maxa, &ssd, &det, uc_i, vc_i, ac_i, um, vm, am, pinpt_h, pinpt,
+                                                Keff, Reff, Meff, ab, Ap, Ai, Ax, alpham, alphaf, ipiv, 1-refchk, ddt, pdisp_h, pdisp, part, &itecnt, ii, ij, k);
                                 
                                 // Terminate program if errors encountered
                                 if (errchk == 1) {
@@ -3676,24 +4657,13 @@ int main (int argc, char **argv)
                                 // Pass control to forces_sh function
                                 frcchk_sh = forces_sh (f_temp, ef_ip, ef_i, efN_temp, efM_temp,
                                                        dd, d_temp, chi_temp, x_temp, x_ip, emod, nu, xlocal, thick,
-                                                       farea, deffarea_ip, slength, defslen_ip, yield, c1_ip, c2_ip,
+                                                       shb, deffarea_ip, defslen_ip, yield, c1_ip, c2_ip,
                                                        c3_ip, c1_i, c2_i, c3_i, minc, mcode, jcode);
                             }
                             
                             //Compute out-of-balance dynamic forces
-                            if (SLVFLAG == 0) {
-                                for (i = 0; i < NEQ; ++i){
-                                    dyn[i] = qtot[i] - sm[i]*ac_i[i];
-                                }
-                            }
-                            else if (SLVFLAG == 1) { // using CLAPACK solver
-                                for (i = 0; i < NEQ; ++i) {
-                                    sum = 0;
-                                    for (j = 0; j < NEQ; ++j) {
-                                        sum += sm[i*NEQ+j];
-                                    }
-                                    dyn[i] = qtot[i] - sum*ac_i[i];
-                                }
+                            for (i = 0; i < NEQ; ++i){
+                                dyn[i] = qtot[i] - sml[i]*ac_i[i];
                             }
                             
                             if (itecnt == 0) {
@@ -3706,22 +4676,9 @@ int main (int argc, char **argv)
                             
                             // Correct internal forces at nodes subjected to nonzero displacement boundary conditions
                             if (NBC != 0) {
-                                if (SLVFLAG == 0) {
-                                    for (i = 0; i < NEQ; ++i){
-                                        if (pmot[i] != 0) {
-                                            f_temp[i] = -sm[i]*ac_i[i];
-                                        }
-                                    }
-                                }
-                                else if (SLVFLAG == 1) { // using CLAPACK solver
-                                    for (i = 0; i < NEQ; ++i) {
-                                        sum = 0;
-                                        if (pmot[i] != 0) {
-                                            for (j = 0; j < NEQ; ++j) {
-                                                sum += sm[i*NEQ+j];
-                                            }
-                                            f_temp[i] = -sum*ac_i[i];
-                                        }
+                                for (i = 0; i < NEQ; ++i){
+                                    if (pmot[i] != 0) {
+                                        f_temp[i] = -sml[i]*ac_i[i];
                                     }
                                 }
                             }
@@ -3770,6 +4727,11 @@ int main (int argc, char **argv)
                             
                         } while (convchk != 0 && frcchk_fr == 0 && frcchk_sh == 0 && itecnt <= itemax);
                         
+                        // Reform the effective stiffness matrix after an unsuccessful increment
+                        if (convchk != 0 || frcchk_fr != 0 || frcchk_sh != 0) {
+                            refflag = 1;
+                        }
+                        
                         if (frcchk_fr == 2) {
                             dlpf = dlpfp; // Reset increment in load proportionality factor
                         } else if ((convchk != 0 || frcchk_fr != 0 || frcchk_sh != 0) &&
@@ -3861,6 +4823,9 @@ int main (int argc, char **argv)
                             ef[i] = ef_i[i];
                         }
                         for (i = 0; i < NJ*3; ++i) {
+                            if (x[i] != x_temp[i]) {
+                                mflag = 1; // Geometry changed; reassemble mass at next iteration
+                            }
                             x[i] = x_temp[i];
                         }
                         for (i = 0; i < NE_TR+NE_FR*3+NE_SH*3; ++i) {
@@ -3914,7 +4879,7 @@ int main (int argc, char **argv)
                             }
                         }
                         if ((k % CHKPT == 0) && (k != 0)) {
-                            checkPoint(k, lss, uc, vc, ac, ss, sm, d, f, ef, x, c1, c2, c3, defllen,
+                            checkPoint(k, lss, uc, vc, ac, ss, d, f, ef, x, c1, c2, c3, defllen,
                                        llength, efFE, xfr, yldflag, deffarea, defslen, chi, efN, efM);
                         }
                     }
@@ -3944,6 +4909,11 @@ int main (int argc, char **argv)
                     goto EXIT2;
                 }
                 
+                // The loads of the time step are undefined if the load history was not read
+                if (histfail (pinpt_h) == 1 || histfail (pdisp_h) == 1) {
+                    goto EXIT2;
+                }
+                
                 time = k * dt;
                 
                 //Pass control to output function
@@ -3953,6 +4923,16 @@ int main (int argc, char **argv)
                 
             } while (k < NTSTPS);
             
+            if (mnrflag == 1) {
+                fprintf(OFP[0], "\nModified Newton iteration statistics:\n");
+                fprintf(OFP[0], "\tIterations\t\t\t\t%ld\n", nite);
+                fprintf(OFP[0], "\tFactorizations\t\t\t\t%ld\n", nfct);
+                fprintf(OFP[0], "\tReformations due to new or failed time increment\t%ld\n", nrefs);
+                fprintf(OFP[0], "\tReformations due to iteration count\t\t%ld\n", nrefi);
+                fprintf(OFP[0], "\tReformations due to residual contraction rate\t%ld\n", nrefr);
+                fprintf(OFP[0], "\tReformations due to change of yield state\t%ld\n", nrefy);
+            }
+            
             if (convchk == 0) {
                 fprintf(OFP[0], "\nSolution successful!!\n");
             }
@@ -3963,11 +4943,13 @@ int main (int argc, char **argv)
     return free_all (p2p2i, ni, p2p2l, nl, p2p2d, nd, 0);
     
 EXIT1:
-    // Pass control to closeio function
-    return closeio(1);
+    // Pass control to closeio function, and signal the failure to the caller
+    closeio(1);
+    return 1;
 EXIT2:
-    // Pass control to free_all function
-    return free_all (p2p2i, ni, p2p2l, nl, p2p2d, nd, 1);
+    // Pass control to free_all function, and signal the failure to the caller
+    free_all (p2p2i, ni, p2p2l, nl, p2p2d, nd, 1);
+    return 1;
 }
 
 
@@ -1,102 +1,220 @@
-//********************************************************************************
-//**                                                                            **
-//**  Pertains to CU-BEN ver 4.0                                                **
-//**                                                                            **
-//**  CU-BENs: a ship hull modeling finite element library                      **
-//**  Copyright (c) 2019 C. J. Earls                                            **
-//**  Developed by C. J. Earls, Cornell University                              **
-//**  All rights reserved.                                                      **
-//**                                                                            **
-//**  Contributors:                                                             **
-//**    Christopher Stull                                                       **
-//**    Heather Reed                                                            **
-//**    Justyna Kosianka                                                        **
-//**    Wensi Wu                                                                **
-//**                                                                            **
-//**  This program is free software: you can redistribute it and/or modify it   **
-//**  under the terms of the GNU General Public License as published by the     **
-//**  Free Software Foundation, either version 3 of the License, or (at your    **
-//**  option) any later version.                                                **
-//**                                                                            **
-//**  This program is distributed in the hope that it will be useful, but       **
-//**  WITHOUT ANY WARRANTY; without even the implied warranty of                **
-//**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General  **
-//**  Public License for more details.                                          **
-//**                                                                            **
-//**  You should have received a copy of the GNU General Public License along   **
-//**  with this program. If not, see <https://www.gnu.org/licenses/>.           **
-//**                                                                            **
-//********************************************************************************
-
-
-#include <stdio.h>
-#include <stdlib.h>
-#include "prototypes.h"
-
-extern FILE *OFP[8];
-
-int * alloc_int (long arraylen)
-{
-    int *a;
-    a = (int *) malloc(arraylen * sizeof(int));
-    if (a == NULL) {
-        fprintf(OFP[0], "\n***ERROR*** Unable to allocate memory\n");
-        return NULL;
-    }
-    return a;
-}
-
-long * alloc_long (long arraylen)
-{
-    long *a;
-    a = (long *) malloc(arraylen * sizeof(long));
-    if (a == NULL) {
-        fprintf(OFP[0], "\n***ERROR*** Unable to allocate memory\n");
-        return NULL;
-    }
-    return a;
-}
-
-double * alloc_dbl (long arraylen)
-{
-    double *a;
-    a = (double *) malloc(arraylen * sizeof(double));
-    if (a == NULL) {
-        fprintf(OFP[0], "\n***ERROR*** Unable to allocate memory\n");
-        return NULL;
-    }
-    return a;
-}
-
-int free_all (int **pp2p2i, int ni, long **pp2p2l, int nl, double **pp2p2d, int nd,
-    int flag)
-{
-    // Initialize function variables
-    int i;
-
-    // Free allocated memory for arrays of type int
-    for (i = 0; i < ni; ++i) {
-        if (*(pp2p2i+i) != NULL) {
-            free (*(pp2p2i+i));
-            *(pp2p2i+i) = NULL;
-        }
-    }
-
-    // Free allocated memory for arrays of type long
-    for (i = 0; i < nl; ++i) {
-        if (*(pp2p2l+i) != NULL) {
-            free (*(pp2p2l+i));
-            *(pp2p2l+i) = NULL;
-        }
-    }
-
-    // Free allocated memory for arrays of type double
-    for (i = 0; i < nd; ++i) {
-        if (*(pp2p2d+i) != NULL) {
-            free (*(pp2p2d+i));
-            *(pp2p2d+i) = NULL;
-        }
-    }
-
-    return closeio(flag);
-}
+//********************************************************************************
+//**                                                                            **
+//**  Pertains to CU-BEN ver 4.0                                                **
+//**                                                                            **
+//**  CU-BENs: a ship hull modeling finite element library                      **
+//**  Copyright (c) 2019 C. J. Earls                                            **
+//**  Developed by C. J. Earls, Cornell University                              **
+//**  All rights reserved.                                                      **
+//**                                                                            **
+//**  Contributors:                                                             **
+//**    Christopher Stull                                                       **
+//**    Heather Reed                                                            **
+//**    Justyna Kosianka                                                        **
+//**    Wensi Wu                                                                **
+//**                                                                            **
+//**  This program is free software: you can redistribute it and/or modify it   **
+//**  under the terms of the GNU General Public License as published by the     **
+//**  Free Software Foundation, either version 3 of the License, or (at your    **
+//**  option) any later version.                                                **
+//**                                                                            **
+//**  This program is distributed in the hope that it will be useful, but       **
+//**  WITHOUT ANY WARRANTY; without even the implied warranty of                **
+//**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General  **
+//**  Public License for more details.                                          **
+//**                                                                            **
+//**  You should have received a copy of the GNU General Public License along   **
+//**  with this program. If not, see <https://www.gnu.org/licenses/>.           **
+//**                                                                            **
+//********************************************************************************
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "prototypes.h"
+
+extern BEN_TLS FILE *OFP[8];
+
+/* Addresses and lengths of the arrays mapped to disk files by map_dbl, so that they are
+ unmapped rather than freed */
+static BEN_TLS double *pmap[8];
+static BEN_TLS long lmap[8];
+static BEN_TLS int nmap = 0;
+
+/* The arrays are zeroed, since the analysis accumulates into some of them (e.g. the total
+ displacements) from zero, which the fresh heap of ben.exe provides but the heap reused by
+ successive analyses through the library interface does not */
+int * alloc_int (long arraylen)
+{
+    int *a;
+    a = (int *) calloc(arraylen, sizeof(int));
+    if (a == NULL) {
+        fprintf(OFP[0], "\n***ERROR*** Unable to allocate memory\n");
+        return NULL;
+    }
+    return a;
+}
+
+long * alloc_long (long arraylen)
+{
+    long *a;
+    a = (long *) calloc(arraylen, sizeof(long));
+    if (a == NULL) {
+        fprintf(OFP[0], "\n***ERROR*** Unable to allocate memory\n");
+        return NULL;
+    }
+    return a;
+}
+
+double * alloc_dbl (long arraylen)
+{
+    double *a;
+    a = (double *) calloc(arraylen, sizeof(double));
+    if (a == NULL) {
+        fprintf(OFP[0], "\n***ERROR*** Unable to allocate memory\n");
+        return NULL;
+    }
+    return a;
+}
+
+double * alloc_dbl_al (long arraylen)
+{
+    void *a;
+    if (posix_memalign(&a, 64, arraylen * sizeof(double)) != 0) {
+        fprintf(OFP[0], "\n***ERROR*** Unable to allocate memory\n");
+        return NULL;
+    }
+    memset(a, 0, arraylen * sizeof(double));
+    return (double *) a;
+}
+
+float * alloc_flt (long arraylen)
+{
+    float *a;
+    a = (float *) calloc(arraylen, sizeof(float));
+    if (a == NULL) {
+        fprintf(OFP[0], "\n***ERROR*** Unable to allocate memory\n");
+        return NULL;
+    }
+    return a;
+}
+
+double * map_dbl (long arraylen)
+{
+    int fd;
+    char file[] = "ben_ooc_XXXXXX";
+    void *a;
+    
+    if (nmap == 8) {
+        fprintf(OFP[0], "\n***ERROR*** Unable to map more arrays to disk\n");
+        return NULL;
+    }
+    
+    /* Create a scratch file of the size of the array in the working directory and map it
+     into memory; the file is unlinked at once, so that it is deleted when the array is
+     unmapped or the program terminates */
+    fd = mkstemp(file);
+    if (fd == -1) {
+        fprintf(OFP[0], "\n***ERROR*** Unable to create scratch file for out-of-core array\n");
+        return NULL;
+    }
+    unlink(file);
+    if (ftruncate(fd, (off_t) arraylen * sizeof(double)) != 0) {
+        close(fd);
+        fprintf(OFP[0], "\n***ERROR*** Unable to create scratch file for out-of-core array\n");
+        return NULL;
+    }
+    a = mmap(NULL, arraylen * sizeof(double), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (a == MAP_FAILED) {
+        fprintf(OFP[0], "\n***ERROR*** Unable to map out-of-core array\n");
+        return NULL;
+    }
+    
+    *(pmap+nmap) = (double *) a;
+    *(lmap+nmap) = arraylen;
+    nmap++;
+    return (double *) a;
+}
+
+void map_prefetch (double *a, long first, long last)
+{
+    // Initialize function variables
+    int i;
+    long page, start, end;
+    
+    // Only arrays mapped by map_dbl are read ahead; the range ends with the array
+    i = 0;
+    while (i < nmap && *(pmap+i) != a) {
+        i++;
+    }
+    if (i == nmap) {
+        return;
+    }
+    if (last > *(lmap+i)) {
+        last = *(lmap+i);
+    }
+    
+    /* Ask the kernel to read the given entries of the array ahead asynchronously; the
+     range is widened to whole pages */
+    page = sysconf(_SC_PAGESIZE);
+    start = ((long) (a + first)) / page * page;
+    end = (long) (a + last);
+    if (end > start) {
+        madvise((void *) start, end - start, MADV_WILLNEED);
+    }
+}
+
+void free_dbl (double *a)
+{
+    // Initialize function variables
+    int i;
+    
+    // Unmap an array mapped by map_dbl, or free an array allocated by alloc_dbl
+    for (i = 0; i < nmap; ++i) {
+        if (*(pmap+i) == a) {
+            munmap(a, *(lmap+i) * sizeof(double));
+            nmap--;
+            *(pmap+i) = *(pmap+nmap);
+            *(lmap+i) = *(lmap+nmap);
+            return;
+        }
+    }
+    free (a);
+}
+
+int free_all (int **pp2p2i, int ni, long **pp2p2l, int nl, double **pp2p2d, int nd,
+    int flag)
+{
+    // Initialize function variables
+    int i;
+
+    // Free allocated memory for arrays of type int
+    for (i = 0; i < ni; ++i) {
+        if (*(pp2p2i+i) != NULL) {
+            free (*(pp2p2i+i));
+            *(pp2p2i+i) = NULL;
+        }
+    }
+
+    // Free allocated memory for arrays of type long
+    for (i = 0; i < nl; ++i) {
+        if (*(pp2p2l+i) != NULL) {
+            free (*(pp2p2l+i));
+            *(pp2p2l+i) = NULL;
+        }
+    }
+
+    // Free allocated memory for arrays of type double
+    for (i = 0; i < nd; ++i) {
+        if (*(pp2p2d+i) != NULL) {
+            free_dbl (*(pp2p2d+i));
+            *(pp2p2d+i) = NULL;
+        }
+    }
+
+    return closeio(flag);
+}
@@ -1,403 +1,958 @@
-//********************************************************************************
-//**                                                                            **
-//**  Pertains to CU-BEN ver 4.0                                                **
-//**                                                                            **
-//**  CU-BENs: a ship hull modeling finite element library                      **
-//**  Copyright (c) 2019 C. J. Earls                                            **
-//**  Developed by C. J. Earls, Cornell University                              **
-//**  All rights reserved.                                                      **
-//**                                                                            **
-//**  Contributors:                                                             **
-//**    Christopher Stull                                                       **
-//**    Heather Reed                                                            **
-//**    Justyna Kosianka                                                        **
-//**    Wensi Wu                                                                **
-//**                                                                            **
-//**  This program is free software: you can redistribute it and/or modify it   **
-//**  under the terms of the GNU General Public License as published by the     **
-//**  Free Software Foundation, either version 3 of the License, or (at your    **
-//**  option) any later version.                                                **
-//**                                                                            **
-//**  This program is distributed in the hope that it will be useful, but       **
-//**  WITHOUT ANY WARRANTY; without even the implied warranty of                **
-//**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General  **
-//**  Public License for more details.                                          **
-//**                                                                            **
-//**  You should have received a copy of the GNU General Public License along   **
-//**  with this program. If not, see <https://www.gnu.org/licenses/>.           **
-//**                                                                            **
-//********************************************************************************
-
-
-/* Define function prototypes - convention: "p" precedes the name of the variable in
-   main being pointed to in the function */
-
-/*
-model.c
-*/
-
-/* This function reads in member incidences and joint constraints, checks for errors in
-   the joint constraint input and employs METIS functions to decompose the domain by
-   DOF-weighted joints */
-int struc (long *pjcode, long *pminc, int *pwrpres, long *pjnt);
-
-/* This function handles all acoustic fluid structure details for the monolithic coupling with the structural / solid mesh */
-void fsi (long *pmcode,  long *pjcode, long *pminc, long *pelface, long *pfsiinc);
-
-void renumfsi (long *pminc, long *pmcode, long *pjcode, long *pelface, long *pfsiinc);
-
-/* This function generates the adjacency structure of the graph associated with the
-   inputted finite element mesh. */
-int graph (long *pjnt, long *pxadj, long *pjcode, int *pwrpres, long *pminc, long *pjinc,
-    long *pjincloc);
-
-/* This function provides the optimum node-numbering scheme, with respect to minimization
-   of the bandwidth of the stiffness array; it follows the procedure outlined by Collins
-   (1973) */
-int optnum (long *pjnt, long *padjncy, long *pxadj, int *pflag);
-
-/* This function updates all previously defined joint-dependent variables so that they
-   reflect the optimum node-numbering scheme determined from optnum() */
-int updatenum (long *pjcode, long *pminc, int *pwrpres,  long *pjnt);
-
-/* This function generates joint code, jcode, by assigning integers in sequence, by
-   columns, to all nonzero elements of jcode from 1 to neq and generates the member code,
-   mcode, by transferring, via minc, columns of jcode into columns of mcode; it follows
-   procedure in Chapter 6 of Bathe and Wilson as well as Chapter 6 of Holzer */
-void codes (long *pmcode, long *pjcode, long *pminc, int *pwrpres);
-
-/* This function reads in: (1) the magnitude (mag) and the direction (dir) of the
-   concentrated force, and the joint (jt) on which it is applied AND / OR (2) the
-   magnitude (mag) and the direction (dir) of the distributed force, and the frame
-   element (fr) on which it is applied */
-int load (double *pq, double *pefFE_ref, double *px, double *pllength, double *poffset,
-		  int *posflag, double *pc1, double *pc2, double *pc3, long *pjnt, long *pmcode, long *pjcode, 
-		  long *pminc, double *ptinpt, double *ppinpt, double *pdinpt, double *ppdisp, double *pum, double *pvm, double *pam);
-
-// This function determines kht using mcode, and determines maxa from kht
-int skylin (long *pmaxa, long *pmcode, long *plss, long *pjcode, long *pkht, long *ppmot);
-
-/*
-truss.c
-*/
-
-/* This function reads and echoes truss element properties, as well as computing element
-   lengths and direction cosines */
-void prop_tr (double *px, double *pemod, double *pcarea, double *pdens, double *pllength,
-              double *pyield, double *pc1, double *pc2, double *pc3, long *pminc);
-
-/* This function computes the contribution to the generalized stiffness matrix from the
-   truss elements and stores it as an array */
-void stiff_tr (double *pss, double *pemod, double *pcarea, double *plength,
-    double *pdefllen_ip, double *pyield, double *pc1_ip, double *pc2_ip, double *pc3_ip,
-    double *pef_ip, long *pmaxa, long *pmcode);
-
-// This function adds contribution of material nonlinearity to element stiffness matrix
-void stiffm_tr (double *pk_tr, double *pef_ip, double *pPy, long n);
-
-/* This function computes the contribution to the generalized internal force vector from
-   the truss elements and truss element internal force vectors */
-void forces_tr (double *pf_temp, double *pef_i, double *pd, double *pemod,
-    double *pcarea, double *pllength, double *pdefllen_i, double *pyield, double *pc1_i,
-    double *pc2_i, double *pc3_i, long *pmcode);
-
-/* This function computes the contribution to the generalized mass matrix from the
-   truss elements and stores it as an array */
-void mass_tr (double *psm, double *pcarea, double *pllength, double *pdens, double *px, 
-         long *pminc, long *pmcode, double *pjac);
-
-/*
-frame.c
-*/
-
-/* This function reads and echoes frame element properties, as well as computing element
-   lengths and direction cosines */
-void prop_fr (double *px, double *pxfr, double *pemod, double *pgmod, double *pdens, double *poffset,
-              int *posflag, double *pauxpt, double *pcarea, double *pllength, double *pistrong,
-              double *piweak, double *pipolar, double *piwarp, double *pyield, double *pzstrong,
-              double *pzweak, double *pc1, double *pc2, double *pc3, int *pmendrel, long *pminc);
-
-/* This function computes the contribution to the generalized stiffness matrix from the
-   frame elements and stores it as an array */
-void stiff_fr (double *pss, double *pemod, double *pgmod, double *pcarea,
-    double *poffset, int *posflag, double *pllength, double *pdefllen_ip,
-    double *pistrong, double *piweak, double *pipolar, double *piwarp, int *pyldflag,
-    double *pyield, double *pzstrong, double *pzweak, double *pc1_ip, double *pc2_ip,
-    double *pc3_ip, double *pef_ip, double *pefFE_ip, int *pmendrel, long *pmaxa,
-    long *pmcode);
-
-// This function assigns non-zero elements of linear-elastic element stiffness matrix
-void stiffe_fr (double *pk_fr, double *pemod, double *pgmod, double *pcarea,
-    double *plength, double *pistrong, double *piweak, double *pipolar, double *piwarp,
-    long n);
-
-// This function adds contribution of geometric nonlinearity to element stiffness matrix
-void stiffg_fr (double *pk_fr, double *peftot_ip, double *pdefllen_ip, double *pcarea,
-    double *pipolar, long n);
-
-// This function adds contribution of material nonlinearity to element stiffness matrix
-void stiffm_fr (double *pk_fr, double *peftot_ip, int *pyldflag, double *pyield,
-    double *pcarea, double *pzstrong, double *pzweak, long n);
-
-/* This function modifies the frame element stiffness matrix to account for member end
-   releases associated with bending degrees of freedom; this algorithm is similar to that
-   implemented for the computation of the plastic reduction matrix */
-void release (double *pk_fr, int *pmendrel, int n);
-
-/* This function computes the contribution to the generalized internal force vector from
-   the frame elements and frame element internal force vectors */
-int forces_fr (double *pf_temp, double *pef_ip, double *pef_i, double *pefFE_ref,
-    double *pefFE_ip, double *pefFE_i, int *pyldflag, double *pdd, double *pemod,
-    double *pgmod, double *pcarea, double *poffset, int *posflag, double *pllength,
-    double *pdefllen_ip, double *pistrong, double *piweak, double *pipolar,
-    double *piwarp, double *pyield, double *pzstrong, double *pzweak, double *pc1_ip,
-    double *pc2_ip, double *pc3_ip, double *pc1_i, double *pc2_i, double *pc3_i,
-    int *pmendrel, long *pmcode, double *pdlpf, int *pitecnt);
-
-/* This function computes the contribution to the generalized mass matrix from the
-    frame elements and stores it as an array */
-void mass_fr (double *psm, double *pcarea, double *pllength, double *pistrong, double *piweak, 
-              double *pipolar, double *piwarp, double *pdens, int *posflag, double *poffset, 
-              double *px, double *pxfr, long *pminc, long *pmcode, double *pjac);
-
-/* This function, referred to as the "method of false position" or "regula falsi"
-   (McGuire, Gallagher, and Ziemian, p. 356), computes the scalar multiplier to be
-   applied to the current increment in force, such that the yield function to equal one,
-   within a specified tolerance */
-double regula_falsi (double *pp, double *pdp, double *pmy, double *pdmy, double *pmz,
-    double *pdmz);
-
-/* This function checks for the presence of unloading at hinges and returns appropriate
-   flag for analysis to continue */
-int unload (double *pphi, double *pp, double *pmy, double *pmz, double *pPy,
-    double *pMpy, double *pMpz, double *pk_fr, double *pdd, long n);
-
-/*
-shell.c
-*/
-
-/* This function reads and echoes shell element properties, as well as computing element
-   side-lengths, face-areas, and direction cosines */
-void prop_sh (double *px, double *pemod, double *pnu, double *pxlocal, double *pthick,  double *pdens,
-    double *pfarea, double *pslength, double *pyield, double *pc1, double *pc2,
-    double *pc3, long *pminc);
-
-/* This function computes the contribution to the generalized stiffness matrix from the
-   shell elements and stores it as an array */
-void stiff_sh (double *pss, double *pemod, double *pnu, double *px_temp, double *pxlocal,
-    double *pthick, double *pfarea, double *pdeffarea_ip, double *pslength,
-    double *pdefslen_ip, double *pyield, double *pc1_ip, double *pc2_ip, double *pc3_ip,
-    double *pef_ip, double *pd_temp, double *pchi_temp, double *pefN_temp,
-    double *pefM_temp, long *pmaxa, long *pminc, long *pmcode);
-
-// This function assigns non-zero elements of linear-elastic element stiffness matrix
-void stiffe_sh (double *pk_sh, double *pemod, double *pnu, double *pxlocal,
-    double *pthick, double *pfarea, double *pslength, long ptr, long n);
-
-// This function evaluates the linear-elastic membrane stiffness matrix
-void stiffe_m_sh (double *pke_m_sh, double *pemod, double *pnu, double *pxlocal,
-    double *pthick, double *pfarea, long ptr, long n);
-
-/* This function employs an algorithm which explicitly evaluates the linear-elastic plate
-   bending stiffness matrix (i.e. no numerical integration is performed) by taking
-   advantage of the properties of the matrices involved in its evaluation. Details of the
-   algorithm are found in Batoz (1982). */
-void stiffe_b_sh (double *pke_b_sh, double *pemod, double *pnu, double *pxlocal,
-    double *pthick, double *pfarea, double *pslength, long ptr, long n);
-
-// This function adds contribution of geometric nonlinearity to element stiffness matrix
-void stiffg_sh (double *pk_sh, double *pemod, double *pnu, double *pxlocal,
-    double *pthick, double *pdeffarea_ip, double *pdm, long ptr, long n);
-
-// This function assigns non-zero elements of elasto-plastic element stiffness matrix
-void stiffm_sh (double *pk_sh, double *pemod, double *pnu, double *pxlocal,
-    double *pthick, double *pdefffarea_ip, double *pdefslen_ip, double *pyield,
-    double *pefN_temp, double *pefM_temp, double *pchi_temp, int yv, double *pNo,
-    double *palpha, double *pMe, double *pNbar, double *pMbar, double *pMNbar,
-    double *pq_fact, double *pr_fact, double *ps_fact, int *ph_fact, long ptr,
-    long n);
-
-// This function evaluates the elasto-plastic membrane stiffness matrix
-void stiffm_m_sh (double *pkm_m_sh, double *pxlocal, double *pthick,
-    double *pdeffarea_ip, double *pC, double *pfn, double *pj_fact, double *pk_fact,
-    double *pB_fact, double *pdf_da, double *pda_dchi, long n);
-
-/* This function evaluates the elasto-plastic plate bending stiffness matrix, employing
-   a modified, but similar approach as in the stiff_b function */
-void stiffm_b_sh (double *pkm_b_sh, double *pxlocal, double *pthick,
-    double *pdeffarea_ip, double *pdefslen_ip, double *pC, double *pfm, double *pj_fact,
-    double *pk_fact, double *pB_fact, double *pdf_da, double *pda_dchi, long n);
-
-/* This function evaluates the coupled elasto-plastic stiffness matrix, employing a
-   modified, but similar approach as in the stiff_b and stiffm_b functions */
-void stiffm_mb_sh (double *pkm_mb_sh, double *pxlocal, double *pthick,
-    double *pdeffarea_ip, double *pdefslen_ip, double *pC, double *pfn, double *pfm,
-    double *pj_fact, double *pk_fact, double *pB_fact, double *pdf_da, double *pda_dchi,
-    long n);
-
-/* This function computes the contribution to the generalized mass matrix from the
-   shell elements and stores it as an array */
-void mass_sh (double *psm, double *pcarea, double *pdens, double *pthick,
-              double *pfarea, double *pslength, 
-              double *px, long *pminc, long *pmcode, double *pjac);
-
-/* This function computes the contribution to the generalized internal force vector from
-   the shell elements and shell element internal force vectors */
-int forces_sh (double *pf_temp, double *pef_ip, double *pef_i, double *pefN_temp,
-    double *pefM_temp, double *pdd, double *pd_temp, double *pchi_temp, double *px_temp,
-    double *px_ip, double *pemod, double *pnu, double *pxlocal, double *pthick,
-    double *pfarea, double *pdeffarea_ip, double *pslength, double *pdefslen_ip,
-    double *pyield, double *pc1_ip, double *pc2_ip, double *pc3_ip, double *pc1_i,
-    double *pc2_i, double *pc3_i, long *pminc, long *pmcode, long *pjcode);
-
-// This function computes the local membrane coordinates for each element
-void mem_coord (double *px_local, long n, long i, long j, long k, long l, double *px,
-    double *pc1, double *pc2, double *pc3, long ptr);
-
-/* This function computes the total (elastic plus plastic) strain and curvature
-   increments */
-void strn_curv (double *pstrn, double *pcurv, double *pddm, double *pddb,
-    double *pxlocal, double *pdeffarea_ip, double *pdefslen_ip, long n);
-
-/*
- brick.c
- */
-
-void prop_br (double *pemod, double *pnu, double *pyield, double *pdens, double *pfdens, double *pbmod,
-			  double *pfarea);
-
-void stiff_br (double *pss, double *px, double *pemod, double *pnu, long *pminc, 
-			   long *pmcode, long *pjcode, double *pJinv, double *pjac);
-
-void mass_br (double *psm, double *pdens, double *px, long *pminc, long *pmcode, double *pjac);
-
-void jacob (double *px, long *pminc, long *el, int *rval, int *sval, int *tval, double *pjac);
-
-/*
- fsi.c
- */
-
-void prop_fsi (double *px, double *pemod, double *pnu, double *pdens, double *pfdens, double *pbmod,
-			   double *pfarea, 
-			   double *pslength, double *pyield, long *pminc, long *pelface, long *pfsiinc, 
-			   double *pnnorm, double *ptarea, double *pss, double *pss_fsi, double *psd_fsi, double *pabspt,
-			   double *pnorpt, long *pmcode, long *pjcode, double *pL);
-
-void stiff_fsi (long *pminc, long *pmcode, long *pjcode, double *pnnorm, double *ptarea, double *pfarea, double *pthick, 
-				double *pdeffarea, double *pslength, double *pdefslen, double *pL, double *pA, double *pss, double *pss_fsi, 
-				double *px, double *pxlocal, double *pemod, double *pnu, double *pJinv, double *pjac, double *pyield, 
-				double *pc1, double *pc2, double *pc3, double *pef, double *pd, double *pchi, double *pefN, double *pefM, long *pmaxa);
-
-void mass_fsi (long *pminc, long *pmcode, long *pjcode, double *pnnorm, double *ptarea, double *pcarea, double *pfarea, 
-               double *pthick, double *pslength, double *pL, double *pLT, double *psm, double *psm_fsi, double *px, 
-               double *pdens, double *pfdens, double *pJinv, double *pjac);
-
-void L_br (long *pminc, long *pmcode, long *pjcode, long *pjcode_fsi, double *pnnorm, double *ptarea,
-		   double *pL, double *pA, double *pG);
-
-void load_fsi (long *pjcode_fsi, double *ptinpt, double *ppinpt, double *ppresinpt, double *paccinpt, double *pfdens,
-			   double *pum, double *pvm, double *pam);
-
-void q_fsi (long *pjcode_fsi, double *pqdyn, double *ptstps, double *papload, double *ppres, double *pacc, 
-			double *pL, double *pA, double *pLp, double *pAu, double *pfdens, double *ptinpt, double *ppinpt, double *ppresinpt, double *paccinpt);
-
-/*
-solve.c
-*/
-
-/* This function determines the solution within the increment using the compact Gaussian
-   elimination strategy (Holzer pp. 290, 296, 307) and based on subroutine COLSOL -
-   "active column solution or the skyline (or column) reduction method"
-   (Bathe 1976, p. 257) */
-int solve (long *pjcode_fsi, double *pss, double *pss_fsi, double *psm, double *psm_fsi, double *psd_fsi, double *pr, double *pdd, long *pmaxa, double *pssd, int *pdet,
-		   double *pum, double *pvm, double *pam, double *puc, double *pvc, double *pac, double *pqdyn, double *ptstps, 
-		   double *pKeff, double *pReff, double *pMeff, int *pAp, int *pAi, double *pAx, double alpham, double alphaf, int *pipiv, int fact, double ddt, double *ppdisp, long *pkht, int *piter, int *pii, int *pij, int tstp);
-
-/* This function performs LDL^t factorization of the stiffness matrix when using SLVFLAG == 0*/
-int skyfact (long *pmaxa, double *pss_temp, double *pssd, double *pdd, int fact, int *pdet);
-
-/*This function solves for x in Ax=b*/
-int skysolve (long *pmaxa, double *pss, double *pssd, double *pdd, int fact, int *pdet);
-
-/*This function solves for b in Ax=b*/
-int skymult (long *pmaxa, double *pss_temp, double *pdd);
-
-/*This function partitions matrix A into interior dofs and boundary dofs for solving systems with prescribed displacement boundary conditions*/
-int matpart (long *pmaxa, long *pkht, double *pss, double *pqtot, double *puc, int *pii, int *pij);
-
-/*
-arc.c
-*/
-
-/* This function reads in the MSAL parameters and checks that the prescribed initial
-   displacement does not correspond to a fixed degree of freedom */
-int msal (double *pdk, long *pdkdof, long *pjnt, long *pjcode);
-
-/* This function computes the roots of the quadratic equation, determines the correct
-   root, and updates nodal displacements and load proportionality factor */
-int quad (double *pa, double *pb, double *pc, double *pdt, double *pdp, double *pddr,
-    double *pddq, double *pdd, double *pdlpf, double *plpft);
-
-/*
-misc.c
-*/
-
-/* This function transforms the element stiffness matrix from local into global
-   coordinate system */
-void transform (double *pk, double *pT_ip, double *pK, int n);
-
-/* This function performs convergence check; assume that convergence is reached,
-   i.e. convchk = 0, until proven otherwise */
-int test (double *pd_temp, double *pdd, double *pf_temp, double *pfp, double *pqtot,
-    double *pf_ip, double *pintener1, int *pconvchk, double *ptoldisp, double *ptolfor,
-    double *ptolener);
-
-// This function updates element geometry
-void updatc (double *px_temp, double *px_ip, double *pxfr_temp, double *pdd,
-    double *pdefllen_i, double *pdeffarea_i, double *pdefslen_i, double *poffset,
-    int *posflag, double *pauxpt, double *pc1_i, double *pc2_i, double *pc3_i,
-    long *pminc, long *pjcode);
-
-// This function computes the dot product of two vectors
-double dot (double *pa, double *pb, int n);
-
-// This function computes the cross product of two vectors
-void cross (double *pa, double *pb, double *pc, int flag);
-
-// This function computes the inverse of a matrix through Gauss-Jordan elimination
-void inverse (double *pGT_k_G, int n);
-
-// This function outputs variables of interest to appropriate files
-void output (double *plpf, int *pitecnt, double *pd, double *pef, int flag);
-
-// This function closes the input and output files
-int closeio (int flag);
-
-// This function periodically backs up information for nonlinear dynamic analysis in the event of power outrages or hardware failures
-void checkPoint(long tstep, long lss, double *puc, double *pvc, double *pac, double *pss, double *psm, double *pd,
-                double *pf, double *pef, double *px, double *pc1, double *pc2, double *pc3, double *pdefllen,
-                double *pllength, double *pefFE, double *pxfr, int *pyldflag, double *pdeffarea, double *pdefslen,
-                double *pchi, double *pefN, double *pefM);
-
-// The function restores the last saved data before power outrages or hardware failures
-void restartStep(long lss, double *puc, double *pvc, double *pac, double *pss, double *psm, double *pd,
-                 double *pf, double *pef, double *px, double *pc1, double *pc2, double *pc3, double *pdefllen,
-                 double *pllength, double *pefFE, double *pxfr, int *pyldflag, double *pdeffarea, double *pdefslen,
-                 double *pchi, double *pefN, double *pefM);
-
-/*
-memory.c
-*/
-
-// This function allocates memory for an array of type int
-int * alloc_int (long arraylen);
-
-// This function allocates memory for an array of type long
-long * alloc_long (long arraylen);
-
-// This function allocates memory for an array of type double
-double * alloc_dbl (long arraylen);
-
-// This function frees all allocated memory
-int free_all (int **pp2p2i, int ni, long **pp2p2l, int nl, double **pp2p2d, int nd,
-    int flag);
+//********************************************************************************
+//**                                                                            **
+//**  Pertains to CU-BEN ver 4.0                                                **
+//**                                                                            **
+//**  CU-BENs: a ship hull modeling finite element library                      **
+//**  Copyright (c) 2019 C. J. Earls                                            **
+//**  Developed by C. J. Earls, Cornell University                              **
+//**  All rights reserved.                                                      **
+//**                                                                            **
+//**  Contributors:                                                             **
+//**    Christopher Stull                                                       **
+//**    Heather Reed                                                            **
+//**    Justyna Kosianka                                                        **
+//**    Wensi Wu                                                                **
+//**                                                                            **
+//**  This program is free software: you can redistribute it and/or modify it   **
+//**  under the terms of the GNU General Public License as published by the     **
+//**  Free Software Foundation, either version 3 of the License, or (at your    **
+//**  option) any later version.                                                **
+//**                                                                            **
+//**  This program is distributed in the hope that it will be useful, but       **
+//**  WITHOUT ANY WARRANTY; without even the implied warranty of                **
+//**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General  **
+//**  Public License for more details.                                          **
+//**                                                                            **
+//**  You should have received a copy of the GNU General Public License along   **
+//**  with this program. If not, see <https://www.gnu.org/licenses/>.           **
+//**                                                                            **
+//********************************************************************************
+
+
+/* Storage class of the model state, i.e. the global variables declared in main and the
+   static variables of the solver: each thread holds its own copy, so that separate models
+   can be analyzed concurrently on separate threads through the library interface (see
+   library.c) */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define BEN_TLS _Thread_local
+#else
+#define BEN_TLS __thread
+#endif
+
+/* Model handle of the library interface: the text of the input file (model_def.txt format),
+   and the contents of the output files results1.txt to results7.txt once analyzed; a
+   parameter sweep (sweep.c) adds the node-numbering scheme shared by its variants and the
+   overrides of the variant */
+typedef struct {
+    char *input;
+    size_t ninput;
+    char *res[7];
+    size_t nres[7];
+    long *jnt; // Node-numbering scheme given to the analysis (NULL if none), or found by it if setup
+    int setup; // 1 if the analysis stops once the node-numbering scheme is found
+    long nov; // Number of overrides
+    long *povk; // Kind, number, and field of each override, [nov][3]
+    double *povv; // Value of each override
+    char *stats; // Statistics of the analysis (stats.json format, see stats.c)
+    size_t nstats;
+} BENMODEL;
+
+/* Phases timed by the statistics of an analysis (see stats.c) */
+#define ST_INPUT 0
+#define ST_OPTNUM 1
+#define ST_SKYLIN 2
+#define ST_STIFF_TR 3
+#define ST_STIFF_FR 4
+#define ST_STIFF_SH 5
+#define ST_STIFF_BR 6
+#define ST_MASS_TR 7
+#define ST_MASS_FR 8
+#define ST_MASS_SH 9
+#define ST_MASS_BR 10
+#define ST_SOLVE 11
+#define ST_SKYFACT 12
+#define ST_SKYSOLVE 13
+#define ST_FORCES_TR 14
+#define ST_FORCES_FR 15
+#define ST_FORCES_SH 16
+#define ST_UPDATC 17
+#define ST_TEST 18
+#define ST_OUTPUT 19
+#define NSTAT 20 // Number of phases
+
+/* Shell block of the batched shell element kernels (see pack_sh): the shell elements are
+   taken SHB at a time, and each batch holds SH_NFLD fields, each with the values of the SHB
+   elements of the batch side by side, i.e. field f of element n is stored at
+   pshb[n / SHB * SH_NFLD * SHB + f * SHB + n % SHB] */
+#define SHB 4 // Number of elements of a batch
+#define SH_C 0 // Plane stress constitutive coefficients C[0][0], C[0][1], and C[2][2]
+#define SH_E 3 // Plate bending "constitutive matrix" coefficients E1, E2, and E4
+#define SH_THICK 6 // Thickness
+#define SH_FAREA 7 // Face area
+#define SH_XLOCAL 8 // Non-zero local coordinates, 3 fields
+#define SH_SLEN 11 // Side-lengths, 3 fields
+#define SH_DEFFAREA 14 // Deformed face area of the reference configuration
+#define SH_DEFSLEN 15 // Deformed side-lengths of the reference configuration, 3 fields
+#define SH_T 18 // Direction cosines c1, c2, and c3 of the current configuration, 9 fields
+/* Global coordinates of Vertices 2 and 3 relative to Vertex 1 in the current
+   configuration, by direction, 6 fields */
+#define SH_X 27
+#define SH_TP 33 // As SH_T, of the previous configuration
+#define SH_XP 42 // As SH_X, of the previous configuration
+#define SH_NFLD 48 // Number of fields
+
+/* Define function prototypes - convention: "p" precedes the name of the variable in
+   main being pointed to in the function */
+
+/*
+main.c
+*/
+
+/* This function analyzes the model read from model_def.txt, writing the results to
+   results1.txt to results7.txt, or the model held by pbm with the results written to it if
+   pbm is not NULL (see ben_run) */
+int analysis (BENMODEL *pbm);
+
+/*
+model.c
+*/
+
+/* This function reads in member incidences and joint constraints, checks for errors in
+   the joint constraint input and employs METIS functions to decompose the domain by
+   DOF-weighted joints; the node-numbering scheme pjnt0 is used instead of a new one if it
+   is not NULL, and the joints are partitioned into the subdomains pjpart of the MPI ranks
+   for the domain decomposition (DDFLAG = 1) */
+int struc (long *pjcode, long *pminc, int *pwrpres, long *pjnt, long *pjnt0, long *pjpart);
+
+/* This function handles all acoustic fluid structure details for the monolithic coupling with the structural / solid mesh */
+void fsi (long *pmcode,  long *pjcode, long *pminc, long *pelface, long *pfsiinc);
+
+void renumfsi (long *pminc, long *pmcode, long *pjcode, long *pelface, long *pfsiinc);
+
+/* This function generates the adjacency structure of the graph associated with the
+   inputted finite element mesh, from which the node-numbering scheme (OPTFLAG = 2) and,
+   if pjpart is not NULL, the subdomains of the joints are determined. */
+int graph (long *pjnt, long *pxadj, long *pjcode, int *pwrpres, long *pminc, long *pjinc,
+    long *pjincloc, long *pjpart);
+
+/* This function provides the optimum node-numbering scheme, with respect to minimization
+   of the bandwidth of the stiffness array; it follows the procedure outlined by Collins
+   (1973) */
+int optnum (long *pjnt, long *padjncy, long *pxadj, int *pflag);
+
+/* This function partitions the graph of the joints into one subdomain per MPI rank by
+   recursive bisection of its level structure, weighting the joints by their free DOFs;
+   pjpart holds the rank of each joint */
+int ddpart (long *pjpart, long *padjncy, long *pxadj, long *pjcode);
+
+/* This function updates all previously defined joint-dependent variables so that they
+   reflect the optimum node-numbering scheme determined from optnum() */
+int updatenum (long *pjcode, long *pminc, int *pwrpres,  long *pjnt);
+
+/* This function generates joint code, jcode, by assigning integers in sequence, by
+   columns, to all nonzero elements of jcode from 1 to neq and generates the member code,
+   mcode, by transferring, via minc, columns of jcode into columns of mcode; it follows
+   procedure in Chapter 6 of Bathe and Wilson as well as Chapter 6 of Holzer */
+void codes (long *pmcode, long *pjcode, long *pminc, int *pwrpres);
+
+/* This function reads in: (1) the magnitude (mag) and the direction (dir) of the
+   concentrated force, and the joint (jt) on which it is applied AND / OR (2) the
+   magnitude (mag) and the direction (dir) of the distributed force, and the frame
+   element (fr) on which it is applied */
+int load (double *pq, double *pefFE_ref, double *px, double *pllength, double *poffset,
+		  int *posflag, double *pc1, double *pc2, double *pc3, long *pjnt, long *pmcode, long *pjcode, 
+		  long *pminc, double *ptinpt, long *ppinpt_h, double *ppinpt, long *ppdisp_h, double *ppdisp, double *pum,
+		  double *pvm, double *pam);
+
+/* This function determines kht using mcode and the boundary maps of the substructure
+   instances, and determines maxa from kht */
+int skylin (long *pmaxa, long *pmcode, long *plss, long *pjcode, long *pkht, long *ppmot,
+            long *psup, long *psupmap);
+
+/* This function overrides the element properties given by the overrides of a variant of a
+   parameter sweep (see sweep.c), and checks its joint load overrides */
+int ovrprop (long nov, long *povk, double *povv, double *pemod, double *pgmod, double *pnu,
+             double *pcarea, double *pthick, double *pdens, double *pyield, double *pistrong,
+             double *piweak, double *pipolar, double *piwarp, double *pzstrong, double *pzweak);
+
+/* This function overrides the joint loads given by the overrides of a variant of a
+   parameter sweep, once checked by ovrprop */
+void ovrload (long nov, long *povk, double *povv, double *pq, long *pjnt, long *pjcode);
+
+/*
+super.c
+*/
+
+/* Layout of the entries of a substructure instance in the instance array; the instances
+   which repeat a substructure share the local skyline equations and the condensed
+   stiffness matrix of the instance which defines it */
+#define SUP_TR 0 // First truss element (0-based)
+#define SUP_NTR 1 // Number of truss elements
+#define SUP_FR 2 // First frame element
+#define SUP_NFR 3 // Number of frame elements
+#define SUP_SH 4 // First shell element
+#define SUP_NSH 5 // Number of shell elements
+#define SUP_MST 6 // Instance which defines the substructure
+#define SUP_INT 7 // First interior equation, counted after the NEQ equations of the structure
+#define SUP_NINT 8 // Number of interior equations
+#define SUP_NBND 9 // Number of boundary DOFs
+#define SUP_MAP 10 // Offset of the boundary map in the map array
+#define SUP_LOC 11 // First equation of the substructure on the local skyline
+#define SUP_VAL 12 // Offset of the condensed stiffness matrix in the value array
+#define SUPLEN 13 // Length of the entries of an instance
+
+/* This function reads in the element ranges and substructure numbers of the substructure
+   instances, and finds the instance which defines each substructure */
+int superin (long *psup);
+
+/* This function numbers the interior equations of the instances after the NEQ equations of
+   the structure, renumbering jcode and mcode, and generates the boundary maps of the
+   instances, the local mcode of the substructures and their local skyline, maxal */
+int supercodes (long *psup, long *psupmap, long *pmcode, long *pmcodeg, long *pmcodel,
+    long *pmaxal, long *pjcode, long *pminc, int *pwrpres, long *plssl, long *plsupv);
+
+// This function returns 1 if a and b agree to within 1e-9 times c
+int supereq (double a, double b, double c);
+
+/* This function checks that each instance repeats the geometry, up to a translation, and
+   the properties of the instance which defines its substructure */
+int superchk (long *psup, long *pminc, double *px, double *pemod, double *pgmod,
+    double *pnu, double *pcarea, double *pthick, double *pistrong, double *piweak,
+    double *pipolar, double *piwarp, double *poffset, int *posflag, int *pmendrel,
+    double *pc1, double *pc2, double *pc3);
+
+/* This function factorizes the interior stiffness of each substructure on the local
+   skyline with skyfact and condenses its stiffness matrix onto the boundary DOFs, or reads
+   both from the cache file super_<hash>.bin keyed on the substructure stiffness matrix */
+int supercond (long *psup, long *pmaxal, double *pssl, double *psupv);
+
+/* This function adds the condensed stiffness matrices of the instances to the structure
+   stiffness matrix and condenses the loads on their interior DOFs onto the boundary DOFs */
+int superasm (double *pss, double *pq, long *pmaxa, long *psup, long *psupmap,
+    long *pmaxal, double *pssl, double *psupv);
+
+/* This function recovers the displacements of the interior DOFs of the instances from the
+   displacements of the structure */
+int superrec (double *pd, double *pq, long *psup, long *psupmap, long *pmaxal, double *pssl);
+
+/*
+truss.c
+*/
+
+/* This function reads and echoes truss element properties, as well as computing element
+   lengths and direction cosines */
+void prop_tr (double *px, double *pemod, double *pcarea, double *pdens, double *pllength,
+              double *pyield, double *pc1, double *pc2, double *pc3, long *pminc);
+
+/* This function computes the contribution to the generalized stiffness matrix from the
+   truss elements and stores it as an array */
+void stiff_tr (double *pss, double *pemod, double *pcarea, double *plength,
+    double *pdefllen_ip, double *pyield, double *pc1_ip, double *pc2_ip, double *pc3_ip,
+    double *pef_ip, long *pmaxa, long *pmcode);
+
+// This function adds contribution of material nonlinearity to element stiffness matrix
+void stiffm_tr (double *pk_tr, double *pef_ip, double *pPy, long n);
+
+/* This function computes the contribution to the generalized internal force vector from
+   the truss elements and truss element internal force vectors */
+void forces_tr (double *pf_temp, double *pef_i, double *pd, double *pemod,
+    double *pcarea, double *pllength, double *pdefllen_i, double *pyield, double *pc1_i,
+    double *pc2_i, double *pc3_i, long *pmcode);
+
+/* This function computes the contribution to the generalized mass matrix from the
+   truss elements and stores it as an array */
+void mass_tr (double *psm, double *pcarea, double *pllength, double *pdens, double *px, 
+         long *pminc, long *pmcode, long *pmaxa, double *pjac);
+
+/*
+frame.c
+*/
+
+/* This function reads and echoes frame element properties, as well as computing element
+   lengths and direction cosines */
+void prop_fr (double *px, double *pxfr, double *pemod, double *pgmod, double *pdens, double *poffset,
+              int *posflag, double *pauxpt, double *pcarea, double *pllength, double *pistrong,
+              double *piweak, double *pipolar, double *piwarp, double *pyield, double *pzstrong,
+              double *pzweak, double *pc1, double *pc2, double *pc3, int *pmendrel, long *pminc);
+
+/* This function computes the contribution to the generalized stiffness matrix from the
+   frame elements and stores it as an array */
+void stiff_fr (double *pss, double *pemod, double *pgmod, double *pcarea,
+    double *poffset, int *posflag, double *pllength, double *pdefllen_ip,
+    double *pistrong, double *piweak, double *pipolar, double *piwarp, int *pyldflag,
+    double *pyield, double *pzstrong, double *pzweak, double *pc1_ip, double *pc2_ip,
+    double *pc3_ip, double *pef_ip, double *pefFE_ip, int *pmendrel, long *pmaxa,
+    long *pmcode);
+
+// This function assigns non-zero elements of linear-elastic element stiffness matrix
+void stiffe_fr (double *pk_fr, double *pemod, double *pgmod, double *pcarea,
+    double *plength, double *pistrong, double *piweak, double *pipolar, double *piwarp,
+    long n);
+
+// This function adds contribution of geometric nonlinearity to element stiffness matrix
+void stiffg_fr (double *pk_fr, double *peftot_ip, double *pdefllen_ip, double *pcarea,
+    double *pipolar, long n);
+
+// This function adds contribution of material nonlinearity to element stiffness matrix
+void stiffm_fr (double *pk_fr, double *peftot_ip, int *pyldflag, double *pyield,
+    double *pcarea, double *pzstrong, double *pzweak, long n);
+
+/* This function modifies the frame element stiffness matrix to account for member end
+   releases associated with bending degrees of freedom; this algorithm is similar to that
+   implemented for the computation of the plastic reduction matrix */
+void release (double *pk_fr, int *pmendrel, int n);
+
+/* This function computes the contribution to the generalized internal force vector from
+   the frame elements and frame element internal force vectors */
+int forces_fr (double *pf_temp, double *pef_ip, double *pef_i, double *pefFE_ref,
+    double *pefFE_ip, double *pefFE_i, int *pyldflag, double *pdd, double *pemod,
+    double *pgmod, double *pcarea, double *poffset, int *posflag, double *pllength,
+    double *pdefllen_ip, double *pistrong, double *piweak, double *pipolar,
+    double *piwarp, double *pyield, double *pzstrong, double *pzweak, double *pc1_ip,
+    double *pc2_ip, double *pc3_ip, double *pc1_i, double *pc2_i, double *pc3_i,
+    int *pmendrel, long *pmcode, double *pdlpf, int *pitecnt);
+
+/* This function computes the contribution to the generalized mass matrix from the
+    frame elements and stores it as an array */
+void mass_fr (double *psm, double *pcarea, double *pllength, double *pistrong, double *piweak, 
+              double *pipolar, double *piwarp, double *pdens, int *posflag, double *poffset, 
+              double *px, double *pxfr, long *pminc, long *pmcode, long *pmaxa, double *pjac);
+
+/* This function, referred to as the "method of false position" or "regula falsi"
+   (McGuire, Gallagher, and Ziemian, p. 356), computes the scalar multiplier to be
+   applied to the current increment in force, such that the yield function to equal one,
+   within a specified tolerance */
+double regula_falsi (double *pp, double *pdp, double *pmy, double *pdmy, double *pmz,
+    double *pdmz);
+
+/* This function checks for the presence of unloading at hinges and returns appropriate
+   flag for analysis to continue */
+int unload (double *pphi, double *pp, double *pmy, double *pmz, double *pPy,
+    double *pMpy, double *pMpz, double *pk_fr, double *pdd, long n);
+
+/*
+shell.c
+*/
+
+/* This function reads and echoes shell element properties, as well as computing element
+   side-lengths, face-areas, and direction cosines */
+void prop_sh (double *px, double *pemod, double *pnu, double *pxlocal, double *pthick,  double *pdens,
+    double *pfarea, double *pslength, double *pyield, double *pc1, double *pc2,
+    double *pc3, long *pminc);
+
+/* This function packs the constitutive coefficients and geometric properties of the shell
+   elements into the shell block */
+void pack_sh (double *pshb, double *pemod, double *pnu, double *pxlocal, double *pthick,
+    double *pfarea, double *pslength);
+
+/* This function packs the direction cosines and relative vertex coordinates of the shell
+   elements into the fields of the shell block starting at t (SH_T or SH_TP), and the
+   deformed face areas and side-lengths unless pdeffarea is NULL */
+void packc_sh (double *pshb, double *pdeffarea, double *pdefslen, double *px, double *pc1,
+    double *pc2, double *pc3, long *pminc, int t);
+
+/* This function computes the contribution to the generalized stiffness matrix from the
+   shell elements and stores it as an array */
+void stiff_sh (double *pss, double *pemod, double *pnu, double *px_temp, double *pxlocal,
+    double *pthick, double *pshb, double *pdeffarea_ip, double *pdefslen_ip,
+    double *pyield, double *pc1_ip, double *pc2_ip, double *pc3_ip, double *pef_ip,
+    double *pd_temp, double *pchi_temp, double *pefN_temp, double *pefM_temp, long *pmaxa,
+    long *pminc, long *pmcode);
+
+/* This function evaluates Ivanov's yield criteria at the vertices of shell element n and
+   returns the yielded vertex (0 if none), along with the factors used in its evaluation */
+int yield_sh (double *pyield, double *pthick, double *pchi_temp, double *pefN_temp,
+    double *pefM_temp, double *pNo, double *palpha, double *pMe, double *pNbar,
+    double *pMbar, double *pMNbar, double *pq_fact, double *pr_fact, double *ps_fact,
+    int *ph_fact, long ptr, long n);
+
+// This function stores the yielded vertex of every shell element in pyv
+void yldvtx_sh (int *pyv, double *pyield, double *pthick, double *pchi_temp,
+    double *pefN_temp, double *pefM_temp);
+
+/* This function assigns non-zero elements of linear-elastic element stiffness matrix for
+   the SHB elements of the batch pshb of the shell block; like the other batched shell
+   kernels, it stores the entries of the elements side by side, i.e. entry i of element
+   v at pk_sh[i * SHB + v] */
+void stiffe_sh (double *pk_sh, double *pshb);
+
+// This function evaluates the linear-elastic membrane stiffness matrices of a batch
+void stiffe_m_sh (double *pke_m_sh, double *pshb);
+
+/* This function employs an algorithm which explicitly evaluates the linear-elastic plate
+   bending stiffness matrix (i.e. no numerical integration is performed) by taking
+   advantage of the properties of the matrices involved in its evaluation. Details of the
+   algorithm are found in Batoz (1982). The matrices of the elements of a batch are
+   evaluated together. */
+void stiffe_b_sh (double *pke_b_sh, double *pshb);
+
+/* This function adds contribution of geometric nonlinearity to the element stiffness
+   matrices of a batch */
+void stiffg_sh (double *pk_sh, double *pshb, double *pdm);
+
+// This function assigns non-zero elements of elasto-plastic element stiffness matrix
+void stiffm_sh (double *pk_sh, double *pemod, double *pnu, double *pxlocal,
+    double *pthick, double *pdefffarea_ip, double *pdefslen_ip, double *pyield,
+    double *pefN_temp, double *pefM_temp, double *pchi_temp, int yv, double *pNo,
+    double *palpha, double *pMe, double *pNbar, double *pMbar, double *pMNbar,
+    double *pq_fact, double *pr_fact, double *ps_fact, int *ph_fact, long ptr,
+    long n);
+
+// This function evaluates the elasto-plastic membrane stiffness matrix
+void stiffm_m_sh (double *pkm_m_sh, double *pxlocal, double *pthick,
+    double *pdeffarea_ip, double *pC, double *pfn, double *pj_fact, double *pk_fact,
+    double *pB_fact, double *pdf_da, double *pda_dchi, long n);
+
+/* This function evaluates the elasto-plastic plate bending stiffness matrix, employing
+   a modified, but similar approach as in the stiff_b function */
+void stiffm_b_sh (double *pkm_b_sh, double *pxlocal, double *pthick,
+    double *pdeffarea_ip, double *pdefslen_ip, double *pC, double *pfm, double *pj_fact,
+    double *pk_fact, double *pB_fact, double *pdf_da, double *pda_dchi, long n);
+
+/* This function evaluates the coupled elasto-plastic stiffness matrix, employing a
+   modified, but similar approach as in the stiff_b and stiffm_b functions */
+void stiffm_mb_sh (double *pkm_mb_sh, double *pxlocal, double *pthick,
+    double *pdeffarea_ip, double *pdefslen_ip, double *pC, double *pfn, double *pfm,
+    double *pj_fact, double *pk_fact, double *pB_fact, double *pdf_da, double *pda_dchi,
+    long n);
+
+/* This function computes the contribution to the generalized mass matrix from the
+   shell elements and stores it as an array */
+void mass_sh (double *psm, double *pcarea, double *pdens, double *pthick,
+              double *pfarea, double *pslength, 
+              double *px, long *pminc, long *pmcode, long *pmaxa, double *pjac);
+
+/* This function computes the contribution to the generalized internal force vector from
+   the shell elements and shell element internal force vectors */
+int forces_sh (double *pf_temp, double *pef_ip, double *pef_i, double *pefN_temp,
+    double *pefM_temp, double *pdd, double *pd_temp, double *pchi_temp, double *px_temp,
+    double *px_ip, double *pemod, double *pnu, double *pxlocal, double *pthick,
+    double *pshb, double *pdeffarea_ip, double *pdefslen_ip, double *pyield,
+    double *pc1_ip, double *pc2_ip, double *pc3_ip, double *pc1_i, double *pc2_i,
+    double *pc3_i, long *pminc, long *pmcode, long *pjcode);
+
+/* This function computes the local membrane coordinates of the elements of a batch in the
+   configuration whose direction cosines start at field t (SH_T or SH_TP) */
+void mem_coord (double *pxlocal, double *pshb, int t);
+
+/* This function computes the total (elastic plus plastic) strain and curvature
+   increments of the elements of a batch */
+void strn_curv (double *pstrn, double *pcurv, double *pddm, double *pddb, double *pshb);
+
+/*
+ brick.c
+ */
+
+void prop_br (double *pemod, double *pnu, double *pyield, double *pdens, double *pfdens, double *pbmod,
+			  double *pfarea);
+
+void stiff_br (double *pss, double *px, double *pemod, double *pnu, long *pminc, 
+			   long *pmcode, long *pjcode, double *pJinv, double *pjac, long *pmaxa);
+
+void mass_br (double *psm, double *pdens, double *px, long *pminc, long *pmcode, long *pmaxa, double *pjac);
+
+void jacob (double *px, long *pminc, long *el, int *rval, int *sval, int *tval, double *pjac);
+
+/*
+ fsi.c
+ */
+
+void prop_fsi (double *px, double *pemod, double *pnu, double *pdens, double *pfdens, double *pbmod,
+			   double *pfarea, 
+			   double *pslength, double *pyield, long *pminc, long *pelface, long *pfsiinc, 
+			   double *pnnorm, double *ptarea, double *pss, double *pss_fsi, double *psd_fsi, double *pabspt,
+			   double *pnorpt, long *pmcode, long *pjcode);
+
+void stiff_fsi (long *pminc, long *pmcode, long *pjcode, double *pnnorm, double *ptarea, double *pthick, 
+				double *pshb, double *pdeffarea, double *pdefslen, double *pss, double *pss_fsi, 
+				double *px, double *pxlocal, double *pemod, double *pnu, double *pJinv, double *pjac, double *pyield, 
+				double *pc1, double *pc2, double *pc3, double *pef, double *pd, double *pchi, double *pefN, double *pefM, long *pmaxa);
+
+void mass_fsi (long *pminc, long *pmcode, long *pjcode, double *pnnorm, double *ptarea, double *pcarea, double *pfarea, 
+               double *pthick, double *pslength, double *psm, double *psm_fsi, double *px, 
+               double *pdens, double *pfdens, double *pJinv, double *pjac, long *pmaxa);
+
+/* This function builds the coupling matrix L = G*A from the joints of the f-s faces and holds its
+   nonzero entries by wet fluid DOF; it returns 1 if memory cannot be allocated */
+int L_br (long *pelface, long *pfsiinc, long *pjcode_fsi, double *pnnorm, double *ptarea, double *pfdens);
+
+int load_fsi (long *pjcode_fsi, double *ptinpt, long *ppinpt_h, double *ppinpt, long *ppres_h, double *ppresinpt,
+			  long *pacc_h, double *paccinpt, double *pfdens, double *pum, double *pvm, double *pam);
+
+// This function counts the DOFs of the FSI load array which are coupled to an input load history
+long nq_fsi (long *ppinpt_h, long *ppres_h, long *pacc_h);
+
+// This function returns 1 if DOF i of the FSI load array is coupled to an input load history
+int qrow_fsi (long i, long *ppinpt_h, long *ppres_h, long *pacc_h);
+
+/* This function interpolates the input load histories onto the actual time steps and
+   stores the resulting FSI load array as a load history */
+int q_fsi (long *pjcode_fsi, long *pqdyn_h, double *pqdyn, double *ptstps, double *pfdens,
+		   double *ptinpt, long *ppinpt_h, double *ppinpt, long *ppres_h, double *ppresinpt, long *pacc_h,
+		   double *paccinpt);
+
+// This function allocates the workspace of the partitioned and monolithic FSI solvers (SLVFLAG == 0)
+int fsicoup (void);
+
+// This function adds c times the fluid rows of the coupled mass matrix applied to u to r
+void fsimass (double *pu, double *pr, double c);
+
+/* This function counts (flag 0) or appends the coupling blocks L and -c0*rho*L^T of the FSI
+   effective stiffness matrix to the fluid (flag 1) or structure (flag 2) compressed columns
+   built by sparsefact */
+void fsicsc (int *pAp, int *pAi, double *pAx, double c0, int flag);
+
+/* This function solves the coupled FSI system by partitioned iterations between the structure
+   and the fluid, factorized as uncoupled blocks of the skyline, with interface quasi-Newton
+   (IQN-ILS) updates of the interface pressures */
+int fsisolve (long *pmaxa, double *pKeff, double *pReff, double *pum, double c0);
+
+/* This function computes the product y of the coupled FSI effective stiffness matrix with x
+   from the skyline stiffness, the diagonal mass and damping, and the coupling matrix; it
+   returns -1 if memory cannot be allocated */
+int fsiprod (long *pmaxa, double *pss, double *psm, double *psd, double *px, double *py, double c0, double a1);
+
+/* This function solves the coupled FSI system by restarted GMRES, preconditioned by the skyline
+   factorization of the uncoupled structure and fluid blocks (SLVFLAG == 4); it returns -1 if
+   memory cannot be allocated */
+int fsigmres (long *pmaxa, double *pss, double *psm, double *psd, double *pKeff, double *pReff, double *pum,
+			  double c0, double a1);
+
+/* This function computes the harmonic response of the coupled FSI system to the load amplitudes
+   over a frequency sweep (ALGFLAG == 6), solving the complex system K - w^2*M + i*w*C at the
+   frequencies in parallel by the skyline factorization zskyfact, and outputs the transfer
+   functions; it returns 1 if memory cannot be allocated */
+int harm_fsi (long *pmaxa, double *pss, double *psm, double *psd_fsi, long *pqdyn_h, double *pqdyn, long nfreq,
+			  double fmin, double fmax);
+
+// This function releases the workspace of the partitioned and monolithic FSI solvers
+void fsifree (void);
+
+/*
+solve.c
+*/
+
+/* This function determines the solution within the increment using the compact Gaussian
+   elimination strategy (Holzer pp. 290, 296, 307) and based on subroutine COLSOL -
+   "active column solution or the skyline (or column) reduction method"
+   (Bathe 1976, p. 257); it returns 1 if the workspace of a solver cannot be allocated */
+int solve (long *pjcode_fsi, double *pss, double *pss_fsi, double *psm, double *psm_fsi, double *psml, double *psd_fsi, double *pr, double *pdd, long *pmaxa, double *pssd, int *pdet,
+		   double *pum, double *pvm, double *pam, double *puc, double *pvc, double *pac, long *pqdyn_h, double *pqdyn,
+		   double *pKeff, double *pReff, double *pMeff, double *pab, int *pAp, int *pAi, double *pAx, double alpham, double alphaf, int *pipiv, int fact, double ddt, long *ppdisp_h, double *ppdisp, long *ppart, int *piter, int *pii, int *pij, int tstp);
+
+/* This function performs LDL^t factorization of the stiffness matrix when using SLVFLAG == 0*/
+int skyfact (long *pmaxa, double *pss_temp, double *pssd, double *pdd, int fact, int *pdet);
+
+/*This function solves for x in Ax=b*/
+int skysolve (long *pmaxa, double *pss, double *pssd, double *pdd, int fact, int *pdet);
+
+/* This function solves for x in Ax=b restricted to the equations lo to hi-1 of a factorized
+   skyline matrix which is block diagonal about them */
+int skyrange (long *pmaxa, double *pss_temp, double *pdd, long lo, long hi);
+
+/* This function performs the LDL^t factorization of a complex symmetric skyline matrix with
+   interleaved real and imaginary parts, for neq equations; it returns 1 if a pivot is zero */
+int zskyfact (long neq, long *pmaxa, double *pa);
+
+/* This function solves for the complex x in Ax=b with the factorization computed by zskyfact */
+void zskysolve (long neq, long *pmaxa, double *pa, double *pv);
+
+/* This function copies the skyline matrix into single precision and performs its LDL^t
+   factorization when MPFLAG == 1; it returns 1 on success, 0 if the double precision
+   factorization is to be used instead, and -1 if memory cannot be allocated */
+int mixfact (long *pmaxa, double *pss, double *pssd, int *pdet);
+
+/* This function solves for x in Ax=b with the factorization computed by mixfact and iterative
+   refinement against the double precision matrix; if the refinement stalls, it factorizes
+   the double precision matrix and returns 0 (-1 if memory cannot be allocated) */
+int mixsolve (long *pmaxa, double *pss, double *pssd, double *pdd, int *pdet);
+
+// This function registers the element equations and yield states read by lrfact
+void lrelem (long *pmcode, int *pyldflag, int *pyv);
+
+/* This function keeps the skyline factorization of the tangent stiffness matrix in pKeff when
+   LRMAX > 0 and represents the changes of the matrix since then as a low-rank update over the
+   equations of the frame and shell elements whose yield state changed; the matrix is
+   refactorized when the rank of the update would exceed LRMAX. It returns 1 if the system is to
+   be solved by lrsolve, 0 if the skyline factorization is to be used instead */
+int lrfact (long *pmaxa, double *pss, double *pKeff, double *pssd, int *pdet);
+
+/* This function factorizes the tangent stiffness matrix into pKeff as the reference of the
+   low-rank updates */
+void lrref (long *pmaxa, double *pss, double *pKeff, double *pssd, int *pdet);
+
+/* This function solves for x in Mx=b, where M is the factorization kept by lrfact with its
+   low-rank update applied by the Woodbury formula */
+int lrprec (long *pmaxa, double *pKeff, double *pssd, double *pdd);
+
+/* This function solves for x in Ax=b by conjugate gradients preconditioned by lrprec; if the
+   iterations do not converge, the matrix is refactorized and solved directly. It returns 1,
+   or -1 if memory cannot be allocated */
+int lrsolve (long *pmaxa, double *pss, double *pKeff, double *pssd, double *pdd, int *pdet);
+
+/* This function solves for b in Ax=b with the skyline matrix, in a single multithreaded
+   sweep over the skyline (OpenMP) using a workspace kept between calls; it returns -1 if the
+   workspace cannot be allocated */
+int skymult (long *pmaxa, double *pss_temp, double *pdd);
+
+/* This function collects the skyline entries coupling the constrained DOFs to the remaining
+   DOFs, once per analysis, for use by matpart; it returns the number of entries */
+long matpartlist (long *pmaxa, long *ppmot, int *pii, int *pij, long *ppart);
+
+/*This function partitions matrix A into interior dofs and boundary dofs for solving systems with prescribed displacement boundary conditions*/
+int matpart (long *pmaxa, long *ppart, double *pss, double *pqtot, double *puc, int *pij);
+
+/* This function partitions a full order [NEQ][NEQ] matrix for prescribed displacement
+   boundary conditions, as matpart does for the skyline matrix (SLVFLAG == 1) */
+int matpartd (double *pss, double *pqtot, double *puc, int *pii, int *pij);
+
+/* This function compresses both triangles of the skyline matrix into the UMFPACK arrays, adding
+   the FSI coupling blocks for the dynamic effective stiffness (c0 != 0, the factor of the
+   coupling mass), and computes its sparse LU factorization; it returns the number of nonzero
+   entries */
+long sparsefact (long *pmaxa, double *pss, int *pAp, int *pAi, double *pAx, void **pNumeric, double c0);
+
+/* This function compresses the nonzero entries of the skyline matrix, i.e. its upper triangle,
+   into the CHOLMOD arrays and computes its sparse supernodal LL^t (or, for an indefinite
+   matrix, simplicial LDL^t) factorization with a fill-reducing ordering; the ordering is
+   reused while the pattern is unchanged. The inertia is returned as for skyfact; it returns
+   the number of nonzero entries, or -1 if memory cannot be allocated */
+long cholfact (long *pmaxa, double *pss, int *pAp, int *pAi, double *pAx, double *pssd, int *pdet);
+
+/* This function solves for x in Ax=b with the factorization computed by cholfact */
+int cholsolve (double *pdd);
+
+/* This function releases the CHOLMOD factorization and workspace */
+void cholfree (void);
+
+/* This function releases the factorizations and workspaces which the solver keeps between
+   calls, at the end of an analysis run through the library interface */
+void solvefree (void);
+
+/* This function copies the skyline matrix into LAPACK band storage and computes its Cholesky
+   factorization when a half-bandwidth BAND was selected in skylin; it returns 1 on success
+   and 0 if the skyline factorization is to be used instead */
+int bandfact (long *pmaxa, double *pss, double *pab, double *pssd, int *pdet);
+
+/* This function solves for x in Ax=b with the factorization computed by bandfact */
+int bandsolve (double *pab, double *pdd);
+
+/* This function sets up the domain decomposition of a static analysis over the MPI ranks
+   (DDFLAG = 1) from the subdomains pjpart of the joints: each element belongs to the rank
+   of its first joint, the equations shared by the elements of several ranks form the
+   interface, and the other equations the interiors of the ranks; pmcodeg receives the
+   member DOF code of the elements of this rank, which are the only ones it assembles. It
+   returns 1 if the decomposition is used, 0 if every rank is to assemble and solve the
+   complete system instead, and -1 if memory cannot be allocated */
+int ddcodes (long *pmcode, long *pmcodeg, long *pjpart, long *pminc);
+
+/* This function computes the LDL^t factorization of the interior stiffness of this rank in
+   the domain decomposition set up by ddcodes, on the skyline of the interior equations in
+   the skyline matrix assembled from the elements of this rank. It returns 1 on success, 0 if the decomposition is not used, and -1
+   if memory cannot be allocated, the interior stiffness is not positive definite, or the
+   interface problem is singular */
+int ddfact (long *pmaxa, double *pss, int *pdet);
+
+/* This function solves for the interior displacements pz of this rank in place with the
+   factorization of ddfact */
+void ddisolve (double *pz);
+
+/* This function computes the product of the interface problem (Schur complement) matrix of
+   the domain decomposition with an interface vector, summed over the MPI ranks */
+int ddmult (long *pmaxa, double *pss, double *pp, double *py, double *pz);
+
+/* This function forms the interface problem (Schur complement) matrix of the domain
+   decomposition on every MPI rank and factorizes it by LDL^t, for small interface problems
+   and those on which conjugate gradients fail; it returns 1, or -1 if memory cannot be
+   allocated or the matrix is singular */
+int ddschur (long *pmaxa, double *pss);
+
+/* This function solves for x in Ax=b by domain decomposition, with the interior
+   factorizations computed by ddfact and conjugate gradients on the interface problem, or
+   the factorization of ddschur; it returns 1, or -1 if memory cannot be allocated or the
+   interface problem is singular */
+int ddsolve (long *pmaxa, double *pss, double *pssd, double *pdd, int *pdet);
+
+/* This function factorizes a full order [NEQ][NEQ] matrix (SLVFLAG == 1) by Cholesky
+   decomposition if it is symmetric positive definite, by LDL^t decomposition returning its
+   inertia if it is symmetric indefinite, and by LU decomposition otherwise; it returns the
+   type of factorization (0 - LU, 1 - Cholesky, 2 - LDL^t), or -1 if memory cannot be
+   allocated */
+int lapfact (double *pss, int *pipiv, double *pssd, int *pdet);
+
+/* This function solves for x in Ax=b with the factorization computed by lapfact */
+int lapsolve (double *pss, int *pipiv, double *pdd, int type);
+
+/* These functions apply the BFGS update of the inverse tangent stiffness matrix, held as
+   vector pairs, before and after the solution with the factorized matrix (Matthies and
+   Strang 1979) */
+void bfgsfwd (double *pr, double *ps, double *py, double *prho, double *palpha, int nbfgs,
+    int kbfgs, int mbfgs);
+void bfgsbwd (double *pdd, double *ps, double *py, double *prho, double *palpha, int nbfgs,
+    int kbfgs, int mbfgs);
+
+/* This function stores the vector pair of the last iteration for the BFGS update */
+int bfgsupd (double *ps, double *py, double *prho, double *pdd, double *pf_temp,
+    double *pf_ip, int *pnbfgs, int *pkbfgs, int mbfgs);
+
+/*
+arc.c
+*/
+
+/* This function reads in the MSAL parameters and checks that the prescribed initial
+   displacement does not correspond to a fixed degree of freedom */
+int msal (double *pdk, long *pdkdof, long *pjnt, long *pjcode);
+
+/* This function computes the roots of the quadratic equation, determines the correct
+   root, and updates nodal displacements and load proportionality factor */
+int quad (double *pa, double *pb, double *pc, double *pdt, double *pdp, double *pddr,
+    double *pddq, double *pdd, double *pdlpf, double *plpft);
+
+/*
+misc.c
+*/
+
+/* This function transforms the element stiffness matrix from local into global
+   coordinate system */
+void transform (double *pk, double *pT_ip, double *pK, int n);
+
+/* This function performs the same transformation for a block diagonal transformation
+   matrix made up of 3x3 blocks, e.g. for shell elements */
+void transform_bd (double *pk, double *pT, double *pK, int n);
+
+/* This function performs convergence check; assume that convergence is reached,
+   i.e. convchk = 0, until proven otherwise */
+int test (double *pd_temp, double *pdd, double *pf_temp, double *pfp, double *pqtot,
+    double *pf_ip, double *pintener1, int *pconvchk, double *ptoldisp, double *ptolfor,
+    double *ptolener);
+
+// This function updates element geometry
+void updatc (double *px_temp, double *px_ip, double *pxfr_temp, double *pdd,
+    double *pdefllen_i, double *pdeffarea_i, double *pdefslen_i, double *poffset,
+    int *posflag, double *pauxpt, double *pc1_i, double *pc2_i, double *pc3_i,
+    long *pminc, long *pjcode);
+
+// This function computes the dot product of two vectors
+double dot (double *pa, double *pb, int n);
+
+// This function computes the cross product of two vectors
+void cross (double *pa, double *pb, double *pc, int flag);
+
+// This function computes the inverse of a matrix through Gauss-Jordan elimination
+void inverse (double *pGT_k_G, int n);
+
+// This function outputs variables of interest to appropriate files
+void output (double *plpf, int *pitecnt, double *pd, double *pef, int flag);
+
+// This function closes the input and output files
+int closeio (int flag);
+
+// This function periodically backs up information for nonlinear dynamic analysis in the event of power outrages or hardware failures
+void checkPoint(long tstep, long lss, double *puc, double *pvc, double *pac, double *pss, double *pd,
+                double *pf, double *pef, double *px, double *pc1, double *pc2, double *pc3, double *pdefllen,
+                double *pllength, double *pefFE, double *pxfr, int *pyldflag, double *pdeffarea, double *pdefslen,
+                double *pchi, double *pefN, double *pefM);
+
+// The function restores the last saved data before power outrages or hardware failures
+void restartStep(long lss, double *puc, double *pvc, double *pac, double *pss, double *pd,
+                 double *pf, double *pef, double *px, double *pc1, double *pc2, double *pc3, double *pdefllen,
+                 double *pllength, double *pefFE, double *pxfr, int *pyldflag, double *pdeffarea, double *pdefslen,
+                 double *pchi, double *pefN, double *pefM);
+
+/*
+history.c
+*/
+
+/* This function counts the DOFs subjected to a dynamic load history without consuming
+   the input; the rows are returned in pnrow (applied forces and nonzero displacements, or
+   solid forces and fluid pressures / accelerations for FSI analysis) */
+int histscan (long *pjcode, long *pnrow);
+
+// This function returns the length of the index array of a load history
+long histlen (long ndof, long nrow);
+
+// This function returns the length of the value array of a load history
+long histvlen (long nrow, long nstep, long nwin);
+
+/* This function initializes an empty load history of nrow loaded DOFs over nstep time
+   steps; if nwin > 0, only nwin time steps are held in memory and the remainder is
+   streamed from a scratch file */
+int histinit (long *ph, double *pv, long ndof, long nrow, long nstep, long nwin);
+
+// This function stores the value of the load history on DOF dof at time step step
+int histput (long *ph, double *pv, long dof, long step, double val);
+
+// This function reads a window of time steps of a streamed load history from disk
+int histwin (long *ph, double *pv, long step);
+
+/* This function returns the value of the load history on DOF dof at time step step; if the
+   window holding it cannot be read, it returns zero and histfail reports the failure */
+double histval (long *ph, double *pv, long dof, long step);
+
+/* This function returns 1 once a window of a streamed load history could not be read, and 0
+   otherwise */
+int histfail (long *ph);
+
+// This function returns the row (plus one) of DOF dof, or zero if the DOF is not loaded
+long histrow (long *ph, long dof);
+
+// This function returns the number of loaded DOFs in a load history
+long histrows (long *ph);
+
+// This function returns the DOF of row row of a load history
+long histdof (long *ph, long row);
+
+// This function closes the scratch files of streamed load histories
+void histclose (void);
+
+/*
+amg.c
+*/
+
+/* This function computes the rigid body modes of the joints, the near-nullspace of the
+   stiffness matrix, for the multigrid preconditioner (ITFLAG == 1) */
+int amgmodes (double *px, long *pjcode);
+
+/* This function aggregates the nn nodes of a level of the multigrid hierarchy, whose DOFs
+   are given by pnod, by their strong couplings; it returns the number of aggregates */
+long amgaggr (long n, long *pap, long *pai, double *pax, long *pnod, long nn, long *pagg);
+
+// This function returns the diagonal entry of row i of a matrix in compressed row storage
+double amgdiag (long *pap, long *pai, double *pax, long i);
+
+/* This function computes the product of two sparse matrices in compressed row storage; it
+   returns the number of nonzero entries */
+long amgmatmul (long n, long nc, long *pap, long *pai, double *pax, long *pbp, long *pbi,
+    double *pbx, long **ppcp, long **ppci, double **ppcx);
+
+// This function computes the transpose of a sparse matrix in compressed row storage
+long amgtrans (long n, long nc, long *pap, long *pai, double *pax, long **pptp, long **ppti,
+    double **pptx);
+
+/* This function builds the smoothed aggregation multigrid hierarchy of the skyline matrix
+   when ITFLAG == 1; it returns 1 on success, 0 if the skyline factorization is to be
+   used instead, and -1 if memory cannot be allocated */
+int amgfact (long *pmaxa, double *pss, int *pdet);
+
+// This function applies one multigrid V-cycle with Gauss-Seidel smoothing at level lev
+void amgcycle (int lev, double *pb, double *px);
+
+/* This function solves for x in Ax=b by conjugate gradients preconditioned by the multigrid
+   hierarchy built by amgfact; if the iterations fail to converge, it factorizes the skyline
+   matrix and returns 0 (-1 if memory cannot be allocated) */
+int amgsolve (long *pmaxa, double *pss, double *pssd, double *pdd, int *pdet);
+
+// This function releases the multigrid hierarchy
+void amgfree (void);
+
+// This function releases the near null space modes set up by amgmodes
+void amgmodesfree (void);
+
+/*
+memory.c
+*/
+
+// This function allocates memory for an array of type int
+int * alloc_int (long arraylen);
+
+// This function allocates memory for an array of type long
+long * alloc_long (long arraylen);
+
+// This function allocates memory for an array of type double
+double * alloc_dbl (long arraylen);
+
+/* This function allocates memory for an array of type double aligned to 64 bytes, which is
+   freed as one allocated by alloc_dbl */
+double * alloc_dbl_al (long arraylen);
+
+// This function allocates memory for an array of type float
+float * alloc_flt (long arraylen);
+
+/* This function maps an array of type double to a scratch file on disk (out-of-core
+   storage) */
+double * map_dbl (long arraylen);
+
+// This function reads ahead entries first to last of an array mapped by map_dbl
+void map_prefetch (double *a, long first, long last);
+
+// This function frees an array of type double allocated by alloc_dbl or map_dbl
+void free_dbl (double *a);
+
+// This function frees all allocated memory
+int free_all (int **pp2p2i, int ni, long **pp2p2l, int nl, double **pp2p2d, int nd,
+    int flag);
+
+/*
+library.c
+*/
+
+/* This function creates a model for the library interface from the text of an input file
+   (model_def.txt format) of length len; it returns NULL if memory is not available */
+BENMODEL * ben_create (const char *text, size_t len);
+
+/* This function analyzes the model on a thread of its own, so that models can be analyzed
+   concurrently from separate threads; it returns 0 if the solution was successful */
+int ben_run (BENMODEL *pbm);
+
+/* This function returns the contents of output file results<i>.txt (1 <= i <= 7) of an
+   analyzed model, and its length in plen if not NULL; it returns NULL if not available */
+const char * ben_result (BENMODEL *pbm, int i, size_t *plen);
+
+/* This function analyzes a model on the thread started by ben_run and releases the arrays
+   which the solver keeps in the model state of the thread */
+void * benthread (void *arg);
+
+/* This function returns the statistics of an analyzed model (stats.json format), and
+   their length in plen if not NULL; it returns NULL if not available */
+const char * ben_stats (BENMODEL *pbm, size_t *plen);
+
+// This function frees a model created by ben_create
+void ben_free (BENMODEL *pbm);
+
+/*
+sweep.c
+*/
+
+/* This function analyzes the variants of a parameter sweep, taking them in turn until all
+   are analyzed, on each thread of the pool */
+void * sweepthread (void *arg);
+
+/* This function writes out the results of variant k of a parameter sweep to results1_k.txt
+   to results7_k.txt, and its statistics to stats_k.json; it returns 1 if a file could not be
+   written */
+int sweepwrite (BENMODEL *pbm, long k);
+
+/*
+stats.c
+*/
+
+/* This function starts the statistics of the analysis of the model held by pbm (NULL for
+   model_def.txt) */
+void statinit (BENMODEL *pbm);
+
+// This function returns the wall time in seconds
+double statclock (void);
+
+// This function returns the peak memory of the process in kB
+long statmem (void);
+
+// This function returns the number of bytes written to the output files
+long statbyte (void);
+
+// This function starts a call of phase ph
+void statbeg (int ph);
+
+// This function ends a call of phase ph, which performed about flops operations
+void statend (int ph, double flops);
+
+/* This function estimates the operations of the skyline factorization (type = 0) or of the
+   reduction and back-substitution (type = 1) */
+double statsky (long *pmaxa, int type);
+
+/* This function records the running totals at the end of the load increment or time step
+   of load proportionality factor or time val */
+void statstep (double val);
+
+/* This function writes out the statistics to stats.json, or to the model handle; flag = 1
+   if the solution failed */
+void statwrite (int flag);
@@ -1,824 +1,3155 @@
-//********************************************************************************
-//**                                                                            **
-//**  Pertains to CU-BEN ver 4.0                                                **
-//**                                                                            **
-//**  CU-BENs: a ship hull modeling finite element library                      **
-//**  Copyright (c) 2019 C. J. Earls                                            **
-//**  Developed by C. J. Earls, Cornell University                              **
-//**  All rights reserved.                                                      **
-//**                                                                            **
-//**  Contributors:                                                             **
-//**    Christopher Stull                                                       **
-//**    Heather Reed                                                            **
-//**    Justyna Kosianka                                                        **
-//**    Wensi Wu                                                                **
-//**                                                                            **
-//**  This program is free software: you can redistribute it and/or modify it   **
-//**  under the terms of the GNU General Public License as published by the     **
-//**  Free Software Foundation, either version 3 of the License, or (at your    **
-//**  option) any later version.                                                **
-//**                                                                            **
-//**  This program is distributed in the hope that it will be useful, but       **
-//**  WITHOUT ANY WARRANTY; without even the implied warranty of                **
-//**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General  **
-//**  Public License for more details.                                          **
-//**                                                                            **
-//**  You should have received a copy of the GNU General Public License along   **
-//**  with this program. If not, see <https://www.gnu.org/licenses/>.           **
-//**                                                                            **
-//********************************************************************************
-
-
-#include <stdio.h>
-#include <math.h>
-#include <stdlib.h>
-#include "prototypes.h"
-
-// CLAPACK header files
-#if defined(__APPLE__)
-#  include <Accelerate/Accelerate.h>
-#endif
-
-//UMFPACK header files
-#include "umfpack.h"
-
-extern long NJ, SNDOF, FNDOF, NEQ, NBC, NTSTPS, NE_SBR, NE_FBR;
-extern double dt, ttot;
-extern int ANAFLAG, ALGFLAG, SLVFLAG, FSIFLAG, brFSI_FLAG, shFSI_FLAG, CHKPT, RFLAG;
-extern FILE *IFP[4], *OFP[8];
-
-
-int solve (long *pjcode, double *pss, double *pss_fsi, double *psm, double *psm_fsi, double *psd_fsi, double *pr, double *pdd, long *pmaxa, double *pssd, int *pdet,
-           double *pum, double *pvm, double *pam, double *puc, double *pvc, double *pac, double *pqdyn, double *ptstps,
-           double *pKeff, double *pReff, double *pMeff, int *pAp, int *pAi, double *pAx, double alpham, double alphaf, int *pipiv, int fact, double ddt, double *ppdisp, long *pkht, int *piter, int *pii, int *pij, int tstp)
-{
-    
-    // Initialize function variables
-    long i, j, k;
-    int err, dum = 0;
-    char trans = 'N';
-    double time, sum = 0;
-    double a0, a1, a2, a3, a4, a5, a6, a7;
-    double alpha, delta;
-    double dt_temp;// Variable for time stepping scheme
-    
-    // Initialize CLAPACK variables
-    int m, n, lda, ldb, info, nrhs = 1;
-    
-    m = n = lda = ldb = NEQ;
-    
-    // Initialize UMFPACK sparse solver variables
-    *(pAp) = 0;
-    long nz = 0;
-    
-    double *null = (double *) NULL;
-    void *Symbolic, *Numeric;
-    
-    // Pass residual array to the incremental displacements array
-    for (i = 0; i < NEQ; ++i) {
-        *(pdd+i) = *(pr+i);
-    }
-    
-    // Static analysis
-    if (ALGFLAG < 4) {
-        
-        // Skyline solver for structural elements
-        if (SLVFLAG == 0) {
-            skyfact(pmaxa, pss, pssd, pdd, fact, pdet);
-            err = skysolve (pmaxa, pss, pssd, pdd, fact, pdet);
-        }
-        
-        // CLAPACK direct solver
-        else if (SLVFLAG == 1) {
-            
-            // Call LAPACK routine for solving general matrices
-            dgesv_(&n, &nrhs, pss, &lda, pipiv, pr, &ldb, &info);
-            
-            // Set displacements from CLAPACK to dd array
-            for (i = 0; i < NEQ; ++i) {
-                *(pdd+i) = *(pr+i);
-            }
-            
-            // Pass control to output function
-            output (pr, &dum, pdd, puc, 1);
-        }
-        
-        // UMFPACK iterative solver
-        else if (SLVFLAG == 2) { // SLVFLAG == 1;
-            
-            // Calculate arrays for sparse solver
-            for (i = 0; i < NEQ; ++i) {
-                for (j = 0; j < NEQ; ++j) {
-                    if (fabs(*(pss+i*NEQ+j)) > 1e-10) {
-                        *(pAp+i+1) = nz + 1;
-                        *(pAi+nz) = j;
-                        *(pAx+nz) = *(pss+i*NEQ+j);
-                        nz = nz + 1;
-                    }
-                }
-            }
-            
-            // Sparse solver function initializations
-            (void) umfpack_di_symbolic (n, n, pAp, pAi, pAx, &Symbolic, null, null);
-            (void) umfpack_di_numeric (pAp, pAi, pAx, Symbolic, &Numeric, null, null);
-            umfpack_di_free_symbolic (&Symbolic) ;
-            
-            // Solve system of equations for displacement vector uc
-            (void) umfpack_di_solve (UMFPACK_A, pAp, pAi, pAx, puc, pr, Numeric, null, null);
-            
-            for (i = 0; i < NEQ; ++i){
-                fprintf(OFP[5],"%lf\t",*(puc+i));
-            }
-            fprintf(OFP[5],"\n");
-            
-            umfpack_di_free_numeric (&Numeric);
-        }
-    }
-    
-    // Dynamic analysis
-    else if (ALGFLAG > 3) {
-        
-        // Initialize effective stiffness matrix to zero
-        if (SLVFLAG == 1) {
-            for (i = 0; i < NEQ; ++i) {
-                for (j = 0; j < NEQ; ++j) {
-                    *(pKeff+i*NEQ+j) = 0;
-                }
-            }
-        }
-        else if (SLVFLAG == 0) {
-            for (i = 0; i < *(pmaxa+NEQ)-1; ++i) {
-                *(pKeff+i) = 0;
-            }
-        }
-        
-        // Add masses to nodes subjected to nonzero displacement boundary conditions
-        if (NBC != 0 && SLVFLAG == 0){
-            for (i = 0; i < NEQ; ++i) {
-                if ((*(ppdisp+i*NTSTPS+tstp)) != 0) {
-                    *(psm+i) = 1000000 * (*(psm+i));
-                }
-            }
-        } else if (NBC != 0 && SLVFLAG == 1) {
-            for (i = 0; i < NEQ; ++i) {
-                for (j = 0; j < NEQ; ++j) {
-                    if ((*(ppdisp+i*NTSTPS+tstp)) != 0) {
-                        *(psm+i) = 1000000 * (*(psm+i*NEQ+j));
-                    }
-                }
-            }
-        }
-        
-        alpha = pow(1-alpham+alphaf, 2)/4;
-        delta = 0.5-alpham+alphaf;
-        dt_temp = ddt * dt;
-        
-        // Calculate integration constants
-        a0 = 1/(alpha*pow(dt_temp,2));
-        a1 = delta/(alpha*dt_temp);
-        a2 = 1/(alpha*dt_temp);
-        a3 = 1/(2*alpha) - 1;
-        a4 = delta/alpha - 1;
-        a5 = (dt_temp)/2*(delta/alpha - 2);
-        a6 = (dt_temp)*(1-delta);
-        a7 = delta*(dt_temp);
-        
-        /* Calculate effective stiffness matrix */
-        if (ANAFLAG == 4) { // FSI analysis, cannot use skyline
-            for (i = 0; i < NEQ; ++i) {
-                for (j = 0; j < NEQ; ++j) {
-                    if (i != j) {
-                        *(pKeff+j*NEQ+i) = (*(pss_fsi+i*NEQ+j))+a0*(1-alpham)*(*(psm_fsi+i*NEQ+j))/(1-alphaf);
-                    }
-                    else {
-                        *(pKeff+j*NEQ+i) = (*(pss_fsi+i*NEQ+j))+a0*(1-alpham)*(*(psm_fsi+i*NEQ+j))/(1-alphaf)+a1*(*(psd_fsi+i));
-                    }
-                }
-            }
-        }
-        else if (ANAFLAG != 4) { // Non-FSI analysis
-            if (SLVFLAG == 0) { // using skyline function
-                for (i = 0; i < *(pmaxa+NEQ)-1; ++i) {
-                    *(pKeff+i) = *(pss+i); // Initialize Keff w K
-                }
-                for (i = 0; i <  NEQ; ++i) { // Add mass to diagonal elements
-                    k = *(pmaxa+i);
-                    *(pKeff+k-1) += a0*(1-alpham)*(*(psm+i))/(1-alphaf);
-                }
-            }
-            else if (SLVFLAG == 1) { // using CLAPACK solver
-                for (i = 0; i < NEQ; ++i) {
-                    for (j = 0; j < NEQ; ++j) {
-                        *(pKeff+j*NEQ+i) = (*(pss+i*NEQ+j))+a0*(1-alpham)*(*(psm+i*NEQ+j))/(1-alphaf);
-                    }
-                }
-            }
-        }
-        
-        if (NBC == 0) {
-            // Factorize Keff
-            if (SLVFLAG == 0) {
-                skyfact(pmaxa, pKeff, pssd, pdd, fact, pdet);
-            }
-            else if (SLVFLAG == 1) {
-                dgetrf_(&m, &n, pKeff, &lda, pipiv, &info);
-            }
-            else if (SLVFLAG == 2) {
-               
-                // Calculate arrays for sparse solver
-                for (i = 0; i < NEQ; ++i) {
-                    for (j = 0; j < NEQ; ++j) {
-                        if (fabs(*(pKeff+i*NEQ+j)) > 1e-10) {
-                            *(pAp+i+1) = nz + 1;
-                            *(pAi+nz) = j;
-                            *(pAx+nz) = *(pKeff+i*NEQ+j);
-                            nz = nz + 1;
-                        }
-                    }
-                }
-
-                (void) umfpack_di_symbolic (n, n, pAp, pAi, pAx, &Symbolic, null, null);
-                (void) umfpack_di_numeric (pAp, pAi, pAx, Symbolic, &Numeric, null, null);
-                umfpack_di_free_symbolic (&Symbolic) ;
-            }
-        }
-        
-        if (ALGFLAG == 4){ // Dynamic: linear Newmark Intergration Method
-            
-            char CblasRowMajor, CblasNoTrans;
-            // Initialize a copy of effective stiffness matrix for nonzero displacement matrix computation
-            double *pKeffcp = alloc_dbl (*(pmaxa+NEQ)-1);
-            if (pKeffcp == NULL) {
-                // Pass control to closeio function
-                return closeio(1);
-            }
-            
-            char file[20];
-            
-            if (RFLAG == 1) {
-                // Open I/O for business!
-                do {
-                    IFP[3] = fopen("results8.txt", "r"); // Open last successful checkpoint file
-                } while (IFP[3] == 0);
-                
-                fscanf(IFP[3], "%d\n", &tstp);
-                
-                // Read in displacements, velocities, and accelerations from checkpoint file
-                for (i = 0; i < NEQ; ++i) {
-                    fscanf(IFP[3],  "%le,%le,%le\n", &pum[i], &pvm[i], &pam[i]);
-                }
-                
-                fscanf(IFP[3],  "%ld,%ld,%ld\n", &i, &j, &k);
-                
-                if (i == 0 && j == 0 && k == 0) {
-                    printf ("Read in displacements, velocities, and accelerations complete\n");
-                }
-                
-                if (tstp+1 == NTSTPS) {
-                    // Pass control to output function
-                    time = tstp*dt;
-                    output (&time, &dum, pum, pum, 1);
-                }
-                tstp = tstp+1;
-            }
-            
-            // Initialize current u, v, and a
-            for (i = 0; i < NEQ; ++i) {
-                *(puc+i) = *(pvc+i) = *(pac+i) = 0;
-            }
-            
-            // Loop through each time step to solve for displacements
-            for (k = tstp; k < NTSTPS; ++k) {
-                
-                // Initialize Meff and Reff for new time step to zero
-                // Update displacement vector
-                for (i = 0; i < NEQ; ++i) {
-                    *(pMeff+i) = 0;	*(pReff+i) = 0;
-                    *(pdd+i) = *(pum+i);
-                }
-                
-                // Calculate effective mass matrix
-                if (ANAFLAG == 4) { // FSI analysis, cannot use skyline
-                    for (i = 0; i < NEQ; ++i) {
-                        sum = 0;
-                        for (j = 0; j < NEQ; ++j) {
-                            sum += *(psm_fsi+i*NEQ+j)*((1-alpham)*((*(pum+j))*a0+(*(pvm+j))*a2+(*(pam+j))*a3)-alpham*(*(pam+j)))/(1-alphaf);
-                        }
-                        *(pMeff+i) = sum;
-                    }
-                }
-                else if (ANAFLAG != 4) { // Non-FSI analysis
-                    if (SLVFLAG == 0) { // using skyline function
-                        for (i = 0; i < NEQ; ++i) {
-                            *(pMeff+i) = *(psm+i)*((1-alpham)*((*(pum+i))*a0+(*(pvm+i))*a2+(*(pam+i))*a3)-alpham*(*(pam+i)))/(1-alphaf);
-                        }
-                    }
-                    else if (SLVFLAG == 1 || SLVFLAG == 2) { // using CLAPACK or UMFPACK solver
-                        for (i = 0; i < NEQ; ++i) {
-                            sum = 0;
-                            for (j = 0; j < NEQ; ++j) {
-                                sum += *(psm+i*NEQ+j)*((1-alpham)*((*(pum+j))*a0+(*(pvm+j))*a2+(*(pam+j))*a3)-alpham*(*(pam+j)))/(1-alphaf);
-                            }
-                            *(pMeff+i) = sum;
-                        }
-                    }
-                }
-                
-                // Calculate effective load vector
-                if (k == 0){ //First time step, cannot interpolate external force vectors
-                    for (i = 0; i < NEQ; ++i) {
-                        *(pReff+i) = (*(pqdyn+i*NTSTPS+k)) + *(pMeff+i);
-                    }
-                } else {
-                    for (i = 0; i < NEQ; ++i) {
-                        *(pReff+i) = (*(pqdyn+i*NTSTPS+k))+alphaf/(1-alphaf)*(*(pqdyn+i*NTSTPS+k-1))+ *(pMeff+i);
-                    }
-                }
-                
-                // Calculate effective damping vector (re-use Meff)
-                if (ANAFLAG == 4) {
-                    for (i = 0; i < NEQ; ++i) {
-                        *(pMeff+i) = *(psd_fsi+i)*((*(pum+i)*a1+(*(pvm+i))*a4+(*(pam+i))*a5)-alphaf/(1-alphaf)*(*(pum+i)));
-                    }
-                }
-                
-                // Add effective damping vector to effective load vector
-                 if (ANAFLAG == 4) {
-                     for (i = 0; i < NEQ; ++i) {
-                         *(pReff+i) += *(pMeff+i);
-                     }
-                 }
-                
-                // Calculate static force vector if generalized-alpha method specified
-                if (alphaf != 0){
-                    if(ANAFLAG != 4 && SLVFLAG == 0){// Non-FSI analysis, using skyline function
-                        skymult (pmaxa, pss, pdd);
-                    } else if (ANAFLAG == 4 || SLVFLAG == 1){// FSI analysis, cannot use skyline function
-                        double beta, gamma;
-                        int incx, incy;
-                        incx = incy = 1;
-                        beta = 1;
-                        gamma = 0;
-                        
-                        cblas_dgemv(CblasRowMajor, CblasNoTrans, m, n, beta, pss, lda, pdd, incx, gamma, pdd, incy);
-                    }
-                    for (i = 0; i < NEQ; ++i) {
-                        *(pReff+i) -= alphaf/(1-alphaf)*(*(pdd+i));
-                    }
-                }
-                
-                // Solve for displacements at current time step
-                if (NBC != 0) {
-                    for (i = 0; i < *(pmaxa+NEQ)-1; ++i) {
-                        *(pKeffcp+i) = *(pKeff+i);
-                    }
-                    
-                    for (i = 0; i < NEQ; ++i) {
-                        *(pdd+i) = *(pr+i);
-                        if (*(ppdisp+i*NTSTPS+k) != 0) {
-                            *(pReff+i) = *(ppdisp+i*NTSTPS+k);
-                        }
-                    }
-                    // Partition Keff matrix
-                    matpart (pmaxa, pkht, pKeffcp, pReff, pum, pii, pij);
-                    // Factorize Keff
-                    if (SLVFLAG == 0) {
-                        skyfact(pmaxa, pKeffcp, pssd, pdd, fact, pdet);
-                    }
-                    else if (SLVFLAG == 1) {
-                        dgetrf_(&m, &n, pKeffcp, &lda, pipiv, &info);
-                    }
-                    
-                    // Solve for displacements at current time step
-                    if (SLVFLAG == 0) {
-                        err = skysolve (pmaxa, pKeffcp, pssd, pReff, fact, pdet);
-                    }
-                    else if (SLVFLAG == 1) {
-                        dgetrs_(&trans, &n, &nrhs, pKeffcp, &lda, pipiv, pReff, &ldb, &info);
-                    }
-                    
-                    for (i = 0; i < *(pmaxa+NEQ)-1; ++i) {
-                        *(pKeffcp+i) = *(pKeff+i);
-                    }
-                    
-                } else {
-                    if (SLVFLAG == 0) {
-                        err = skysolve (pmaxa, pKeff, pssd, pReff, fact, pdet);
-                    }
-                    else if (SLVFLAG == 1) {
-                        dgetrs_(&trans, &n, &nrhs, pKeff, &lda, pipiv, pReff, &ldb, &info);
-                    }
-                    else if (SLVFLAG == 2) {
-                        (void) umfpack_di_solve (UMFPACK_A, pAp, pAi, pAx, puc, pReff, Numeric, null, null);
-                    }
-                }
-                
-                if (SLVFLAG == 0 || SLVFLAG == 1) {
-                    for (i = 0; i < NEQ; ++i) {
-                        *(puc+i) = *(pReff+i);
-                    }
-                }
-                
-                // Calculate current velocities and accelerations
-                for (i = 0; i < NEQ; ++i) {
-                    *(pac+i) = a0*(*(puc+i) - *(pum+i)) - a2*(*(pvm+i)) - a3*(*(pam+i));
-                    *(pvc+i) = *(pvm+i) + a6*(*(pam+i)) + a7*(*(pac+i));
-                }
-                
-                time = k*dt;
-                // Pass control to output function
-                output (&time, &dum, puc, puc, 1);
-                
-                // Assign current u, v, a to be the previous values
-                for (i = 0; i < NEQ; ++i) {
-                    *(pum+i) = *(puc+i);
-                    *(pvm+i) = *(pvc+i);
-                    *(pam+i) = *(pac+i);
-                }
-                
-                if ((k % CHKPT == 0) && (k != 0)){
-                    sprintf(file, "results8.txt");
-                    do {
-                        OFP[7] = fopen(file, "w"); // Open last successful checkpoint file
-                    } while (OFP[7] == 0);
-                    
-                    // Read in restart time step
-                    fprintf(OFP[7], "%ld\n", k);
-                    
-                    // Print displacements, velocities, and accelerations
-                    for (i = 0; i < NEQ; ++i) {
-                        fprintf(OFP[7], "%le,%le,%le\n", *(pum+i), *(pvm+i), *(pam+i));
-                    }
-                    
-                    // Signal the end of displacements, velocities, and accelerations
-                    fprintf (OFP[7], "%d,%d,%d\n", 0, 0, 0);
-                    
-                    fclose(OFP[7]);
-                }
-            }
-            
-            if (SLVFLAG == 2) {
-                umfpack_di_free_numeric (&Numeric);
-            }
-            
-            if (pKeffcp != NULL) {
-                free (pKeffcp);
-                pKeffcp = NULL;
-            }
-            
-        } else if (ALGFLAG == 5){ //Dynamic: nonlinear Newmark Intergration Method
-            
-            
-            // Initialize Reff for new time step to zero
-            for (i = 0; i < NEQ; ++i) {
-                *(pReff+i) = 0;
-            }
-            
-            //Compute the equivalent change in dynamic external force vector
-            if (ANAFLAG != 4 && SLVFLAG == 0) { // Non-FSI analysis, using skyline funciton
-                for (i = 0; i < NEQ; ++i){
-                    if (*(ppdisp+i*NTSTPS+tstp) != 0 && *(piter) > 0) {
-                        *(pReff+i) = 0;
-                    }else if (*(ppdisp+i*NTSTPS+tstp) != 0 && *(piter) == 0){
-                        *(pReff+i) = *(pum+i);
-                    }else {
-                        *(pReff+i) = *(pr+i) + *(psm+i)*((1-alpham)*((*(pvm+i))*a2+(*(pam+i))*a3)-alpham*(*(pam+i)))/(1-alphaf);
-                    }
-                }
-            }else if (ANAFLAG ==4 || SLVFLAG == 1) { //using CLAPACK solver
-                for (i = 0; i < NEQ; ++i) {
-                    sum = 0;
-                    for (j = 0; j < NEQ; ++j) {
-                        sum += *(psm+i*NEQ+j);
-                    }
-                    if (*(ppdisp+i*NTSTPS+tstp) != 0 && *(piter) > 0) {
-                        *(pReff+i) = 0;
-                    }else if (*(ppdisp+i*NTSTPS+tstp) != 0 && *(piter) == 0){
-                        *(pReff+i) = *(pum+i);
-                    }else {
-                        *(pReff+i) = *(pr+i)+sum*((1-alpham)*((*(pvm+i))*a2+(*(pam+i))*a3)-alpham*(*(pam+i)))/(1-alphaf);
-                    }
-                }
-            }
-            
-            if (NBC != 0) {
-                // Pass residual array to the incremental displacements array
-                for (i = 0; i < NEQ; ++i) {
-                    *(pdd+i) = *(pr+i);
-                }
-                // Partition Keff matrix
-                matpart (pmaxa, pkht, pKeff, pReff, pum, pii, pij);
-                // Factorize Keff
-                if (SLVFLAG == 0) {
-                    skyfact(pmaxa, pKeff, pssd, pdd, fact, pdet);
-                }
-                else if (SLVFLAG == 1) {
-                    dgetrf_(&m, &n, pKeff, &lda, pipiv, &info);
-                }
-            }
-            
-            /*Compute displacement*/
-            // Solve for displacements at each iteration
-            if (SLVFLAG == 0) {
-                err = skysolve (pmaxa, pKeff, pssd, pReff, fact, pdet);
-            }
-            else if (SLVFLAG == 1) {
-                dgetrs_(&trans, &n, &nrhs, pKeff, &lda, pipiv, pReff, &ldb, &info);
-            }
-            
-            //Pass displacement to main for Newton-Raphson iteration
-            for (i = 0; i < NEQ; ++i) {
-                *(pdd+i) = *(pReff+i);
-            }
-        }
-    }
-    return 0;
-}
-
-
-int skyfact (long *pmaxa, double *pss_temp, double *pssd, double *pdd, int fact, int *pdet)
-{
-    
-    // Initialize function variables
-    long i, n, kn, kl, ku, kh, k, ic, klt, j, ki, nd, kk, l;
-    double b, c;
-    
-    /* Initialize determinant sign flag to zero; zero indicates a positive definite
-     stiffness matrix */
-    *pdet = 0;
-    // Perform LDL^t factorization of the stiffness matrix
-    if (fact == 0) {
-        for (n = 1; n <= NEQ; ++n) {
-            kn = *(pmaxa+n-1);
-            kl = kn + 1;
-            ku = *(pmaxa+n) - 1;
-            kh = ku - kl;
-            
-            if (kh < 0) {
-                if (ALGFLAG != 3 && *(pss_temp+kn-1) <= 0) {
-                    fprintf(OFP[0], "\n***ERROR*** Non-positive definite stiffness");
-                    fprintf(OFP[0], " matrix\n");
-                    return 1;
-                    
-                } else if (ALGFLAG == 3) {
-                    *(pssd+n-1) = *(pss_temp+kn-1);
-                    if (*(pss_temp+kn-1) == 0) {
-                        fprintf(OFP[0], "\n***ERROR*** Singular stiffness matrix\n");
-                        return 1;
-                    } else if (*(pss_temp+kn-1) > 0 && *pdet != 1) {
-                        *pdet = 0;
-                    } else {
-                        *pdet = 1;
-                    }
-                }
-            } else if (kh > 0) {
-                k = n - kh;
-                ic = 0;
-                klt = ku;
-                for (j = 1; j <= kh; ++j) {
-                    ic++;
-                    klt--;
-                    ki = *(pmaxa+k-1);
-                    
-                    nd = *(pmaxa+k) - ki - 1;
-                    if (nd > 0) {
-                        if (nd < ic) {
-                            kk = nd;
-                        } else {
-                            kk = ic;
-                        }
-                        c = 0;
-                        for (l = 1; l <= kk; ++l) {
-                            c += *(pss_temp+ki-1+l) * (*(pss_temp+klt-1+l));
-                        }
-                        *(pss_temp+klt-1) -= c;
-                    }
-                    k++;
-                }
-                k = n;
-                b = 0;
-                for (kk = kl; kk <= ku; ++kk) {
-                    k--;
-                    ki = *(pmaxa+k-1);
-                    c = *(pss_temp+kk-1) / *(pss_temp+ki-1);
-                    b += c * (*(pss_temp+kk-1));
-                    *(pss_temp+kk-1) = c;
-                }
-                *(pss_temp+kn-1) -= b;
-                if (ALGFLAG != 3 && *(pss_temp+kn-1) <= 0) {
-                    fprintf(OFP[0], "\n***ERROR*** Non-positive definite stiffness");
-                    fprintf(OFP[0], " matrix\n");
-                    return 1;
-                } else if (ALGFLAG == 3) {
-                    *(pssd+n-1) = *(pss_temp+kn-1);
-                    if (*(pss_temp+kn-1) == 0) {
-                        fprintf(OFP[0], "\n***ERROR*** Singular stiffness matrix\n");
-                        return 1;
-                    } else if (*(pss_temp+kn-1) > 0 && *pdet != 1) {
-                        *pdet = 0;
-                    } else {
-                        *pdet = 1;
-                    }
-                }
-            } else if (kh == 0) {
-                k = n;
-                b = 0;
-                for (kk = kl; kk <= ku; ++kk) {
-                    k--;
-                    ki = *(pmaxa+k-1);
-                    c = *(pss_temp+kk-1) / *(pss_temp+ki-1);
-                    b += c * (*(pss_temp+kk-1));
-                    *(pss_temp+kk-1) = c;
-                }
-                *(pss_temp+kn-1) -= b;
-                if (ALGFLAG != 3 && *(pss_temp+kn-1) <= 0) {
-                    fprintf(OFP[0], "\n***ERROR*** Non-positive definite stiffness");
-                    fprintf(OFP[0], " matrix\n");
-                    return 1;
-                } else if (ALGFLAG == 3) {
-                    *(pssd+n-1) = *(pss_temp+kn-1);
-                    if (*(pss_temp+kn-1) == 0) {
-                        fprintf(OFP[0], "\n***ERROR*** Singular stiffness matrix\n");
-                        return 1;
-                    } else if (*(pss_temp+kn-1) > 0 && *pdet != 1) {
-                        *pdet = 0;
-                    } else {
-                        *pdet = 1;
-                    }
-                }
-            }
-        }
-    }
-    return 0;
-}
-
-int skysolve (long *pmaxa, double *pss_temp, double *pssd, double *pdd, int fact, int *pdet)
-{
-    
-    // Initialize function variables
-    long i, n, kl, ku, kh, k, kk;
-    double c;
-    
-    // Reduce right-hand-side load vector
-    for (n = 1; n <= NEQ; ++n) {
-        kl = *(pmaxa+n-1) + 1;
-        ku = *(pmaxa+n) - 1;
-        kh = ku - kl;
-        if (kh >= 0) {
-            k = n;
-            c = 0;
-            for (kk = kl; kk <= ku; ++kk) {
-                k--;
-                c += *(pss_temp+kk-1) * (*(pdd+k-1));
-            }
-            *(pdd+n-1) -= c;
-        }
-    }
-    
-    // Back-substitute
-    for (n = 0; n < NEQ; ++n) {
-        k = *(pmaxa+n);
-        *(pdd+n) /= (*(pss_temp+k-1));
-    }
-    n = NEQ;
-    for (i = 2; i <= NEQ; ++i) {
-        kl = *(pmaxa+n-1) + 1;
-        ku = *(pmaxa+n) - 1;
-        kh = ku - kl;
-        if (kh >= 0) {
-            k = n;
-            for (kk = kl; kk <= ku; ++kk) {
-                k--;
-                *(pdd+k-1) -= *(pss_temp+kk-1) * (*(pdd+n-1));
-            }
-        }
-        n--;
-    }
-    return 0;
-}
-
-int skymult (long *pmaxa, double *pss_temp, double *pdd)
-{
-    
-    // Initialize function variables
-    long i, n, kl, ku, kh, k, kk;
-    double c, ddn[NEQ];
-    
-    for (i = 0; i < NEQ; ++i) {
-        ddn[i]=0;
-    }
-    
-    //Compute the product of the upper triangle in the stiffness matrix and the displacement vector
-    n = NEQ;
-    for (i = 2; i <= NEQ; ++i) {
-        kl = *(pmaxa+n-1) + 1;
-        ku = *(pmaxa+n) - 1;
-        kh = ku - kl;
-        if (kh >= 0) {
-            k = n;
-            for (kk = kl; kk <= ku; ++kk) {
-                k--;
-                ddn[k-1] += *(pss_temp+kk-1) * (*(pdd+n-1));
-            }
-        }
-        n--;
-    }
-    
-    // Compute product of the diagonal in the stiffness matrix and the displacement vector
-    for (n = 0; n < NEQ; ++n) {
-        k = *(pmaxa+n);
-        ddn[n] += (*(pdd+n))*(*(pss_temp+k-1));
-    }
-    
-    //Compute product of the lower triangle in the stiffness matrix and the displacement vector
-    n = NEQ;
-    for (i = 1; i <= NEQ; ++i) {
-        kl = *(pmaxa+n-1) + 1;
-        ku = *(pmaxa+n) - 1;
-        kh = ku - kl;
-        if (kh >= 0) {
-            k = n;
-            c = 0;
-            for (kk = kl; kk <= ku; ++kk) {
-                k--;
-                c += *(pss_temp+kk-1) * (*(pdd+k-1));
-            }
-            ddn[n-1] += c;
-        }
-        n--;
-    }
-    
-    for (i = 0; i < NEQ; ++i) {
-        *(pdd+i) = ddn[i];
-    }
-    
-    return 0;
-}
-
-int matpart (long *pmaxa, long *pkht, double *pss, double *pqtot, double *puc, int *pii, int *pij)
-{
-    
-    // Initialize function variables
-    long i, j, n, kl, ku, kh, k, kk;
-    
-    // Modify the upper triangle of the stiffness matrix
-    n = *(pij+NBC-1)+1;
-    for (i = 1; i <= NBC; ++i) {
-        kl = *(pmaxa+n-1) + 1;
-        ku = *(pmaxa+n) - 1;
-        kh = ku - kl;
-        if (kh >= 0) {
-            k = n-1;
-            for (kk = kl; kk <= ku; ++kk) {
-                k--;
-                for (j = 0; j < NBC; ++j) {
-                    if (k == *(pij+j)) {
-                        *(pss+kk-1) = 0;
-                    }
-                }
-            }
-            k = n-1;
-            for (kk = kl; kk <= ku; ++kk) {
-                k--;
-                *(pqtot+k) -= (*(pss+kk-1))*(*(puc+n-1));
-                *(pss+kk-1) = 0;
-            }
-        }
-        n = *(pij+NBC-1-i)+1;
-    }
-    
-    // Modify the diagonal of the stiffness matrix
-    for (n = 0; n < NBC; ++n) {
-        k = *(pmaxa+ (*(pij+n)));
-        *(pss+k-1) = 1;
-    }
-    
-    // Modify the lower triangle of the stiffness matrix
-    n = *(pii+NEQ-NBC-1)+1;
-    for (i = 1; i <= NEQ-NBC; ++i) {
-        kl = *(pmaxa+n-1) + 1;
-        ku = *(pmaxa+n) - 1;
-        kh = ku - kl;
-        if (kh >= 0) {
-            k = n;
-            for (kk = kl; kk <= ku; ++kk) {
-                k--;
-                for (j = 0; j < NBC; ++j) {
-                    if (k-1 == *(pij+j)) {
-                        *(pqtot+n-1) -= (*(pss+kk-1))*(*(puc+k-1));
-                        *(pss+kk-1) = 0;
-                    }
-                }
-            }
-        }
-        n = *(pii+NEQ-NBC-1-i)+1;
-    }
-    
-    return 0;
-}
-
-
-
-
-
-
+//********************************************************************************
+//**                                                                            **
+//**  Pertains to CU-BEN ver 4.0                                                **
+//**                                                                            **
+//**  CU-BENs: a ship hull modeling finite element library                      **
+//**  Copyright (c) 2019 C. J. Earls                                            **
+//**  Developed by C. J. Earls, Cornell University                              **
+//**  All rights reserved.                                                      **
+//**                                                                            **
+//**  Contributors:                                                             **
+//**    Christopher Stull                                                       **
+//**    Heather Reed                                                            **
+//**    Justyna Kosianka                                                        **
+//**    Wensi Wu                                                                **
+//**                                                                            **
+//**  This program is free software: you can redistribute it and/or modify it   **
+//**  under the terms of the GNU General Public License as published by the     **
+//**  Free Software Foundation, either version 3 of the License, or (at your    **
+//**  option) any later version.                                                **
+//**                                                                            **
+//**  This program is distributed in the hope that it will be useful, but       **
+//**  WITHOUT ANY WARRANTY; without even the implied warranty of                **
+//**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General  **
+//**  Public License for more details.                                          **
+//**                                                                            **
+//**  You should have received a copy of the GNU General Public License along   **
+//**  with this program. If not, see <https://www.gnu.org/licenses/>.           **
+//**                                                                            **
+//********************************************************************************
+
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <float.h>
+#include "prototypes.h"
+
+#ifdef _OPENMP
+#  include <omp.h>
+#endif
+
+#ifdef BEN_MPI
+#  include <mpi.h>
+#endif
+
+// CLAPACK header files
+#if defined(__APPLE__)
+#  include <Accelerate/Accelerate.h>
+#else
+void dgetrf_ (int *m, int *n, double *a, int *lda, int *ipiv, int *info);
+void dgetrs_ (char *trans, int *n, int *nrhs, double *a, int *lda, int *ipiv, double *b,
+              int *ldb, int *info);
+void dpbtrf_ (char *uplo, int *n, int *kd, double *ab, int *ldab, int *info);
+void dpbtrs_ (char *uplo, int *n, int *kd, int *nrhs, double *ab, int *ldab, double *b,
+              int *ldb, int *info);
+void dpotrf_ (char *uplo, int *n, double *a, int *lda, int *info);
+void dpotrs_ (char *uplo, int *n, int *nrhs, double *a, int *lda, double *b, int *ldb,
+              int *info);
+void dsytrf_ (char *uplo, int *n, double *a, int *lda, int *ipiv, double *work, int *lwork,
+              int *info);
+void dsytrs_ (char *uplo, int *n, int *nrhs, double *a, int *lda, int *ipiv, double *b,
+              int *ldb, int *info);
+#endif
+
+//UMFPACK header files
+#include "umfpack.h"
+
+//CHOLMOD header files
+#include "cholmod.h"
+
+extern BEN_TLS long NJ, NE_TR, NE_FR, NE_SH, SNDOF, FNDOF, NEQ, NBC, NTSTPS, NE_SBR, NE_FBR, BAND;
+extern BEN_TLS double dt, ttot;
+extern BEN_TLS int ANAFLAG, ALGFLAG, SLVFLAG, FSIFLAG, brFSI_FLAG, shFSI_FLAG, CHKPT, RFLAG, MPFLAG, OOCFLAG, ITFLAG, LRMAX, MPIRANK, MPISIZE;
+
+/* Number of entries of an out-of-core skyline array read ahead at a time by skyfact and
+ skysolve (32 MB) */
+#define OOCPNL 4194304
+
+#define LRCGTOL 1e-10 // Relative residual at which the conjugate gradient iterations of lrsolve stop
+#define LRMAXIT 50 // Maximum number of conjugate gradient iterations of lrsolve
+/* Number of conjugate gradient iterations of lrsolve above which the update no longer pays for
+ itself, and lrfact refactorizes the matrix at its next call */
+#define LRREFIT 10
+
+extern BEN_TLS FILE *IFP[4], *OFP[8];
+
+/* UMFPACK numeric factorization kept between calls so that it can be reused when fact = 1
+ (SLVFLAG == 2) */
+static BEN_TLS void *Numeric = NULL;
+
+/* CHOLMOD workspace and the sparse Cholesky factorization kept between calls (SLVFLAG == 3);
+ the factor also holds the fill-reducing ordering and symbolic analysis */
+static BEN_TLS cholmod_common Common;
+static BEN_TLS cholmod_factor *pL = NULL;
+static BEN_TLS int cholstart = 0;
+
+/* Single precision factorization of the skyline matrix, the infinity norm of the double
+ precision matrix for the refinement criterion, and a flag set once the refinement has
+ stalled, after which the double precision factorization is used (MPFLAG == 1) */
+static BEN_TLS float *pssf = NULL;
+static BEN_TLS double mpnrm = 0;
+static BEN_TLS int mpstall = 0;
+
+/* Workspace of skymult: the product followed by one accumulator per thread; it is allocated
+ on the first call and kept for the remainder of the analysis */
+static BEN_TLS double *pmult = NULL;
+static BEN_TLS long lmult = 0;
+
+/* Low-rank updates of the skyline factorization (LRMAX > 0), which is kept in the effective
+ stiffness array unused by static analyses: the element equations and yield states registered
+ by lrelem and the yield states at the last factorization, the updated equations and the index
+ of each equation among them (-1 if not updated), the block of the inverse of the factorized
+ matrix over the updated equations, the change of the matrix over them, the LU factors of the
+ capacitance matrix and their pivots, a work vector, the number of updated equations (-1 until
+ the first factorization), the iterations of the last solution, and a flag indicating that the
+ factorized matrix is the current one */
+static BEN_TLS long *plrmc = NULL;
+static BEN_TLS int *plryf = NULL, *plryv = NULL, *plre = NULL;
+static BEN_TLS double *plrv = NULL, *plrd = NULL, *plrg = NULL, *plrw = NULL;
+static BEN_TLS long *plrs = NULL, *plrm = NULL;
+static BEN_TLS int *plrp = NULL;
+static BEN_TLS long lrs = -1, lrit = 0;
+static BEN_TLS int lrdir = 0;
+
+#ifdef BEN_MPI
+/* Domain decomposition of the skyline solver over the MPI ranks (see ddcodes): the map of the
+ equations to the interface and to the interior of this rank, the numbers of interface and
+ interior equations, the skyline addresses and LDL^t factor of the interior stiffness, the
+ diagonal of the interface stiffness, and the LDL^t factorization of the interface problem
+ with its pivots when it is solved directly (see ddschur) */
+static BEN_TLS long *ddmap = NULL, *ddmaxa = NULL, ddnif = 0, ddnint = 0;
+static BEN_TLS double *ddsk = NULL, *ddpre = NULL, *ddsch = NULL;
+static BEN_TLS int *ddipiv = NULL;
+#endif
+
+
+int solve (long *pjcode, double *pss, double *pss_fsi, double *psm, double *psm_fsi, double *psml, double *psd_fsi, double *pr, double *pdd, long *pmaxa, double *pssd, int *pdet,
+           double *pum, double *pvm, double *pam, double *puc, double *pvc, double *pac, long *pqdyn_h, double *pqdyn,
+           double *pKeff, double *pReff, double *pMeff, double *pab, int *pAp, int *pAi, double *pAx, double alpham, double alphaf, int *pipiv, int fact, double ddt, long *ppdisp_h, double *ppdisp, long *ppart, int *piter, int *pii, int *pij, int tstp)
+{
+    
+    // Initialize function variables
+    long i, j, k;
+    int err, dum = 0;
+    double time, sum = 0;
+    double a0, a1, a2, a3, a4, a5, a6, a7;
+    double alpha, delta;
+    double dt_temp;// Variable for time stepping scheme
+    
+    // Initialize CLAPACK variables
+    int m, n, lda, ldb;
+    
+    m = n = lda = ldb = NEQ;
+    
+    // Initialize UMFPACK sparse solver variables
+    double *null = (double *) NULL;
+    
+    /* Type of the CLAPACK factorization held in the factorized matrix (0 - general LU,
+     1 - Cholesky, 2 - symmetric indefinite LDL^t) */
+    static BEN_TLS int lapflag = 0;
+    
+    /* Flag for the skyline solver indicating that the factorization is held in LAPACK band
+     storage (see skylin) */
+    static BEN_TLS int bndflag = 0;
+    
+    /* Flag for the skyline solver indicating that the factorization is held in single
+     precision (see mixfact) */
+    static BEN_TLS int mixflag = 0;
+    
+    /* Flag for the skyline solver indicating that the system is solved by domain
+     decomposition over the MPI ranks (see ddfact) */
+    static BEN_TLS int ddflag = 0;
+    
+    /* Flag for the skyline solver indicating that the system is solved by conjugate
+     gradients with the multigrid preconditioner (see amgfact) */
+    static BEN_TLS int itflag = 0;
+    
+    /* Flag for the skyline solver indicating that the system is solved with a low-rank
+     update of a previous factorization (see lrfact) */
+    static BEN_TLS int lrflag = 0;
+    
+    statbeg (ST_SOLVE);
+    
+    /* Error flag of the factorizations and solutions; the functions which allocate their
+     own workspace return -1 if it cannot be allocated */
+    err = 0;
+    
+    // Pass residual array to the incremental displacements array
+    for (i = 0; i < NEQ; ++i) {
+        *(pdd+i) = *(pr+i);
+    }
+    
+    // Static analysis
+    if (ALGFLAG < 4) {
+        
+        // Skyline solver for structural elements
+        if (SLVFLAG == 0) {
+            if (fact == 0) {
+                itflag = amgfact (pmaxa, pss, pdet);
+                ddflag = ddfact (pmaxa, pss, pdet);
+                bndflag = mixflag = lrflag = 0;
+                if (ddflag == 0) {
+                    bndflag = bandfact (pmaxa, pss, pab, pssd, pdet);
+                    mixflag = mixfact (pmaxa, pss, pssd, pdet);
+                    lrflag = lrfact (pmaxa, pss, pKeff, pssd, pdet);
+                }
+            }
+            if (itflag == 1) {
+                itflag = amgsolve (pmaxa, pss, pssd, pdd, pdet);
+            } else if (ddflag == 1) {
+                ddflag = ddsolve (pmaxa, pss, pssd, pdd, pdet);
+            } else if (bndflag == 1) {
+                bandsolve (pab, pdd);
+            } else if (mixflag == 1) {
+                mixflag = mixsolve (pmaxa, pss, pssd, pdd, pdet);
+            } else if (lrflag == 1) {
+                lrflag = lrsolve (pmaxa, pss, pKeff, pssd, pdd, pdet);
+            } else if (itflag == 0 && ddflag == 0 && mixflag == 0 && lrflag == 0) {
+                skyfact(pmaxa, pss, pssd, pdd, fact, pdet);
+                skysolve (pmaxa, pss, pssd, pdd, fact, pdet);
+            }
+            if (itflag < 0 || ddflag < 0 || mixflag < 0 || lrflag < 0) {
+                err = 1;
+            }
+        }
+        
+        // CLAPACK direct solver
+        else if (SLVFLAG == 1) {
+            
+            /* Factorize the matrix with the symmetric or general LAPACK routines; if the
+             factorization from a previous solution is reused, only the triangular solves
+             are performed */
+            if (fact == 0) {
+                lapflag = lapfact (pss, pipiv, pssd, pdet);
+            }
+            if (lapflag < 0) {
+                statend (ST_SOLVE, 0);
+                return 1;
+            }
+            lapsolve (pss, pipiv, pr, lapflag);
+            
+            // Set displacements from CLAPACK to dd array
+            for (i = 0; i < NEQ; ++i) {
+                *(pdd+i) = *(pr+i);
+            }
+            
+            // Pass control to output function
+            output (pr, &dum, pdd, puc, 1);
+        }
+        
+        // UMFPACK sparse solver
+        else if (SLVFLAG == 2) {
+            
+            /* Compress and factorize the stiffness matrix; if the factorization from a
+             previous solution is reused, only the solve is performed */
+            if (fact == 0) {
+                sparsefact (pmaxa, pss, pAp, pAi, pAx, &Numeric, 0);
+            }
+            
+            // Solve system of equations for displacement vector uc
+            (void) umfpack_di_solve (UMFPACK_A, pAp, pAi, pAx, puc, pr, Numeric, null, null);
+            
+            for (i = 0; i < NEQ; ++i){
+                fprintf(OFP[5],"%lf\t",*(puc+i));
+            }
+            fprintf(OFP[5],"\n");
+            
+            // Set displacements from UMFPACK to dd array
+            for (i = 0; i < NEQ; ++i) {
+                *(pdd+i) = *(puc+i);
+            }
+        }
+        
+        // CHOLMOD sparse Cholesky solver
+        else if (SLVFLAG == 3) {
+            
+            /* Factorize the stiffness matrix; if the factorization from a previous solution
+             is reused, only the solve is performed */
+            if (fact == 0 && cholfact (pmaxa, pss, pAp, pAi, pAx, pssd, pdet) < 0) {
+                err = 1;
+            } else {
+                cholsolve (pdd);
+            }
+        }
+    }
+    
+    // Dynamic analysis
+    else if (ALGFLAG > 3) {
+        
+        /* Initialize effective stiffness matrix to zero; if fact = 1, the effective stiffness
+         matrix factorized in a previous call is reused and is neither formed nor factorized */
+        if (SLVFLAG == 1 && fact == 0) {
+            for (i = 0; i < NEQ; ++i) {
+                for (j = 0; j < NEQ; ++j) {
+                    *(pKeff+i*NEQ+j) = 0;
+                }
+            }
+        }
+        else if (fact == 0) {
+            for (i = 0; i < *(pmaxa+NEQ)-1; ++i) {
+                *(pKeff+i) = 0;
+            }
+        }
+        
+        // Add masses to nodes subjected to nonzero displacement boundary conditions
+        if (NBC != 0 && SLVFLAG == 0){
+            for (i = 0; i < NEQ; ++i) {
+                if (histval(ppdisp_h, ppdisp, i, tstp) != 0) {
+                    *(psm+i) = 1000000 * (*(psm+i));
+                }
+            }
+        /* The rows of these nodes are removed from the effective stiffness matrix by the
+         partition, so the symmetric skyline mass array of the sparse solvers is left as it is */
+        } else if (NBC != 0 && SLVFLAG == 1) { // Full order mass matrix; scale the rows of these nodes
+            for (i = 0; i < NEQ; ++i) {
+                if (histval(ppdisp_h, ppdisp, i, tstp) != 0) {
+                    for (j = 0; j < NEQ; ++j) {
+                        *(psm+i*NEQ+j) = 1000000 * (*(psm+i*NEQ+j));
+                    }
+                }
+            }
+        }
+        // Scale the lumped mass vector used by the nonlinear Newmark residuals alike
+        if (NBC != 0 && ALGFLAG == 5) {
+            for (i = 0; i < NEQ; ++i) {
+                if (histval(ppdisp_h, ppdisp, i, tstp) != 0) {
+                    *(psml+i) = 1000000 * (*(psml+i));
+                }
+            }
+        }
+        
+        alpha = pow(1-alpham+alphaf, 2)/4;
+        delta = 0.5-alpham+alphaf;
+        dt_temp = ddt * dt;
+        
+        // Calculate integration constants
+        a0 = 1/(alpha*pow(dt_temp,2));
+        a1 = delta/(alpha*dt_temp);
+        a2 = 1/(alpha*dt_temp);
+        a3 = 1/(2*alpha) - 1;
+        a4 = delta/alpha - 1;
+        a5 = (dt_temp)/2*(delta/alpha - 2);
+        a6 = (dt_temp)*(1-delta);
+        a7 = delta*(dt_temp);
+        
+        /* Calculate effective stiffness matrix */
+        if (ANAFLAG == 4 && SLVFLAG == 2 && fact == 0) { // Monolithic FSI analysis, using UMFPACK
+            /* The skyline holds the uncoupled structure and fluid blocks; the coupling terms
+             are merged into the compressed columns by sparsefact */
+            for (i = 0; i < *(pmaxa+NEQ)-1; ++i) {
+                *(pKeff+i) = *(pss+i)+a0*(1-alpham)*(*(psm+i))/(1-alphaf);
+            }
+            for (i = 0; i < NEQ; ++i) {
+                k = *(pmaxa+i);
+                *(pKeff+k-1) += a1*(*(psd_fsi+i));
+            }
+        }
+        else if (ANAFLAG == 4 && SLVFLAG != 0 && fact == 0) { // Monolithic FSI analysis
+            for (i = 0; i < NEQ; ++i) {
+                for (j = 0; j < NEQ; ++j) {
+                    if (i != j) {
+                        *(pKeff+j*NEQ+i) = (*(pss_fsi+i*NEQ+j))+a0*(1-alpham)*(*(psm_fsi+i*NEQ+j))/(1-alphaf);
+                    }
+                    else {
+                        *(pKeff+j*NEQ+i) = (*(pss_fsi+i*NEQ+j))+a0*(1-alpham)*(*(psm_fsi+i*NEQ+j))/(1-alphaf)+a1*(*(psd_fsi+i));
+                    }
+                }
+            }
+        }
+        else if (ANAFLAG == 4 && fact == 0) { // Partitioned FSI analysis, using skyline function
+            /* The skyline holds the uncoupled structure and fluid blocks; the coupling terms
+             are applied by fsisolve */
+            for (i = 0; i < *(pmaxa+NEQ)-1; ++i) {
+                *(pKeff+i) = *(pss+i);
+            }
+            for (i = 0; i < NEQ; ++i) {
+                k = *(pmaxa+i);
+                *(pKeff+k-1) += a0*(1-alpham)*(*(psm+i))/(1-alphaf)+a1*(*(psd_fsi+i));
+            }
+        }
+        else if (ANAFLAG != 4 && fact == 0) { // Non-FSI analysis
+            if (SLVFLAG == 0) { // using skyline function
+                for (i = 0; i < *(pmaxa+NEQ)-1; ++i) {
+                    *(pKeff+i) = *(pss+i); // Initialize Keff w K
+                }
+                for (i = 0; i <  NEQ; ++i) { // Add mass to diagonal elements
+                    k = *(pmaxa+i);
+                    *(pKeff+k-1) += a0*(1-alpham)*(*(psm+i))/(1-alphaf);
+                }
+            }
+            else if (SLVFLAG == 2 || SLVFLAG == 3) { // using UMFPACK or CHOLMOD solver on the skyline of K and M
+                for (i = 0; i < *(pmaxa+NEQ)-1; ++i) {
+                    *(pKeff+i) = *(pss+i)+a0*(1-alpham)*(*(psm+i))/(1-alphaf);
+                }
+            }
+            else if (SLVFLAG == 1) { // using CLAPACK solver
+                for (i = 0; i < NEQ; ++i) {
+                    for (j = 0; j < NEQ; ++j) {
+                        *(pKeff+j*NEQ+i) = (*(pss+i*NEQ+j))+a0*(1-alpham)*(*(psm+i*NEQ+j))/(1-alphaf);
+                    }
+                }
+            }
+        }
+        
+        if (NBC == 0 && fact == 0) {
+            // Factorize Keff
+            if (SLVFLAG == 0) {
+                itflag = amgfact (pmaxa, pKeff, pdet);
+                bndflag = bandfact (pmaxa, pKeff, pab, pssd, pdet);
+                mixflag = mixfact (pmaxa, pKeff, pssd, pdet);
+                if (itflag == 0 && bndflag == 0 && mixflag == 0) {
+                    skyfact(pmaxa, pKeff, pssd, pdd, fact, pdet);
+                }
+            }
+            else if (SLVFLAG == 1) {
+                lapflag = lapfact (pKeff, pipiv, pssd, pdet);
+            }
+            else if (SLVFLAG == 2) {
+                sparsefact (pmaxa, pKeff, pAp, pAi, pAx, &Numeric, a0*(1-alpham)/(1-alphaf));
+            }
+            else if (SLVFLAG == 3 && cholfact (pmaxa, pKeff, pAp, pAi, pAx, pssd, pdet) < 0) {
+                err = 1;
+            }
+            if (itflag < 0 || mixflag < 0 || lapflag < 0 || err == 1) {
+                statend (ST_SOLVE, 0);
+                return 1;
+            }
+        }
+        
+        if (ALGFLAG == 4){ // Dynamic: linear Newmark Intergration Method
+            
+            char CblasRowMajor, CblasNoTrans;
+            /* Initialize a copy of effective stiffness matrix for nonzero displacement matrix
+             computation; lss is the length of the skyline or full order matrix */
+            long lss = (SLVFLAG != 1) ? *(pmaxa+NEQ)-1 : NEQ*NEQ;
+            double *pKeffcp = (OOCFLAG == 1) ? map_dbl (lss) : alloc_dbl (lss);
+            if (pKeffcp == NULL) {
+                statend (ST_SOLVE, 0);
+                return 1;
+            }
+            
+            char file[20];
+            
+            if (RFLAG == 1) {
+                // Open I/O for business!
+                do {
+                    IFP[3] = fopen("results8.txt", "r"); // Open last successful checkpoint file
+                } while (IFP[3] == 0);
+                
+                fscanf(IFP[3], "%d\n", &tstp);
+                
+                // Read in displacements, velocities, and accelerations from checkpoint file
+                for (i = 0; i < NEQ; ++i) {
+                    fscanf(IFP[3],  "%le,%le,%le\n", &pum[i], &pvm[i], &pam[i]);
+                }
+                
+                fscanf(IFP[3],  "%ld,%ld,%ld\n", &i, &j, &k);
+                
+                if (i == 0 && j == 0 && k == 0) {
+                    printf ("Read in displacements, velocities, and accelerations complete\n");
+                }
+                
+                if (tstp+1 == NTSTPS) {
+                    // Pass control to output function
+                    time = tstp*dt;
+                    output (&time, &dum, pum, pum, 1);
+                }
+                tstp = tstp+1;
+            }
+            
+            // Initialize current u, v, and a
+            for (i = 0; i < NEQ; ++i) {
+                *(puc+i) = *(pvc+i) = *(pac+i) = 0;
+            }
+            
+            // Loop through each time step to solve for displacements
+            for (k = tstp; k < NTSTPS; ++k) {
+                
+                // Initialize Meff and Reff for new time step to zero
+                // Update displacement vector
+                for (i = 0; i < NEQ; ++i) {
+                    *(pMeff+i) = 0;	*(pReff+i) = 0;
+                    *(pdd+i) = *(pum+i);
+                }
+                
+                // Calculate effective mass matrix
+                if (ANAFLAG == 4 && SLVFLAG == 2) { // Monolithic FSI analysis, using UMFPACK
+                    for (i = 0; i < NEQ; ++i) {
+                        *(pReff+i) = ((1-alpham)*((*(pum+i))*a0+(*(pvm+i))*a2+(*(pam+i))*a3)-alpham*(*(pam+i)))/(1-alphaf);
+                        *(pMeff+i) = *(pReff+i);
+                    }
+                    if (skymult (pmaxa, psm, pMeff) < 0) {
+                        err = 1;
+                        break;
+                    }
+                    fsimass (pReff, pMeff, 1);
+                }
+                else if (ANAFLAG == 4 && SLVFLAG != 0) { // Monolithic FSI analysis
+                    for (i = 0; i < NEQ; ++i) {
+                        sum = 0;
+                        for (j = 0; j < NEQ; ++j) {
+                            sum += *(psm_fsi+i*NEQ+j)*((1-alpham)*((*(pum+j))*a0+(*(pvm+j))*a2+(*(pam+j))*a3)-alpham*(*(pam+j)))/(1-alphaf);
+                        }
+                        *(pMeff+i) = sum;
+                    }
+                }
+                else if (ANAFLAG == 4) { // Partitioned FSI analysis, using skyline function
+                    for (i = 0; i < NEQ; ++i) {
+                        *(pReff+i) = ((1-alpham)*((*(pum+i))*a0+(*(pvm+i))*a2+(*(pam+i))*a3)-alpham*(*(pam+i)))/(1-alphaf);
+                        *(pMeff+i) = *(psm+i)*(*(pReff+i));
+                    }
+                    fsimass (pReff, pMeff, 1);
+                }
+                else if (ANAFLAG != 4) { // Non-FSI analysis
+                    if (SLVFLAG == 0) { // using skyline function
+                        for (i = 0; i < NEQ; ++i) {
+                            *(pMeff+i) = *(psm+i)*((1-alpham)*((*(pum+i))*a0+(*(pvm+i))*a2+(*(pam+i))*a3)-alpham*(*(pam+i)))/(1-alphaf);
+                        }
+                    }
+                    else if (SLVFLAG == 2 || SLVFLAG == 3) { // using UMFPACK or CHOLMOD solver on the skyline of M
+                        for (i = 0; i < NEQ; ++i) {
+                            *(pMeff+i) = ((1-alpham)*((*(pum+i))*a0+(*(pvm+i))*a2+(*(pam+i))*a3)-alpham*(*(pam+i)))/(1-alphaf);
+                        }
+                        if (skymult (pmaxa, psm, pMeff) < 0) {
+                            err = 1;
+                            break;
+                        }
+                    }
+                    else if (SLVFLAG == 1) { // using CLAPACK solver
+                        for (i = 0; i < NEQ; ++i) {
+                            sum = 0;
+                            for (j = 0; j < NEQ; ++j) {
+                                sum += *(psm+i*NEQ+j)*((1-alpham)*((*(pum+j))*a0+(*(pvm+j))*a2+(*(pam+j))*a3)-alpham*(*(pam+j)))/(1-alphaf);
+                            }
+                            *(pMeff+i) = sum;
+                        }
+                    }
+                }
+                
+                // Calculate effective load vector
+                if (k == 0){ //First time step, cannot interpolate external force vectors
+                    for (i = 0; i < NEQ; ++i) {
+                        *(pReff+i) = histval(pqdyn_h, pqdyn, i, k) + *(pMeff+i);
+                    }
+                } else {
+                    for (i = 0; i < NEQ; ++i) {
+                        *(pReff+i) = histval(pqdyn_h, pqdyn, i, k)+alphaf/(1-alphaf)*histval(pqdyn_h, pqdyn, i, k-1)+ *(pMeff+i);
+                    }
+                }
+                
+                // Calculate effective damping vector (re-use Meff)
+                if (ANAFLAG == 4) {
+                    for (i = 0; i < NEQ; ++i) {
+                        *(pMeff+i) = *(psd_fsi+i)*((*(pum+i)*a1+(*(pvm+i))*a4+(*(pam+i))*a5)-alphaf/(1-alphaf)*(*(pum+i)));
+                    }
+                }
+                
+                // Add effective damping vector to effective load vector
+                 if (ANAFLAG == 4) {
+                     for (i = 0; i < NEQ; ++i) {
+                         *(pReff+i) += *(pMeff+i);
+                     }
+                 }
+                
+                // Calculate static force vector if generalized-alpha method specified
+                if (alphaf != 0){
+                    if(SLVFLAG != 1){// Using skyline function (the fluid rows of the FSI stiffness are uncoupled)
+                        if (skymult (pmaxa, pss, pdd) < 0) {
+                            err = 1;
+                            break;
+                        }
+                    } else {// Using CLAPACK solver
+                        double beta, gamma;
+                        int incx, incy;
+                        incx = incy = 1;
+                        beta = 1;
+                        gamma = 0;
+                        
+                        cblas_dgemv(CblasRowMajor, CblasNoTrans, m, n, beta, pss, lda, pdd, incx, gamma, pdd, incy);
+                    }
+                    for (i = 0; i < NEQ; ++i) {
+                        *(pReff+i) -= alphaf/(1-alphaf)*(*(pdd+i));
+                    }
+                }
+                
+                // Solve for displacements at current time step
+                if (NBC != 0) {
+                    for (i = 0; i < lss; ++i) {
+                        *(pKeffcp+i) = *(pKeff+i);
+                    }
+                    
+                    for (i = 0; i < NEQ; ++i) {
+                        *(pdd+i) = *(pr+i);
+                        if (histval(ppdisp_h, ppdisp, i, k) != 0) {
+                            *(pReff+i) = histval(ppdisp_h, ppdisp, i, k);
+                        }
+                    }
+                    // Partition and factorize Keff matrix
+                    if (SLVFLAG == 0) {
+                        matpart (pmaxa, ppart, pKeffcp, pReff, pum, pij);
+                        itflag = amgfact (pmaxa, pKeffcp, pdet);
+                        bndflag = bandfact (pmaxa, pKeffcp, pab, pssd, pdet);
+                        mixflag = mixfact (pmaxa, pKeffcp, pssd, pdet);
+                        if (itflag == 0 && bndflag == 0 && mixflag == 0) {
+                            skyfact(pmaxa, pKeffcp, pssd, pdd, fact, pdet);
+                        }
+                    }
+                    else if (SLVFLAG == 1) {
+                        matpartd (pKeffcp, pReff, pum, pii, pij);
+                        lapflag = lapfact (pKeffcp, pipiv, pssd, pdet);
+                    }
+                    else if (SLVFLAG == 2) {
+                        matpart (pmaxa, ppart, pKeffcp, pReff, pum, pij);
+                        sparsefact (pmaxa, pKeffcp, pAp, pAi, pAx, &Numeric, a0*(1-alpham)/(1-alphaf));
+                    }
+                    else if (SLVFLAG == 3) {
+                        matpart (pmaxa, ppart, pKeffcp, pReff, pum, pij);
+                        if (cholfact (pmaxa, pKeffcp, pAp, pAi, pAx, pssd, pdet) < 0) {
+                            err = 1;
+                        }
+                    }
+                    if (itflag < 0 || mixflag < 0 || lapflag < 0 || err == 1) {
+                        err = 1;
+                        break;
+                    }
+                    
+                    // Solve for displacements at current time step
+                    if (SLVFLAG == 0 && itflag == 1) {
+                        itflag = amgsolve (pmaxa, pKeffcp, pssd, pReff, pdet);
+                    }
+                    else if (SLVFLAG == 0 && bndflag == 1) {
+                        bandsolve (pab, pReff);
+                    }
+                    else if (SLVFLAG == 0 && mixflag == 1) {
+                        mixflag = mixsolve (pmaxa, pKeffcp, pssd, pReff, pdet);
+                    }
+                    else if (SLVFLAG == 0) {
+                        skysolve (pmaxa, pKeffcp, pssd, pReff, fact, pdet);
+                    }
+                    else if (SLVFLAG == 1) {
+                        lapsolve (pKeffcp, pipiv, pReff, lapflag);
+                    }
+                    else if (SLVFLAG == 2) {
+                        (void) umfpack_di_solve (UMFPACK_A, pAp, pAi, pAx, puc, pReff, Numeric, null, null);
+                    }
+                    else if (SLVFLAG == 3) {
+                        cholsolve (pReff);
+                    }
+                    
+                    for (i = 0; i < lss; ++i) {
+                        *(pKeffcp+i) = *(pKeff+i);
+                    }
+                    
+                } else {
+                    if (ANAFLAG == 4 && SLVFLAG == 0 && ITFLAG == 1) {
+                        err = fsigmres (pmaxa, pss, psm, psd_fsi, pKeff, pReff, pum, a0*(1-alpham)/(1-alphaf), a1);
+                    }
+                    else if (ANAFLAG == 4 && SLVFLAG == 0) {
+                        err = fsisolve (pmaxa, pKeff, pReff, pum, a0*(1-alpham)/(1-alphaf));
+                    }
+                    else if (SLVFLAG == 0 && itflag == 1) {
+                        itflag = amgsolve (pmaxa, pKeff, pssd, pReff, pdet);
+                    }
+                    else if (SLVFLAG == 0 && bndflag == 1) {
+                        bandsolve (pab, pReff);
+                    }
+                    else if (SLVFLAG == 0 && mixflag == 1) {
+                        mixflag = mixsolve (pmaxa, pKeff, pssd, pReff, pdet);
+                    }
+                    else if (SLVFLAG == 0) {
+                        skysolve (pmaxa, pKeff, pssd, pReff, fact, pdet);
+                    }
+                    else if (SLVFLAG == 1) {
+                        lapsolve (pKeff, pipiv, pReff, lapflag);
+                    }
+                    else if (SLVFLAG == 2) {
+                        (void) umfpack_di_solve (UMFPACK_A, pAp, pAi, pAx, puc, pReff, Numeric, null, null);
+                    }
+                    else if (SLVFLAG == 3) {
+                        cholsolve (pReff);
+                    }
+                }
+                if (itflag < 0 || mixflag < 0 || err < 0) {
+                    err = 1;
+                    break;
+                }
+                
+                // The loads of the time step are undefined if the load history was not read
+                if (histfail (pqdyn_h) == 1 || histfail (ppdisp_h) == 1) {
+                    err = 1;
+                    break;
+                }
+                
+                if (SLVFLAG != 2) {
+                    for (i = 0; i < NEQ; ++i) {
+                        *(puc+i) = *(pReff+i);
+                    }
+                }
+                
+                // Calculate current velocities and accelerations
+                for (i = 0; i < NEQ; ++i) {
+                    *(pac+i) = a0*(*(puc+i) - *(pum+i)) - a2*(*(pvm+i)) - a3*(*(pam+i));
+                    *(pvc+i) = *(pvm+i) + a6*(*(pam+i)) + a7*(*(pac+i));
+                }
+                
+                time = k*dt;
+                // Pass control to output function
+                output (&time, &dum, puc, puc, 1);
+                
+                // Assign current u, v, a to be the previous values
+                for (i = 0; i < NEQ; ++i) {
+                    *(pum+i) = *(puc+i);
+                    *(pvm+i) = *(pvc+i);
+                    *(pam+i) = *(pac+i);
+                }
+                
+                if (CHKPT != 0 && (k % CHKPT == 0) && (k != 0)){ // CHKPT == 0 writes no checkpoint files
+                    sprintf(file, "results8.txt");
+                    do {
+                        OFP[7] = fopen(file, "w"); // Open last successful checkpoint file
+                    } while (OFP[7] == 0);
+                    
+                    // Read in restart time step
+                    fprintf(OFP[7], "%ld\n", k);
+                    
+                    // Print displacements, velocities, and accelerations
+                    for (i = 0; i < NEQ; ++i) {
+                        fprintf(OFP[7], "%le,%le,%le\n", *(pum+i), *(pvm+i), *(pam+i));
+                    }
+                    
+                    // Signal the end of displacements, velocities, and accelerations
+                    fprintf (OFP[7], "%d,%d,%d\n", 0, 0, 0);
+                    
+                    fclose(OFP[7]);
+                }
+            }
+            
+            if (SLVFLAG == 2) {
+                umfpack_di_free_numeric (&Numeric);
+            }
+            else if (SLVFLAG == 3) {
+                cholfree ();
+            }
+            
+            if (pKeffcp != NULL) {
+                free_dbl (pKeffcp);
+                pKeffcp = NULL;
+            }
+            if (err == 1) {
+                statend (ST_SOLVE, 0);
+                return 1;
+            }
+            
+        } else if (ALGFLAG == 5){ //Dynamic: nonlinear Newmark Intergration Method
+            
+            
+            // Initialize Reff for new time step to zero
+            for (i = 0; i < NEQ; ++i) {
+                *(pReff+i) = 0;
+            }
+            
+            /* Compute the equivalent change in dynamic external force vector; for non-FSI
+             analyses both solvers use the lumped (row-summed) mass vector psml */
+            if (ANAFLAG != 4) { // Non-FSI analysis
+                for (i = 0; i < NEQ; ++i){
+                    if (histval(ppdisp_h, ppdisp, i, tstp) != 0 && *(piter) > 0) {
+                        *(pReff+i) = 0;
+                    }else if (histval(ppdisp_h, ppdisp, i, tstp) != 0 && *(piter) == 0){
+                        *(pReff+i) = *(pum+i);
+                    }else {
+                        *(pReff+i) = *(pr+i) + *(psml+i)*((1-alpham)*((*(pvm+i))*a2+(*(pam+i))*a3)-alpham*(*(pam+i)))/(1-alphaf);
+                    }
+                }
+            }else { // FSI analysis, using CLAPACK or UMFPACK solver
+                for (i = 0; i < NEQ; ++i) {
+                    sum = 0;
+                    for (j = 0; j < NEQ; ++j) {
+                        sum += *(psm+i*NEQ+j);
+                    }
+                    if (histval(ppdisp_h, ppdisp, i, tstp) != 0 && *(piter) > 0) {
+                        *(pReff+i) = 0;
+                    }else if (histval(ppdisp_h, ppdisp, i, tstp) != 0 && *(piter) == 0){
+                        *(pReff+i) = *(pum+i);
+                    }else {
+                        *(pReff+i) = *(pr+i)+sum*((1-alpham)*((*(pvm+i))*a2+(*(pam+i))*a3)-alpham*(*(pam+i)))/(1-alphaf);
+                    }
+                }
+            }
+            
+            if (NBC != 0) {
+                // Pass residual array to the incremental displacements array
+                for (i = 0; i < NEQ; ++i) {
+                    *(pdd+i) = *(pr+i);
+                }
+                // Partition and factorize Keff matrix
+                if (SLVFLAG == 0) {
+                    matpart (pmaxa, ppart, pKeff, pReff, pum, pij);
+                    itflag = amgfact (pmaxa, pKeff, pdet);
+                    bndflag = bandfact (pmaxa, pKeff, pab, pssd, pdet);
+                    mixflag = mixfact (pmaxa, pKeff, pssd, pdet);
+                    if (itflag == 0 && bndflag == 0 && mixflag == 0) {
+                        skyfact(pmaxa, pKeff, pssd, pdd, fact, pdet);
+                    }
+                }
+                else if (SLVFLAG == 1) {
+                    matpartd (pKeff, pReff, pum, pii, pij);
+                    lapflag = lapfact (pKeff, pipiv, pssd, pdet);
+                }
+                else if (SLVFLAG == 2) {
+                    matpart (pmaxa, ppart, pKeff, pReff, pum, pij);
+                    sparsefact (pmaxa, pKeff, pAp, pAi, pAx, &Numeric, a0*(1-alpham)/(1-alphaf));
+                }
+                else if (SLVFLAG == 3) {
+                    matpart (pmaxa, ppart, pKeff, pReff, pum, pij);
+                    if (cholfact (pmaxa, pKeff, pAp, pAi, pAx, pssd, pdet) < 0) {
+                        err = 1;
+                    }
+                }
+                if (itflag < 0 || mixflag < 0 || lapflag < 0 || err == 1) {
+                    statend (ST_SOLVE, 0);
+                    return 1;
+                }
+            }
+            
+            /*Compute displacement*/
+            // Solve for displacements at each iteration
+            if (SLVFLAG == 0 && itflag == 1) {
+                itflag = amgsolve (pmaxa, pKeff, pssd, pReff, pdet);
+            }
+            else if (SLVFLAG == 0 && bndflag == 1) {
+                bandsolve (pab, pReff);
+            }
+            else if (SLVFLAG == 0 && mixflag == 1) {
+                mixflag = mixsolve (pmaxa, pKeff, pssd, pReff, pdet);
+            }
+            else if (SLVFLAG == 0) {
+                skysolve (pmaxa, pKeff, pssd, pReff, fact, pdet);
+            }
+            else if (SLVFLAG == 1) {
+                lapsolve (pKeff, pipiv, pReff, lapflag);
+            }
+            else if (SLVFLAG == 3) {
+                cholsolve (pReff);
+            }
+            if (itflag < 0 || mixflag < 0) {
+                statend (ST_SOLVE, 0);
+                return 1;
+            }
+            
+            //Pass displacement to main for Newton-Raphson iteration
+            if (SLVFLAG == 2) {
+                (void) umfpack_di_solve (UMFPACK_A, pAp, pAi, pAx, pdd, pReff, Numeric, null, null);
+            } else {
+                for (i = 0; i < NEQ; ++i) {
+                    *(pdd+i) = *(pReff+i);
+                }
+            }
+        }
+    }
+    statend (ST_SOLVE, 0);
+    return err;
+}
+
+
+int skyfact (long *pmaxa, double *pss_temp, double *pssd, double *pdd, int fact, int *pdet)
+{
+    
+    // Initialize function variables
+    long n, kn, kl, ku, kh, k, ic, klt, j, ki, nd, kk, l, pf;
+    double b, c;
+    
+    /* Initialize determinant sign flag to zero; zero indicates a positive definite
+     stiffness matrix */
+    *pdet = 0;
+    // Perform LDL^t factorization of the stiffness matrix
+    if (fact == 0) {
+        statbeg (ST_SKYFACT);
+        pf = 0;
+        for (n = 1; n <= NEQ; ++n) {
+            kn = *(pmaxa+n-1);
+            /* Out-of-core skyline: once the columns enter a new panel, read the panel
+             after it ahead while the current one is factorized */
+            if (OOCFLAG == 1 && kn >= pf) {
+                if (pf == 0) {
+                    map_prefetch (pss_temp, 0, OOCPNL);
+                }
+                map_prefetch (pss_temp, pf+OOCPNL, pf+2*OOCPNL);
+                pf += OOCPNL;
+            }
+            kl = kn + 1;
+            ku = *(pmaxa+n) - 1;
+            kh = ku - kl;
+            
+            if (kh < 0) {
+                if (ALGFLAG != 3 && *(pss_temp+kn-1) <= 0) {
+                    fprintf(OFP[0], "\n***ERROR*** Non-positive definite stiffness");
+                    fprintf(OFP[0], " matrix\n");
+                    statend (ST_SKYFACT, 0);
+                    return 1;
+                    
+                } else if (ALGFLAG == 3) {
+                    *(pssd+n-1) = *(pss_temp+kn-1);
+                    if (*(pss_temp+kn-1) == 0) {
+                        fprintf(OFP[0], "\n***ERROR*** Singular stiffness matrix\n");
+                        statend (ST_SKYFACT, 0);
+                    return 1;
+                    } else if (*(pss_temp+kn-1) > 0 && *pdet != 1) {
+                        *pdet = 0;
+                    } else {
+                        *pdet = 1;
+                    }
+                }
+            } else if (kh > 0) {
+                k = n - kh;
+                ic = 0;
+                klt = ku;
+                for (j = 1; j <= kh; ++j) {
+                    ic++;
+                    klt--;
+                    ki = *(pmaxa+k-1);
+                    
+                    nd = *(pmaxa+k) - ki - 1;
+                    if (nd > 0) {
+                        if (nd < ic) {
+                            kk = nd;
+                        } else {
+                            kk = ic;
+                        }
+                        c = 0;
+                        for (l = 1; l <= kk; ++l) {
+                            c += *(pss_temp+ki-1+l) * (*(pss_temp+klt-1+l));
+                        }
+                        *(pss_temp+klt-1) -= c;
+                    }
+                    k++;
+                }
+                k = n;
+                b = 0;
+                for (kk = kl; kk <= ku; ++kk) {
+                    k--;
+                    ki = *(pmaxa+k-1);
+                    c = *(pss_temp+kk-1) / *(pss_temp+ki-1);
+                    b += c * (*(pss_temp+kk-1));
+                    *(pss_temp+kk-1) = c;
+                }
+                *(pss_temp+kn-1) -= b;
+                if (ALGFLAG != 3 && *(pss_temp+kn-1) <= 0) {
+                    fprintf(OFP[0], "\n***ERROR*** Non-positive definite stiffness");
+                    fprintf(OFP[0], " matrix\n");
+                    statend (ST_SKYFACT, 0);
+                    return 1;
+                } else if (ALGFLAG == 3) {
+                    *(pssd+n-1) = *(pss_temp+kn-1);
+                    if (*(pss_temp+kn-1) == 0) {
+                        fprintf(OFP[0], "\n***ERROR*** Singular stiffness matrix\n");
+                        statend (ST_SKYFACT, 0);
+                    return 1;
+                    } else if (*(pss_temp+kn-1) > 0 && *pdet != 1) {
+                        *pdet = 0;
+                    } else {
+                        *pdet = 1;
+                    }
+                }
+            } else if (kh == 0) {
+                k = n;
+                b = 0;
+                for (kk = kl; kk <= ku; ++kk) {
+                    k--;
+                    ki = *(pmaxa+k-1);
+                    c = *(pss_temp+kk-1) / *(pss_temp+ki-1);
+                    b += c * (*(pss_temp+kk-1));
+                    *(pss_temp+kk-1) = c;
+                }
+                *(pss_temp+kn-1) -= b;
+                if (ALGFLAG != 3 && *(pss_temp+kn-1) <= 0) {
+                    fprintf(OFP[0], "\n***ERROR*** Non-positive definite stiffness");
+                    fprintf(OFP[0], " matrix\n");
+                    statend (ST_SKYFACT, 0);
+                    return 1;
+                } else if (ALGFLAG == 3) {
+                    *(pssd+n-1) = *(pss_temp+kn-1);
+                    if (*(pss_temp+kn-1) == 0) {
+                        fprintf(OFP[0], "\n***ERROR*** Singular stiffness matrix\n");
+                        statend (ST_SKYFACT, 0);
+                    return 1;
+                    } else if (*(pss_temp+kn-1) > 0 && *pdet != 1) {
+                        *pdet = 0;
+                    } else {
+                        *pdet = 1;
+                    }
+                }
+            }
+        }
+        statend (ST_SKYFACT, statsky (pmaxa, 0));
+    }
+    return 0;
+}
+
+int skysolve (long *pmaxa, double *pss_temp, double *pssd, double *pdd, int fact, int *pdet)
+{
+    
+    // Initialize function variables
+    long i, n, kl, ku, kh, k, kk, pf;
+    double c;
+    
+    statbeg (ST_SKYSOLVE);
+    
+    // Reduce right-hand-side load vector
+    pf = 0;
+    for (n = 1; n <= NEQ; ++n) {
+        kl = *(pmaxa+n-1) + 1;
+        /* Out-of-core skyline: read the panel after the current one ahead (backward in
+         the back-substitution) */
+        if (OOCFLAG == 1 && kl-1 >= pf) {
+            if (pf == 0) {
+                map_prefetch (pss_temp, 0, OOCPNL);
+            }
+            map_prefetch (pss_temp, pf+OOCPNL, pf+2*OOCPNL);
+            pf += OOCPNL;
+        }
+        ku = *(pmaxa+n) - 1;
+        kh = ku - kl;
+        if (kh >= 0) {
+            k = n;
+            c = 0;
+            for (kk = kl; kk <= ku; ++kk) {
+                k--;
+                c += *(pss_temp+kk-1) * (*(pdd+k-1));
+            }
+            *(pdd+n-1) -= c;
+        }
+    }
+    
+    // Back-substitute
+    for (n = 0; n < NEQ; ++n) {
+        k = *(pmaxa+n);
+        *(pdd+n) /= (*(pss_temp+k-1));
+    }
+    n = NEQ;
+    pf = *(pmaxa+NEQ) - 1;
+    for (i = 2; i <= NEQ; ++i) {
+        kl = *(pmaxa+n-1) + 1;
+        ku = *(pmaxa+n) - 1;
+        if (OOCFLAG == 1 && ku <= pf) {
+            if (pf == *(pmaxa+NEQ) - 1) {
+                map_prefetch (pss_temp, (pf > OOCPNL) ? pf-OOCPNL : 0, pf);
+            }
+            if (pf > OOCPNL) {
+                map_prefetch (pss_temp, (pf > 2*OOCPNL) ? pf-2*OOCPNL : 0, pf-OOCPNL);
+            }
+            pf -= OOCPNL;
+        }
+        kh = ku - kl;
+        if (kh >= 0) {
+            k = n;
+            for (kk = kl; kk <= ku; ++kk) {
+                k--;
+                *(pdd+k-1) -= *(pss_temp+kk-1) * (*(pdd+n-1));
+            }
+        }
+        n--;
+    }
+    statend (ST_SKYSOLVE, statsky (pmaxa, 1));
+    return 0;
+}
+
+int skyrange (long *pmaxa, double *pss_temp, double *pdd, long lo, long hi)
+{
+    
+    // Initialize function variables
+    long n, k, kk;
+    double c;
+    
+    /* Reduce and back-substitute as in skysolve for the equations lo to hi-1 (0-based) only;
+     the columns of the range do not reach above lo */
+    for (n = lo; n < hi; ++n) {
+        k = n;
+        c = 0;
+        for (kk = *(pmaxa+n)+1; kk < *(pmaxa+n+1); ++kk) {
+            k--;
+            c += *(pss_temp+kk-1) * (*(pdd+k));
+        }
+        *(pdd+n) -= c;
+    }
+    for (n = lo; n < hi; ++n) {
+        *(pdd+n) /= (*(pss_temp+*(pmaxa+n)-1));
+    }
+    for (n = hi-1; n > lo; --n) {
+        k = n;
+        for (kk = *(pmaxa+n)+1; kk < *(pmaxa+n+1); ++kk) {
+            k--;
+            *(pdd+k) -= *(pss_temp+kk-1) * (*(pdd+n));
+        }
+    }
+    return 0;
+}
+
+int zskyfact (long neq, long *pmaxa, double *pa)
+{
+    
+    // Initialize function variables
+    long n, i, r, r0, x, y, kn, top;
+    double cr, ci, br, bi, d;
+    
+    /* LDL^t factorization of a complex symmetric skyline matrix, with the real and imaginary
+     parts of each entry interleaved, as in skyfact (0-based); the number of equations is
+     passed as an argument, so that the function may be called within a parallel region
+     (see BEN_TLS) */
+    for (n = 0; n < neq; ++n) {
+        kn = *(pmaxa+n);
+        top = n - (*(pmaxa+n+1) - kn - 1);
+        
+        // Reduce the entries of column n by the columns already factorized
+        for (i = top+1; i < n; ++i) {
+            r0 = i - (*(pmaxa+i+1) - *(pmaxa+i) - 1);
+            if (r0 < top) {
+                r0 = top;
+            }
+            cr = ci = 0;
+            for (r = r0; r < i; ++r) {
+                x = 2*(*(pmaxa+i) + i - r - 1);
+                y = 2*(kn + n - r - 1);
+                cr += *(pa+x) * (*(pa+y)) - *(pa+x+1) * (*(pa+y+1));
+                ci += *(pa+x) * (*(pa+y+1)) + *(pa+x+1) * (*(pa+y));
+            }
+            y = 2*(kn + n - i - 1);
+            *(pa+y) -= cr;
+            *(pa+y+1) -= ci;
+        }
+        
+        // Divide by the pivots and reduce the diagonal
+        br = bi = 0;
+        for (i = top; i < n; ++i) {
+            x = 2*(*(pmaxa+i) - 1);
+            y = 2*(kn + n - i - 1);
+            d = *(pa+x) * (*(pa+x)) + *(pa+x+1) * (*(pa+x+1));
+            cr = (*(pa+y) * (*(pa+x)) + *(pa+y+1) * (*(pa+x+1))) / d;
+            ci = (*(pa+y+1) * (*(pa+x)) - *(pa+y) * (*(pa+x+1))) / d;
+            br += cr * (*(pa+y)) - ci * (*(pa+y+1));
+            bi += cr * (*(pa+y+1)) + ci * (*(pa+y));
+            *(pa+y) = cr;
+            *(pa+y+1) = ci;
+        }
+        x = 2*(kn - 1);
+        *(pa+x) -= br;
+        *(pa+x+1) -= bi;
+        if (*(pa+x) == 0 && *(pa+x+1) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void zskysolve (long neq, long *pmaxa, double *pa, double *pv)
+{
+    
+    // Initialize function variables
+    long n, i, x, kn, top;
+    double cr, ci, d, t;
+    
+    // Reduce the complex right-hand side vector
+    for (n = 0; n < neq; ++n) {
+        kn = *(pmaxa+n);
+        top = n - (*(pmaxa+n+1) - kn - 1);
+        cr = ci = 0;
+        for (i = top; i < n; ++i) {
+            x = 2*(kn + n - i - 1);
+            cr += *(pa+x) * (*(pv+2*i)) - *(pa+x+1) * (*(pv+2*i+1));
+            ci += *(pa+x) * (*(pv+2*i+1)) + *(pa+x+1) * (*(pv+2*i));
+        }
+        *(pv+2*n) -= cr;
+        *(pv+2*n+1) -= ci;
+    }
+    
+    // Divide by the pivots and back-substitute
+    for (n = 0; n < neq; ++n) {
+        x = 2*(*(pmaxa+n) - 1);
+        d = *(pa+x) * (*(pa+x)) + *(pa+x+1) * (*(pa+x+1));
+        t = (*(pv+2*n) * (*(pa+x)) + *(pv+2*n+1) * (*(pa+x+1))) / d;
+        *(pv+2*n+1) = (*(pv+2*n+1) * (*(pa+x)) - *(pv+2*n) * (*(pa+x+1))) / d;
+        *(pv+2*n) = t;
+    }
+    for (n = neq-1; n > 0; --n) {
+        kn = *(pmaxa+n);
+        top = n - (*(pmaxa+n+1) - kn - 1);
+        for (i = top; i < n; ++i) {
+            x = 2*(kn + n - i - 1);
+            *(pv+2*i) -= *(pa+x) * (*(pv+2*n)) - *(pa+x+1) * (*(pv+2*n+1));
+            *(pv+2*i+1) -= *(pa+x) * (*(pv+2*n+1)) + *(pa+x+1) * (*(pv+2*n));
+        }
+    }
+}
+
+int mixfact (long *pmaxa, double *pss, double *pssd, int *pdet)
+{
+    
+    // Initialize function variables
+    long i, n, kn, kl, ku, kh, k, ic, klt, j, ki, nd, kk, l;
+    double b, c;
+    
+    if (MPFLAG == 0 || mpstall == 1) {
+        return 0;
+    }
+    
+    /* Copy the skyline matrix into single precision on the first call; the length of the
+     skyline array does not change during the analysis */
+    if (pssf == NULL) {
+        pssf = alloc_flt (*(pmaxa+NEQ)-1);
+        if (pssf == NULL) {
+            return -1;
+        }
+    }
+    for (i = 0; i < *(pmaxa+NEQ)-1; ++i) {
+        *(pssf+i) = (float) *(pss+i);
+    }
+    
+    /* Infinity norm of the double precision matrix (the row sums of the upper triangle and
+     of the lower triangle by symmetry) for the convergence criterion of mixsolve */
+    double *prow = alloc_dbl (NEQ);
+    if (prow == NULL) {
+        return -1;
+    }
+    for (i = 0; i < NEQ; ++i) {
+        *(prow+i) = 0;
+    }
+    for (n = 0; n < NEQ; ++n) {
+        for (kk = *(pmaxa+n); kk < *(pmaxa+n+1); ++kk) {
+            k = n - (kk - *(pmaxa+n));
+            *(prow+n) += fabs(*(pss+kk-1));
+            if (k != n) {
+                *(prow+k) += fabs(*(pss+kk-1));
+            }
+        }
+    }
+    mpnrm = 0;
+    for (i = 0; i < NEQ; ++i) {
+        if (*(prow+i) > mpnrm) {
+            mpnrm = *(prow+i);
+        }
+    }
+    free (prow);
+    
+    /* Perform the LDL^t factorization of skyfact in single precision, accumulating the
+     inner products in double precision; a non-positive pivot returns control to the
+     double precision factorization, which also determines the inertia of the matrix */
+    for (n = 1; n <= NEQ; ++n) {
+        kn = *(pmaxa+n-1);
+        kl = kn + 1;
+        ku = *(pmaxa+n) - 1;
+        kh = ku - kl;
+        
+        if (kh > 0) {
+            k = n - kh;
+            ic = 0;
+            klt = ku;
+            for (j = 1; j <= kh; ++j) {
+                ic++;
+                klt--;
+                ki = *(pmaxa+k-1);
+                nd = *(pmaxa+k) - ki - 1;
+                if (nd > 0) {
+                    if (nd < ic) {
+                        kk = nd;
+                    } else {
+                        kk = ic;
+                    }
+                    c = 0;
+                    for (l = 1; l <= kk; ++l) {
+                        c += (double) *(pssf+ki-1+l) * (*(pssf+klt-1+l));
+                    }
+                    *(pssf+klt-1) -= c;
+                }
+                k++;
+            }
+        }
+        if (kh >= 0) {
+            k = n;
+            b = 0;
+            for (kk = kl; kk <= ku; ++kk) {
+                k--;
+                ki = *(pmaxa+k-1);
+                c = *(pssf+kk-1) / (double) *(pssf+ki-1);
+                b += c * (*(pssf+kk-1));
+                *(pssf+kk-1) = c;
+            }
+            *(pssf+kn-1) -= b;
+        }
+        if (*(pssf+kn-1) <= 0) {
+            return 0;
+        }
+        if (ALGFLAG == 3) {
+            *(pssd+n-1) = *(pssf+kn-1);
+        }
+    }
+    *pdet = 0;
+    
+    return 1;
+}
+
+int mixsolve (long *pmaxa, double *pss, double *pssd, double *pdd, int *pdet)
+{
+    
+    // Initialize function variables
+    long i, it, n, kl, ku, k, kk;
+    double c, xnrm, rnrm, rnrmp;
+    
+    double *pb = alloc_dbl (NEQ);
+    double *px = alloc_dbl (NEQ);
+    double *pw = alloc_dbl (NEQ);
+    if (pb == NULL || px == NULL || pw == NULL) {
+        return -1;
+    }
+    for (i = 0; i < NEQ; ++i) {
+        *(pb+i) = *(pw+i) = *(pdd+i);
+        *(px+i) = 0;
+    }
+    
+    /* Iterative refinement: the correction is solved for with the single precision factor
+     and the residual is computed with the double precision matrix, until the residual
+     meets the backward error criterion of LAPACK's dsgesv */
+    rnrmp = HUGE_VAL;
+    for (it = 0; it < 30; ++it) {
+        
+        // Reduce the residual vector and back-substitute with the single precision factor
+        for (n = 1; n <= NEQ; ++n) {
+            kl = *(pmaxa+n-1) + 1;
+            ku = *(pmaxa+n) - 1;
+            k = n;
+            c = 0;
+            for (kk = kl; kk <= ku; ++kk) {
+                k--;
+                c += *(pssf+kk-1) * (*(pw+k-1));
+            }
+            *(pw+n-1) -= c;
+        }
+        for (n = 0; n < NEQ; ++n) {
+            *(pw+n) /= *(pssf+*(pmaxa+n)-1);
+        }
+        for (n = NEQ; n >= 2; --n) {
+            kl = *(pmaxa+n-1) + 1;
+            ku = *(pmaxa+n) - 1;
+            k = n;
+            for (kk = kl; kk <= ku; ++kk) {
+                k--;
+                *(pw+k-1) -= *(pssf+kk-1) * (*(pw+n-1));
+            }
+        }
+        
+        // Update the solution and compute the residual
+        xnrm = 0;
+        for (i = 0; i < NEQ; ++i) {
+            *(px+i) += *(pw+i);
+            *(pw+i) = *(px+i);
+            if (fabs(*(px+i)) > xnrm) {
+                xnrm = fabs(*(px+i));
+            }
+        }
+        if (skymult (pmaxa, pss, pw) < 0) {
+            free (pb);
+            free (px);
+            free (pw);
+            return -1;
+        }
+        rnrm = 0;
+        for (i = 0; i < NEQ; ++i) {
+            *(pw+i) = *(pb+i) - *(pw+i);
+            if (fabs(*(pw+i)) > rnrm) {
+                rnrm = fabs(*(pw+i));
+            }
+        }
+        
+        if (rnrm <= xnrm * mpnrm * DBL_EPSILON * sqrt((double) NEQ)) {
+            for (i = 0; i < NEQ; ++i) {
+                *(pdd+i) = *(px+i);
+            }
+            free (pb);
+            free (px);
+            free (pw);
+            return 1;
+        }
+        
+        // The refinement has stalled if the residual is not at least halved
+        if (rnrm > 0.5 * rnrmp) {
+            break;
+        }
+        rnrmp = rnrm;
+    }
+    
+    /* Factorize the double precision matrix in place and solve with it; the single
+     precision factorization is not used for the remainder of the analysis */
+    fprintf(OFP[0], "\n***WARNING*** Mixed precision refinement stalled; continuing in double precision\n");
+    mpstall = 1;
+    for (i = 0; i < NEQ; ++i) {
+        *(pdd+i) = *(pb+i);
+    }
+    skyfact(pmaxa, pss, pssd, pdd, 0, pdet);
+    skysolve (pmaxa, pss, pssd, pdd, 0, pdet);
+    free (pb);
+    free (px);
+    free (pw);
+    
+    return 0;
+}
+
+void lrelem (long *pmcode, int *pyldflag, int *pyv)
+{
+    
+    // Keep the arrays, which lrfact reads at each call
+    plrmc = pmcode;
+    plryf = pyldflag;
+    plryv = pyv;
+}
+
+int lrfact (long *pmaxa, double *pss, double *pKeff, double *pssd, int *pdet)
+{
+    
+    // Initialize function variables
+    long i, j, k, n, r, kk, a, b, c, s, ptr;
+    int m, info = 1, det, flip;
+    double d;
+    
+    if (LRMAX == 0) {
+        return 0;
+    }
+    
+    /* Allocate the arrays of the update on the first call; if memory is not available the
+     matrix is refactorized at each call instead */
+    if (plrv == NULL) {
+        plrv = alloc_dbl (LRMAX*LRMAX);
+        plrd = alloc_dbl (LRMAX*LRMAX);
+        plrg = alloc_dbl (LRMAX*LRMAX);
+        plrw = alloc_dbl (NEQ+LRMAX);
+        plrs = alloc_long (LRMAX);
+        plrm = alloc_long (NEQ);
+        plrp = alloc_int (LRMAX);
+        plre = alloc_int (NE_FR*2+NE_SH);
+        if (plrv == NULL || plrd == NULL || plrg == NULL || plrw == NULL || plrs == NULL ||
+            plrm == NULL || plrp == NULL || plre == NULL) {
+            free (plrv);
+            free (plrd);
+            free (plrg);
+            free (plrw);
+            free (plrs);
+            free (plrm);
+            free (plrp);
+            free (plre);
+            plrv = NULL;
+            LRMAX = 0;
+            return 0;
+        }
+    }
+    *pdet = 0;
+    lrdir = 0;
+    
+    /* Add to the updated equations those of the frame and shell elements whose yield state
+     changed since the last factorization; the other changes of the matrix, i.e. of the
+     geometric stiffness, are left to the conjugate gradient iterations of lrsolve */
+    s = (lrit > LRREFIT) ? -1 : lrs;
+    if (s >= 0 && plrmc != NULL) {
+        for (n = 0; n < NE_FR+NE_SH && s <= LRMAX; ++n) {
+            if (n < NE_FR) {
+                flip = (*(plryf+n*2) != *(plre+n*2) || *(plryf+n*2+1) != *(plre+n*2+1));
+                ptr = NE_TR*6 + n*14;
+                c = 14;
+            } else {
+                flip = (*(plryv+n-NE_FR) != *(plre+NE_FR+n));
+                ptr = NE_TR*6 + NE_FR*14 + (n-NE_FR)*18;
+                c = 18;
+            }
+            for (k = 0; k < c && flip == 1; ++k) {
+                j = *(plrmc+ptr+k) - 1;
+                if (j >= 0 && *(plrm+j) < 0) {
+                    if (s < LRMAX) {
+                        *(plrm+j) = s;
+                        *(plrs+s) = j;
+                    }
+                    s++;
+                }
+            }
+        }
+    }
+    
+    if (s >= 0 && s <= LRMAX) {
+        /* Block S = U^t K0^-1 U of the inverse of the factorized matrix K0 over the updated
+         equations, U selecting them; one column is solved for each equation added */
+        for (a = lrs; a < s; ++a) {
+            for (i = 0; i < NEQ; ++i) {
+                *(plrw+i) = 0;
+            }
+            *(plrw+*(plrs+a)) = 1;
+            skysolve (pmaxa, pKeff, pssd, plrw, 1, &det);
+            for (b = 0; b < s; ++b) {
+                *(plrv+a*LRMAX+b) = *(plrv+b*LRMAX+a) = *(plrw+*(plrs+b));
+            }
+        }
+        lrs = s;
+        
+        /* Change of the matrix over the updated equations, D = U^t (K - K0) U, in column-major
+         order; the coefficients of K0 are recovered from its factors L D0 L^t */
+        for (b = 0; b < s; ++b) {
+            for (a = 0; a <= b; ++a) {
+                i = *(plrs+a);
+                j = *(plrs+b);
+                if (i > j) {
+                    k = i;
+                    i = j;
+                    j = k;
+                }
+                d = 0;
+                if (j - i < *(pmaxa+j+1) - *(pmaxa+j)) {
+                    kk = *(pmaxa+j) - 1 + j - i;
+                    d = *(pss+kk) - *(pKeff+*(pmaxa+i)-1) * ((i == j) ? 1 : *(pKeff+kk));
+                    r = j - (*(pmaxa+j+1) - *(pmaxa+j)) + 1;
+                    if (r < i - (*(pmaxa+i+1) - *(pmaxa+i)) + 1) {
+                        r = i - (*(pmaxa+i+1) - *(pmaxa+i)) + 1;
+                    }
+                    for (; r < i; ++r) {
+                        d -= *(pKeff+*(pmaxa+i)-1+i-r) * (*(pKeff+*(pmaxa+r)-1)) *
+                            (*(pKeff+*(pmaxa+j)-1+j-r));
+                    }
+                }
+                *(plrd+b*s+a) = *(plrd+a*s+b) = d;
+            }
+        }
+        
+        // Capacitance matrix I + D S, in column-major order
+        for (b = 0; b < s; ++b) {
+            for (a = 0; a < s; ++a) {
+                d = (a == b) ? 1 : 0;
+                for (c = 0; c < s; ++c) {
+                    d += *(plrd+c*s+a) * (*(plrv+b*LRMAX+c));
+                }
+                *(plrg+b*s+a) = d;
+            }
+        }
+        info = 0;
+        if (s > 0) {
+            m = s;
+            dgetrf_(&m, &m, plrg, &m, plrp, &info);
+        }
+    }
+    
+    /* Factorize the matrix if there is no factorization yet, if the last solution took more
+     than LRREFIT iterations, if the rank of the update would exceed LRMAX, or if the
+     capacitance matrix is singular */
+    if (info != 0) {
+        lrref (pmaxa, pss, pKeff, pssd, pdet);
+    }
+    
+    return 1;
+}
+
+void lrref (long *pmaxa, double *pss, double *pKeff, double *pssd, int *pdet)
+{
+    
+    // Initialize function variables
+    long i, n;
+    
+    /* Factorize the matrix into the effective stiffness array and keep the yield states of
+     the elements; a failed factorization is repeated at the next call */
+    for (i = 0; i < *(pmaxa+NEQ)-1; ++i) {
+        *(pKeff+i) = *(pss+i);
+    }
+    for (i = 0; i < NEQ; ++i) {
+        *(plrm+i) = -1;
+    }
+    if (plrmc != NULL) {
+        for (n = 0; n < NE_FR*2; ++n) {
+            *(plre+n) = *(plryf+n);
+        }
+        for (n = 0; n < NE_SH; ++n) {
+            *(plre+NE_FR*2+n) = *(plryv+n);
+        }
+    }
+    lrs = lrit = 0;
+    lrdir = 1;
+    if (skyfact (pmaxa, pKeff, pssd, NULL, 0, pdet) == 1) {
+        lrs = -1;
+    }
+}
+
+int lrprec (long *pmaxa, double *pKeff, double *pssd, double *pdd)
+{
+    
+    // Initialize function variables
+    long i, a, b;
+    int m, info, nrhs = 1, det;
+    char trans = 'N';
+    double *pw = plrw+NEQ;
+    
+    // Solve with the factorized matrix, y = K0^-1 b
+    for (i = 0; i < NEQ && lrs > 0; ++i) {
+        *(plrw+i) = *(pdd+i);
+    }
+    skysolve (pmaxa, pKeff, pssd, pdd, 1, &det);
+    
+    /* Apply the Woodbury formula for the update U D U^t of the factorized matrix,
+     x = K0^-1 (b - U w) with w = (I + D S)^-1 D U^t y */
+    if (lrs > 0) {
+        m = lrs;
+        for (a = 0; a < lrs; ++a) {
+            *(pw+a) = 0;
+            for (b = 0; b < lrs; ++b) {
+                *(pw+a) += *(plrd+b*lrs+a) * (*(pdd+*(plrs+b)));
+            }
+        }
+        dgetrs_(&trans, &m, &nrhs, plrg, &m, plrp, pw, &m, &info);
+        for (i = 0; i < NEQ; ++i) {
+            *(pdd+i) = *(plrw+i);
+        }
+        for (a = 0; a < lrs; ++a) {
+            *(pdd+*(plrs+a)) -= *(pw+a);
+        }
+        skysolve (pmaxa, pKeff, pssd, pdd, 1, &det);
+    }
+    
+    return 0;
+}
+
+int lrsolve (long *pmaxa, double *pss, double *pKeff, double *pssd, double *pdd, int *pdet)
+{
+    
+    // Initialize function variables
+    long i, it;
+    double rz, rzp, pq, alpha, bnrm, rnrm;
+    
+    // The matrix was factorized by lrfact
+    if (lrdir == 1) {
+        lrprec (pmaxa, pKeff, pssd, pdd);
+        return 1;
+    }
+    
+    double *pb = alloc_dbl (NEQ);
+    double *px = alloc_dbl (NEQ);
+    double *pr = alloc_dbl (NEQ);
+    double *pz = alloc_dbl (NEQ);
+    double *pp = alloc_dbl (NEQ);
+    double *pw = alloc_dbl (NEQ);
+    if (pb == NULL || px == NULL || pr == NULL || pz == NULL || pp == NULL || pw == NULL) {
+        return -1;
+    }
+    
+    /* The update only covers the elements which yielded or unloaded, so the system is solved
+     by conjugate gradients preconditioned by the updated factorization */
+    bnrm = 0;
+    for (i = 0; i < NEQ; ++i) {
+        *(pb+i) = *(pr+i) = *(pdd+i);
+        *(px+i) = 0;
+        bnrm += *(pb+i) * (*(pb+i));
+    }
+    bnrm = sqrt(bnrm);
+    rnrm = bnrm;
+    rzp = 1;
+    for (it = 0; it < LRMAXIT && rnrm > LRCGTOL * bnrm; ++it) {
+        for (i = 0; i < NEQ; ++i) {
+            *(pz+i) = *(pr+i);
+        }
+        lrprec (pmaxa, pKeff, pssd, pz);
+        rz = 0;
+        for (i = 0; i < NEQ; ++i) {
+            rz += *(pr+i) * (*(pz+i));
+        }
+        for (i = 0; i < NEQ; ++i) {
+            if (it == 0) {
+                *(pp+i) = *(pz+i);
+            } else {
+                *(pp+i) = *(pz+i) + rz / rzp * (*(pp+i));
+            }
+            *(pw+i) = *(pp+i);
+        }
+        rzp = rz;
+        if (skymult (pmaxa, pss, pw) < 0) {
+            free (pb);
+            free (px);
+            free (pr);
+            free (pz);
+            free (pp);
+            free (pw);
+            return -1;
+        }
+        pq = 0;
+        for (i = 0; i < NEQ; ++i) {
+            pq += *(pp+i) * (*(pw+i));
+        }
+        if (pq <= 0 || rz <= 0) {
+            break; // The matrix or its preconditioner is not positive definite
+        }
+        alpha = rz / pq;
+        rnrm = 0;
+        for (i = 0; i < NEQ; ++i) {
+            *(px+i) += alpha * (*(pp+i));
+            *(pr+i) -= alpha * (*(pw+i));
+            rnrm += *(pr+i) * (*(pr+i));
+        }
+        rnrm = sqrt(rnrm);
+    }
+    
+    lrit = it;
+    if (rnrm <= LRCGTOL * bnrm) {
+        for (i = 0; i < NEQ; ++i) {
+            *(pdd+i) = *(px+i);
+        }
+    } else {
+        /* The update no longer represents the matrix, which is factorized and solved with
+         directly; it is the reference of the following updates */
+        for (i = 0; i < NEQ; ++i) {
+            *(pdd+i) = *(pb+i);
+        }
+        lrref (pmaxa, pss, pKeff, pssd, pdet);
+        skysolve (pmaxa, pKeff, pssd, pdd, 1, pdet);
+    }
+    free (pb);
+    free (px);
+    free (pr);
+    free (pz);
+    free (pp);
+    free (pw);
+    
+    return 1;
+}
+
+int skymult (long *pmaxa, double *pss_temp, double *pdd)
+{
+    
+    // Initialize function variables
+    long i, n, k, kk, neq = NEQ;
+    int t, nt = 1;
+    double c, *pm;
+    
+#ifdef _OPENMP
+    nt = omp_get_max_threads();
+#endif
+    if (pmult == NULL || lmult < (nt+1)*NEQ) {
+        if (pmult != NULL) {
+            free (pmult);
+        }
+        pmult = alloc_dbl ((nt+1)*NEQ);
+        if (pmult == NULL) {
+            return -1;
+        }
+        lmult = (nt+1)*NEQ;
+    }
+    
+    /* The threads of the parallel region hold their own copies of the model state (see
+     BEN_TLS), so the number of equations and the workspace are passed to them as locals */
+    pm = pmult;
+    
+#pragma omp parallel private(i, n, k, kk, t, c) num_threads(nt)
+    {
+        t = 0;
+#ifdef _OPENMP
+        t = omp_get_thread_num();
+#endif
+        
+        // Initialize the accumulators of all threads to zero
+#pragma omp for schedule(static)
+        for (i = neq; i < (nt+1)*neq; ++i) {
+            *(pm+i) = 0;
+        }
+        
+        /* Compute the product in a single sweep over the columns of the skyline, split
+         among the threads in blocks: column n of the upper triangle is row n of the lower
+         triangle, so its dot product with the vector (and the diagonal term) is entry n of
+         the product, while the upper triangle terms are scattered into the accumulator of
+         the thread */
+#pragma omp for schedule(static)
+        for (n = 0; n < neq; ++n) {
+            c = *(pss_temp+*(pmaxa+n)-1) * (*(pdd+n));
+            k = n;
+            for (kk = *(pmaxa+n)+1; kk < *(pmaxa+n+1); ++kk) {
+                k--;
+                c += *(pss_temp+kk-1) * (*(pdd+k));
+                *(pm+(t+1)*neq+k) += *(pss_temp+kk-1) * (*(pdd+n));
+            }
+            *(pm+n) = c;
+        }
+        
+        // Add the accumulators of all threads to the product
+#pragma omp for schedule(static)
+        for (i = 0; i < neq; ++i) {
+            for (k = 1; k <= nt; ++k) {
+                *(pm+i) += *(pm+k*neq+i);
+            }
+        }
+    }
+    
+    for (i = 0; i < neq; ++i) {
+        *(pdd+i) = *(pm+i);
+    }
+    
+    return 0;
+}
+
+long matpartlist (long *pmaxa, long *ppmot, int *pii, int *pij, long *ppart)
+{
+    
+    // Initialize function variables
+    long i, n, kl, ku, kh, k, kk, np;
+    
+    /* Collect, in the order in which matpart applies them, the skyline entries coupling
+     a constrained DOF to any other DOF; each entry is stored as its skyline address, the
+     DOF of the right-hand side it modifies (-1 if none), and the DOF of the prescribed
+     displacement it is multiplied by. If ppart is NULL, the entries are only counted */
+    np = 0;
+    
+    // Columns of constrained DOFs (upper triangle)
+    for (i = NBC-1; i >= 0; --i) {
+        n = *(pij+i)+1;
+        kl = *(pmaxa+n-1) + 1;
+        ku = *(pmaxa+n) - 1;
+        kh = ku - kl;
+        if (kh >= 0) {
+            k = n-1;
+            for (kk = kl; kk <= ku; ++kk) {
+                k--;
+                if (ppart != NULL) {
+                    *(ppart+1+np*3) = kk;
+                    if (*(ppmot+k) != 0) {
+                        *(ppart+1+np*3+1) = -1;
+                    } else {
+                        *(ppart+1+np*3+1) = k;
+                    }
+                    *(ppart+1+np*3+2) = n-1;
+                }
+                np++;
+            }
+        }
+    }
+    
+    // Columns of interior DOFs with constrained rows (lower triangle)
+    for (i = NEQ-NBC-1; i >= 0; --i) {
+        n = *(pii+i)+1;
+        kl = *(pmaxa+n-1) + 1;
+        ku = *(pmaxa+n) - 1;
+        kh = ku - kl;
+        if (kh >= 0) {
+            k = n;
+            for (kk = kl; kk <= ku; ++kk) {
+                k--;
+                if (*(ppmot+k-1) != 0) {
+                    if (ppart != NULL) {
+                        *(ppart+1+np*3) = kk;
+                        *(ppart+1+np*3+1) = n-1;
+                        *(ppart+1+np*3+2) = k-1;
+                    }
+                    np++;
+                }
+            }
+        }
+    }
+    
+    if (ppart != NULL) {
+        *(ppart) = np;
+    }
+    return np;
+}
+
+int matpart (long *pmaxa, long *ppart, double *pss, double *pqtot, double *puc, int *pij)
+{
+    
+    // Initialize function variables
+    long i, n, k, kk;
+    
+    /* Move the coupling terms of the prescribed displacements to the right-hand side and
+     remove them from the stiffness matrix, using the entries collected by matpartlist */
+    for (i = 0; i < *(ppart); ++i) {
+        kk = *(ppart+1+i*3);
+        k = *(ppart+1+i*3+1);
+        if (k >= 0) {
+            *(pqtot+k) -= (*(pss+kk-1))*(*(puc+*(ppart+1+i*3+2)));
+        }
+        *(pss+kk-1) = 0;
+    }
+    
+    // Modify the diagonal of the stiffness matrix
+    for (n = 0; n < NBC; ++n) {
+        k = *(pmaxa+ (*(pij+n)));
+        *(pss+k-1) = 1;
+    }
+    
+    return 0;
+}
+
+int matpartd (double *pss, double *pqtot, double *puc, int *pii, int *pij)
+{
+    
+    // Initialize function variables
+    long i, n, k, l;
+    
+    /* Move the coupling terms of the prescribed displacements to the right-hand side of the
+     interior DOFs, and remove the rows and columns of the constrained DOFs from the full
+     order matrix */
+    for (n = 0; n < NBC; ++n) {
+        l = *(pij+n);
+        for (i = 0; i < NEQ-NBC; ++i) {
+            k = *(pii+i);
+            *(pqtot+k) -= (*(pss+l*NEQ+k))*(*(puc+l));
+        }
+        for (i = 0; i < NEQ; ++i) {
+            *(pss+l*NEQ+i) = 0;
+            *(pss+i*NEQ+l) = 0;
+        }
+    }
+    
+    // Modify the diagonal of the stiffness matrix
+    for (n = 0; n < NBC; ++n) {
+        l = *(pij+n);
+        *(pss+l*NEQ+l) = 1;
+    }
+    
+    return 0;
+}
+
+long sparsefact (long *pmaxa, double *pss, int *pAp, int *pAi, double *pAx, void **pNumeric, double c0)
+{
+    
+    // Initialize function variables
+    long i, j, k, n, nz;
+    double *null = (double *) NULL;
+    void *Symbolic;
+    
+    /* Count the nonzero entries of each column of the full matrix: those of the skyline column
+     down to the diagonal and, for each entry above the diagonal, its mirror image in the
+     column of its row */
+    for (j = 0; j <= NEQ; ++j) {
+        *(pAp+j) = 0;
+    }
+    for (j = 0; j < NEQ; ++j) {
+        for (k = *(pmaxa+j); k < *(pmaxa+j+1); ++k) {
+            if (fabs(*(pss+k-1)) > 1e-10) {
+                i = j - (k - *(pmaxa+j));
+                (*(pAp+j+1))++;
+                if (i != j) {
+                    (*(pAp+i+1))++;
+                }
+            }
+        }
+    }
+    if (ANAFLAG == 4 && c0 != 0) {
+        fsicsc (pAp, pAi, pAx, c0, 0);
+    }
+    
+    /* Turn the counts into the start of each column, held in pAp[j+1] while the column is
+     filled, so that pAp[j+1] ends at the start of the next column */
+    nz = 0;
+    for (j = 0; j < NEQ; ++j) {
+        n = *(pAp+j+1);
+        *(pAp+j+1) = nz;
+        nz += n;
+    }
+    
+    /* Fill the columns in ascending order; the skyline column j gives the rows down to the
+     diagonal in ascending order, and appends row j to the columns of those rows, which have
+     been filled down to their diagonal already */
+    if (ANAFLAG == 4 && c0 != 0) {
+        fsicsc (pAp, pAi, pAx, c0, 1);
+    }
+    for (j = 0; j < NEQ; ++j) {
+        for (k = *(pmaxa+j+1)-1; k >= *(pmaxa+j); --k) {
+            if (fabs(*(pss+k-1)) > 1e-10) {
+                i = j - (k - *(pmaxa+j));
+                n = (*(pAp+j+1))++;
+                *(pAi+n) = i;
+                *(pAx+n) = *(pss+k-1);
+                if (i != j) {
+                    n = (*(pAp+i+1))++;
+                    *(pAi+n) = j;
+                    *(pAx+n) = *(pss+k-1);
+                }
+            }
+        }
+    }
+    if (ANAFLAG == 4 && c0 != 0) {
+        fsicsc (pAp, pAi, pAx, c0, 2);
+    }
+    
+    // Release the factorization from a previous call before computing the new one
+    if (*pNumeric != NULL) {
+        umfpack_di_free_numeric (pNumeric);
+    }
+    (void) umfpack_di_symbolic (NEQ, NEQ, pAp, pAi, pAx, &Symbolic, null, null);
+    (void) umfpack_di_numeric (pAp, pAi, pAx, Symbolic, pNumeric, null, null);
+    umfpack_di_free_symbolic (&Symbolic);
+    
+    return nz;
+}
+
+long cholfact (long *pmaxa, double *pss, int *pAp, int *pAi, double *pAx, double *pssd, int *pdet)
+{
+    
+    // Initialize function variables
+    long i, j, k, n, s, nz;
+    int anaflag, neg;
+    double a;
+    int *pPerm, *pLp, *psuper, *ppi, *ppx;
+    double *pLx;
+    cholmod_sparse A;
+    
+    /* Start CHOLMOD on the first call; the supernodal or simplicial method is chosen from
+     the estimated fill, and the AMD and (if available) nested dissection orderings are
+     tried for the least fill */
+    if (cholstart == 0) {
+        cholmod_start (&Common);
+        Common.supernodal = CHOLMOD_AUTO;
+        cholstart = 1;
+    }
+    
+    /* If the nonzero entries of the matrix fall within the pattern of the previous call,
+     their values are gathered into that pattern and its ordering and symbolic analysis
+     are reused; the skyline column j gives the rows of the upper triangle in ascending
+     order from its top down to the diagonal */
+    anaflag = (pL == NULL) ? 1 : 0;
+    for (j = 0; j < NEQ && anaflag == 0; ++j) {
+        n = *(pAp+j);
+        for (k = *(pmaxa+j+1)-1; k >= *(pmaxa+j); --k) {
+            i = j - (k - *(pmaxa+j));
+            if (n < *(pAp+j+1) && *(pAi+n) == i) {
+                *(pAx+n) = *(pss+k-1);
+                n++;
+            } else if (*(pss+k-1) != 0) {
+                anaflag = 1;
+                break;
+            }
+        }
+    }
+    
+    /* Otherwise compress the nonzero entries of the skyline, column by column, into the
+     arrays for the sparse solver; the diagonal and the pattern of the previous call are
+     kept, so that the pattern only grows and is analyzed a few times at most */
+    if (anaflag == 1) {
+        nz = (pL == NULL) ? 0 : *(pAp+NEQ);
+        int *pAp0 = alloc_int (NEQ+1);
+        int *pAi0 = alloc_int (nz+1);
+        if (pAp0 == NULL || pAi0 == NULL) {
+            free (pAp0);
+            free (pAi0);
+            return -1;
+        }
+        for (i = 0; i <= NEQ; ++i) {
+            *(pAp0+i) = (pL == NULL) ? 0 : *(pAp+i);
+        }
+        for (k = 0; k < nz; ++k) {
+            *(pAi0+k) = *(pAi+k);
+        }
+        
+        nz = 0;
+        *(pAp) = 0;
+        for (j = 0; j < NEQ; ++j) {
+            n = *(pAp0+j);
+            for (k = *(pmaxa+j+1)-1; k >= *(pmaxa+j); --k) {
+                i = j - (k - *(pmaxa+j));
+                if (n < *(pAp0+j+1) && *(pAi0+n) == i) {
+                    n++;
+                } else if (*(pss+k-1) == 0 && i != j) {
+                    continue;
+                }
+                *(pAi+nz) = i;
+                *(pAx+nz) = *(pss+k-1);
+                nz++;
+            }
+            *(pAp+j+1) = nz;
+        }
+        free (pAp0);
+        free (pAi0);
+    }
+    nz = *(pAp+NEQ);
+    
+    A.nrow = A.ncol = NEQ;
+    A.nzmax = nz;
+    A.p = pAp;
+    A.i = pAi;
+    A.nz = NULL;
+    A.x = pAx;
+    A.z = NULL;
+    A.stype = 1;
+    A.itype = CHOLMOD_INT;
+    A.xtype = CHOLMOD_REAL;
+    A.dtype = CHOLMOD_DOUBLE;
+    A.sorted = 1;
+    A.packed = 1;
+    
+    if (anaflag == 1) {
+        if (pL != NULL) {
+            cholmod_free_factor (&pL, &Common);
+        }
+        pL = cholmod_analyze (&A, &Common);
+    }
+    cholmod_factorize (&A, pL, &Common);
+    
+    /* A supernodal factorization is LL^t only; if the matrix is not positive definite, it
+     is analyzed again for the simplicial LDL^t factorization, which is kept for the
+     following calls */
+    if (Common.status == CHOLMOD_NOT_POSDEF && pL->is_super) {
+        Common.supernodal = CHOLMOD_SIMPLICIAL;
+        cholmod_free_factor (&pL, &Common);
+        pL = cholmod_analyze (&A, &Common);
+        cholmod_factorize (&A, pL, &Common);
+    }
+    if (Common.status == CHOLMOD_NOT_POSDEF) {
+        fprintf(OFP[0], "\n***ERROR*** Singular stiffness matrix\n");
+    }
+    
+    /* Count the negative pivots of the LDL^t factorization (the pivots of an LL^t
+     factorization are L_kk^2); the pivots are returned in the original order of the
+     equations */
+    pPerm = (int *) pL->Perm;
+    pLx = (double *) pL->x;
+    neg = 0;
+    if (pL->is_super) {
+        psuper = (int *) pL->super;
+        ppi = (int *) pL->pi;
+        ppx = (int *) pL->px;
+        for (s = 0; s < (long) pL->nsuper; ++s) {
+            for (k = *(psuper+s); k < *(psuper+s+1); ++k) {
+                a = *(pLx+*(ppx+s)+(k-*(psuper+s))*(*(ppi+s+1)-*(ppi+s))+(k-*(psuper+s)));
+                if (ALGFLAG == 3) {
+                    *(pssd+*(pPerm+k)) = a * a;
+                }
+            }
+        }
+    } else {
+        pLp = (int *) pL->p;
+        for (k = 0; k < NEQ; ++k) {
+            a = *(pLx+*(pLp+k));
+            if (pL->is_ll) {
+                a = a * a;
+            }
+            if (a <= 0) {
+                neg++;
+            }
+            if (ALGFLAG == 3) {
+                *(pssd+*(pPerm+k)) = a;
+            }
+        }
+    }
+    if (neg > 0) {
+        *pdet = 1;
+    } else {
+        *pdet = 0;
+    }
+    
+    return nz;
+}
+
+int cholsolve (double *pdd)
+{
+    
+    // Initialize function variables
+    long i;
+    cholmod_dense B, *pX;
+    
+    B.nrow = B.nzmax = B.d = NEQ;
+    B.ncol = 1;
+    B.x = pdd;
+    B.z = NULL;
+    B.xtype = CHOLMOD_REAL;
+    B.dtype = CHOLMOD_DOUBLE;
+    
+    // Solve with the factorization computed by cholfact and return the solution in pdd
+    pX = cholmod_solve (CHOLMOD_A, pL, &B, &Common);
+    if (pX == NULL) {
+        return 1;
+    }
+    for (i = 0; i < NEQ; ++i) {
+        *(pdd+i) = *((double *) pX->x+i);
+    }
+    cholmod_free_dense (&pX, &Common);
+    
+    return 0;
+}
+
+void cholfree (void)
+{
+    
+    // Release the factorization and the CHOLMOD workspace
+    if (pL != NULL) {
+        cholmod_free_factor (&pL, &Common);
+    }
+    if (cholstart == 1) {
+        cholmod_finish (&Common);
+        cholstart = 0;
+    }
+}
+
+void solvefree (void)
+{
+    
+    // Release the factorizations and workspaces of the sparse and skyline solvers
+    if (Numeric != NULL) {
+        umfpack_di_free_numeric (&Numeric);
+    }
+    cholfree ();
+    amgfree ();
+    amgmodesfree ();
+    free (pssf);
+    free (pmult);
+    free (plrv);
+    free (plrd);
+    free (plrg);
+    free (plrw);
+    free (plrs);
+    free (plrm);
+    free (plrp);
+    free (plre);
+    pssf = NULL;
+    pmult = NULL;
+    plrv = plrd = plrg = plrw = NULL;
+    plrs = plrm = plrmc = NULL;
+    plrp = plre = plryf = plryv = NULL;
+    lmult = 0;
+    lrs = -1;
+    lrit = 0;
+#ifdef BEN_MPI
+    free (ddmap);
+    free (ddmaxa);
+    free (ddsk);
+    free (ddpre);
+    free (ddsch);
+    free (ddipiv);
+    ddmap = ddmaxa = NULL;
+    ddsk = ddpre = ddsch = NULL;
+    ddipiv = NULL;
+#endif
+}
+
+int bandfact (long *pmaxa, double *pss, double *pab, double *pssd, int *pdet)
+{
+    
+    // Initialize function variables
+    long i, j, k;
+    int n, kd, ldab, info;
+    char uplo = 'U';
+    
+    if (BAND == 0) {
+        return 0;
+    }
+    
+    n = NEQ;
+    kd = BAND;
+    ldab = BAND + 1;
+    
+    /* Copy the skyline columns into the upper band storage, where A(i,j) is held in
+     ab(kd+i-j,j); entries between the skyline and the band edge are zero */
+    for (i = 0; i < NEQ*ldab; ++i) {
+        *(pab+i) = 0;
+    }
+    for (j = 0; j < NEQ; ++j) {
+        for (k = *(pmaxa+j); k < *(pmaxa+j+1); ++k) {
+            *(pab+j*ldab+kd-(k-*(pmaxa+j))) = *(pss+k-1);
+        }
+    }
+    
+    /* Cholesky factorization; if the matrix is not positive definite, the skyline
+     LDL^t factorization is used instead to obtain the sign of the pivots */
+    dpbtrf_(&uplo, &n, &kd, pab, &ldab, &info);
+    if (info != 0) {
+        return 0;
+    }
+    
+    // The pivots of the LDL^t factorization are U_ii^2
+    *pdet = 0;
+    if (ALGFLAG == 3) {
+        for (i = 0; i < NEQ; ++i) {
+            *(pssd+i) = *(pab+i*ldab+kd) * (*(pab+i*ldab+kd));
+        }
+    }
+    
+    return 1;
+}
+
+int bandsolve (double *pab, double *pdd)
+{
+    
+    // Initialize function variables
+    int n, kd, ldab, ldb, info, nrhs = 1;
+    char uplo = 'U';
+    
+    n = ldb = NEQ;
+    kd = BAND;
+    ldab = BAND + 1;
+    
+    // Perform the triangular solves with the factorization computed by bandfact
+    dpbtrs_(&uplo, &n, &kd, &nrhs, pab, &ldab, pdd, &ldb, &info);
+    
+    return info;
+}
+
+int ddcodes (long *pmcode, long *pmcodeg, long *pjpart, long *pminc)
+{
+    
+#ifdef BEN_MPI
+    // Initialize function variables
+    long i, j, k, n, nc, ptr, nown;
+    int r, ok;
+    
+    long *peq = alloc_long (NEQ+1); // Rank of the elements of each equation
+    long *pcnt = alloc_long (MPISIZE*2); // Elements and interior equations of each rank
+    if (peq == NULL || pcnt == NULL) {
+        free (peq);
+        free (pcnt);
+        return -1;
+    }
+    free (ddmap);
+    ddmap = alloc_long (NEQ+1);
+    if (ddmap == NULL) {
+        free (peq);
+        free (pcnt);
+        return -1;
+    }
+    
+    /* Assign each element to the rank of the subdomain of its first joint; the equations
+     of the elements of this rank are kept in its member DOF code, and the others zeroed.
+     peq holds the rank of the elements of an equation, -1 if it has none, and MPISIZE if
+     they belong to several ranks */
+    for (i = 0; i < NEQ; ++i) {
+        *(peq+i) = -1;
+    }
+    nown = 0;
+    for (n = 0; n < NE_TR + NE_FR + NE_SH; ++n) {
+        if (n < NE_TR) {
+            j = *(pminc+n*2);
+            ptr = n * 6;
+            nc = 6;
+        } else if (n < NE_TR + NE_FR) {
+            j = *(pminc+NE_TR*2+(n-NE_TR)*2);
+            ptr = NE_TR * 6 + (n - NE_TR) * 14;
+            nc = 14;
+        } else {
+            j = *(pminc+NE_TR*2+NE_FR*2+(n-NE_TR-NE_FR)*3);
+            ptr = NE_TR * 6 + NE_FR * 14 + (n - NE_TR - NE_FR) * 18;
+            nc = 18;
+        }
+        r = (int) *(pjpart+j-1);
+        if (r == MPIRANK) {
+            nown++;
+        }
+        for (i = 0; i < nc; ++i) {
+            k = *(pmcode+ptr+i);
+            *(pmcodeg+ptr+i) = (r == MPIRANK) ? k : 0;
+            if (k != 0) {
+                if (*(peq+k-1) == -1) {
+                    *(peq+k-1) = r;
+                } else if (*(peq+k-1) != r) {
+                    *(peq+k-1) = MPISIZE;
+                }
+            }
+        }
+    }
+    
+    /* ddmap holds the position of an interface equation plus one, minus the position of an
+     interior equation of this rank minus one, or zero for the interior of the other ranks */
+    ddnif = ddnint = 0;
+    for (i = 0; i < NEQ; ++i) {
+        if (*(peq+i) == MPISIZE) {
+            *(ddmap+i) = ++ddnif;
+        } else if (*(peq+i) == MPIRANK) {
+            *(ddmap+i) = -(++ddnint);
+        } else {
+            *(ddmap+i) = 0;
+        }
+    }
+    
+    /* The decomposition is used only if every rank holds elements and interior equations;
+     otherwise every rank assembles and solves the complete system */
+    *(pcnt+MPIRANK*2) = nown;
+    *(pcnt+MPIRANK*2+1) = ddnint;
+    MPI_Allgather (MPI_IN_PLACE, 2, MPI_LONG, pcnt, 2, MPI_LONG, MPI_COMM_WORLD);
+    ok = 1;
+    for (r = 0; r < MPISIZE; ++r) {
+        if (*(pcnt+r*2) == 0 || *(pcnt+r*2+1) == 0) {
+            ok = 0;
+        }
+    }
+    if (ok == 0) {
+        fprintf(OFP[0], "\n***WARNING*** Domain decomposition leaves a rank without a");
+        fprintf(OFP[0], " subdomain; continuing with the complete system on every rank\n");
+        free (ddmap);
+        ddmap = NULL;
+        free (peq);
+        free (pcnt);
+        return 0;
+    }
+    
+    // Print the subdomains
+    fprintf(OFP[0], "\nDomain Decomposition:\n\tInterface equations: %ld\n", ddnif);
+    fprintf(OFP[0], "\tRank\t\tElements\tInterior equations\n");
+    for (r = 0; r < MPISIZE; ++r) {
+        fprintf(OFP[0], "\t%d\t\t%ld\t\t%ld\n", r, *(pcnt+r*2), *(pcnt+r*2+1));
+    }
+    
+    free (peq);
+    free (pcnt);
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+int ddfact (long *pmaxa, double *pss, int *pdet)
+{
+    
+#ifdef BEN_MPI
+    // Initialize function variables
+    long i, j, k, kk, n, kn, kl, ku, ki, nd, ic, klt, l;
+    int ok;
+    double b, c;
+    
+    if (ddmap == NULL) {
+        return 0;
+    }
+    
+    free (ddmaxa);
+    free (ddsk);
+    free (ddpre);
+    free (ddsch);
+    free (ddipiv);
+    ddsch = NULL;
+    ddipiv = NULL;
+    ddmaxa = alloc_long (ddnint+1);
+    ddpre = alloc_dbl (ddnif+1);
+    long *pnxt = alloc_long (NEQ+1); // First interior equation of this rank from an equation
+    if (ddmaxa == NULL || ddpre == NULL || pnxt == NULL) {
+        free (pnxt);
+        return -1;
+    }
+    
+    /* Skyline of the interior stiffness of this rank in its own numbering; the skyline
+     matrix of this rank is assembled from its elements only, and so holds the complete
+     coupling of its interior equations. A column reaches up to the first interior equation
+     at or below the top of the column of the equation in the skyline matrix */
+    *(pnxt+NEQ) = ddnint;
+    for (n = NEQ-1; n >= 0; --n) {
+        *(pnxt+n) = (*(ddmap+n) < 0) ? -*(ddmap+n)-1 : *(pnxt+n+1);
+    }
+    *ddmaxa = 1;
+    for (n = 0; n < NEQ; ++n) {
+        if (*(ddmap+n) < 0) {
+            j = -*(ddmap+n)-1;
+            k = n - (*(pmaxa+n+1) - *(pmaxa+n) - 1);
+            *(ddmaxa+j+1) = *(ddmaxa+j) + j - *(pnxt+k) + 1;
+        }
+    }
+    free (pnxt);
+    ddsk = alloc_dbl (*(ddmaxa+ddnint)-1);
+    if (ddsk == NULL) {
+        return -1;
+    }
+    
+    /* Copy the interior stiffness of this rank into its skyline, and the diagonal of the
+     interface stiffness of its elements into the Jacobi preconditioner of the interface
+     problem, which sums it over the ranks */
+    for (i = 0; i < *(ddmaxa+ddnint)-1; ++i) {
+        *(ddsk+i) = 0;
+    }
+    for (i = 0; i < ddnif; ++i) {
+        *(ddpre+i) = 0;
+    }
+    for (n = 0; n < NEQ; ++n) {
+        if (*(ddmap+n) < 0) {
+            j = -*(ddmap+n)-1;
+            k = n+1;
+            for (kk = *(pmaxa+n); kk < *(pmaxa+n+1); ++kk) {
+                k--;
+                if (*(ddmap+k) < 0) {
+                    i = -*(ddmap+k)-1;
+                    *(ddsk+*(ddmaxa+j)-1+j-i) = *(pss+kk-1);
+                }
+            }
+        } else if (*(ddmap+n) > 0) {
+            *(ddpre+*(ddmap+n)-1) = *(pss+*(pmaxa+n)-1);
+        }
+    }
+    MPI_Allreduce (MPI_IN_PLACE, ddpre, (int) ddnif, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    
+    /* LDL^t factorization of the interior stiffness of this rank on its skyline, as in
+     skyfact */
+    ok = 1;
+    for (n = 1; n <= ddnint && ok == 1; ++n) {
+        kn = *(ddmaxa+n-1);
+        kl = kn + 1;
+        ku = *(ddmaxa+n) - 1;
+        if (ku - kl > 0) {
+            k = n - (ku - kl);
+            ic = 0;
+            klt = ku;
+            for (j = 1; j <= ku - kl; ++j) {
+                ic++;
+                klt--;
+                ki = *(ddmaxa+k-1);
+                nd = *(ddmaxa+k) - ki - 1;
+                if (nd > 0) {
+                    c = 0;
+                    for (l = 1; l <= ((nd < ic) ? nd : ic); ++l) {
+                        c += *(ddsk+ki-1+l) * (*(ddsk+klt-1+l));
+                    }
+                    *(ddsk+klt-1) -= c;
+                }
+                k++;
+            }
+        }
+        k = n;
+        b = 0;
+        for (kk = kl; kk <= ku; ++kk) {
+            k--;
+            ki = *(ddmaxa+k-1);
+            c = *(ddsk+kk-1) / *(ddsk+ki-1);
+            b += c * (*(ddsk+kk-1));
+            *(ddsk+kk-1) = c;
+        }
+        *(ddsk+kn-1) -= b;
+        if (*(ddsk+kn-1) <= 0) {
+            ok = 0;
+        }
+    }
+    
+    /* The decomposition requires the interior stiffness of every rank to be positive
+     definite; no rank holds the complete matrix to fall back on */
+    MPI_Allreduce (MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    if (ok == 0) {
+        fprintf(OFP[0], "\n***ERROR*** Interior stiffness matrix of the domain decomposition");
+        fprintf(OFP[0], " is not positive definite\n");
+        return -1;
+    }
+    
+    /* The interface problem is solved directly instead of by conjugate gradients if it is
+     no larger as a full matrix than the skyline matrix of a rank, which saves the exchange
+     between the ranks at each iteration, or if it is indefinite, i.e. a diagonal entry is
+     not positive */
+    if (ddnif*ddnif <= *(pmaxa+NEQ)) {
+        ok = 0;
+    }
+    MPI_Allreduce (MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    for (i = 0; i < ddnif; ++i) {
+        if (*(ddpre+i) <= 0) {
+            ok = 0;
+        }
+    }
+    if (ok == 0 && ddschur (pmaxa, pss) < 0) {
+        return -1;
+    }
+    
+    *pdet = 0;
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+void ddisolve (double *pz)
+{
+    
+#ifdef BEN_MPI
+    // Initialize function variables
+    long i, n, kl, ku, k, kk;
+    double c;
+    
+    // Reduce right-hand-side vector
+    for (n = 1; n <= ddnint; ++n) {
+        kl = *(ddmaxa+n-1) + 1;
+        ku = *(ddmaxa+n) - 1;
+        k = n;
+        c = 0;
+        for (kk = kl; kk <= ku; ++kk) {
+            k--;
+            c += *(ddsk+kk-1) * (*(pz+k-1));
+        }
+        *(pz+n-1) -= c;
+    }
+    
+    // Back-substitute
+    for (n = 0; n < ddnint; ++n) {
+        *(pz+n) /= *(ddsk+*(ddmaxa+n)-1);
+    }
+    n = ddnint;
+    for (i = 2; i <= ddnint; ++i) {
+        kl = *(ddmaxa+n-1) + 1;
+        ku = *(ddmaxa+n) - 1;
+        k = n;
+        for (kk = kl; kk <= ku; ++kk) {
+            k--;
+            *(pz+k-1) -= *(ddsk+kk-1) * (*(pz+n-1));
+        }
+        n--;
+    }
+#endif
+}
+
+int ddmult (long *pmaxa, double *pss, double *pp, double *py, double *pz)
+{
+    
+#ifdef BEN_MPI
+    // Initialize function variables
+    long i, k, kk, n, ci, cn;
+    double s;
+    
+    /* Product of the interface stiffness of this rank with the interface vector pp, less the
+     coupling through its interior, Kgi Kii^-1 Kig pp; the sum over the ranks is the product
+     with the Schur complement. The skyline matrix of each rank holds the stiffness of its
+     elements, so the coupling of its interior is complete on it and the interface stiffness
+     is shared among the ranks */
+    for (i = 0; i < ddnint; ++i) {
+        *(pz+i) = 0;
+    }
+    for (n = 0; n < NEQ; ++n) {
+        cn = *(ddmap+n);
+        k = n;
+        for (kk = *(pmaxa+n)+1; kk < *(pmaxa+n+1); ++kk) {
+            k--;
+            ci = *(ddmap+k);
+            if (ci < 0 && cn > 0) {
+                *(pz-ci-1) += *(pss+kk-1) * (*(pp+cn-1));
+            } else if (ci > 0 && cn < 0) {
+                *(pz-cn-1) += *(pss+kk-1) * (*(pp+ci-1));
+            }
+        }
+    }
+    ddisolve (pz);
+    
+    for (i = 0; i < ddnif; ++i) {
+        *(py+i) = 0;
+    }
+    for (n = 0; n < NEQ; ++n) {
+        cn = *(ddmap+n);
+        if (cn > 0) {
+            *(py+cn-1) += *(pss+*(pmaxa+n)-1) * (*(pp+cn-1));
+        }
+        k = n;
+        for (kk = *(pmaxa+n)+1; kk < *(pmaxa+n+1); ++kk) {
+            k--;
+            ci = *(ddmap+k);
+            s = *(pss+kk-1);
+            if (ci > 0 && cn > 0) {
+                *(py+ci-1) += s * (*(pp+cn-1));
+                *(py+cn-1) += s * (*(pp+ci-1));
+            } else if (ci > 0 && cn < 0) {
+                *(py+ci-1) -= s * (*(pz-cn-1));
+            } else if (ci < 0 && cn > 0) {
+                *(py+cn-1) -= s * (*(pz-ci-1));
+            }
+        }
+    }
+    MPI_Allreduce (MPI_IN_PLACE, py, (int) ddnif, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+#endif
+    
+    return 0;
+}
+
+int ddschur (long *pmaxa, double *pss)
+{
+    
+#ifdef BEN_MPI
+    // Initialize function variables
+    long i, j, k, kk, n, c0, nc, ci, cn;
+    int nn, info, lwork;
+    char uplo = 'L';
+    double s, wkopt;
+    
+    // Number of interface equations condensed at once
+    long nb = 64;
+    
+    ddsch = alloc_dbl (ddnif*ddnif);
+    ddipiv = alloc_int (ddnif);
+    double *pz = alloc_dbl (ddnint*nb);
+    if (ddsch == NULL || ddipiv == NULL || pz == NULL) {
+        free (pz);
+        return -1;
+    }
+    
+    // Interface stiffness of the elements of this rank
+    for (i = 0; i < ddnif*ddnif; ++i) {
+        *(ddsch+i) = 0;
+    }
+    for (n = 0; n < NEQ; ++n) {
+        cn = *(ddmap+n);
+        if (cn > 0) {
+            *(ddsch+(cn-1)*ddnif+cn-1) += *(pss+*(pmaxa+n)-1);
+        }
+        k = n;
+        for (kk = *(pmaxa+n)+1; kk < *(pmaxa+n+1); ++kk) {
+            k--;
+            ci = *(ddmap+k);
+            if (ci > 0 && cn > 0) {
+                *(ddsch+(cn-1)*ddnif+ci-1) += *(pss+kk-1);
+                *(ddsch+(ci-1)*ddnif+cn-1) += *(pss+kk-1);
+            }
+        }
+    }
+    
+    /* Less the coupling through the interior of this rank, Kgi Kii^-1 Kig, for nb columns
+     at a time; the columns of Kig are gathered from the skyline matrix, solved for with the
+     interior factorization, and multiplied by Kgi */
+    for (c0 = 0; c0 < ddnif; c0 += nb) {
+        nc = (ddnif - c0 < nb) ? ddnif - c0 : nb;
+        for (i = 0; i < ddnint*nc; ++i) {
+            *(pz+i) = 0;
+        }
+        for (n = 0; n < NEQ; ++n) {
+            cn = *(ddmap+n);
+            k = n;
+            for (kk = *(pmaxa+n)+1; kk < *(pmaxa+n+1); ++kk) {
+                k--;
+                ci = *(ddmap+k);
+                if (ci < 0 && cn > c0 && cn <= c0+nc) {
+                    *(pz+(cn-1-c0)*ddnint-ci-1) += *(pss+kk-1);
+                } else if (ci > c0 && ci <= c0+nc && cn < 0) {
+                    *(pz+(ci-1-c0)*ddnint-cn-1) += *(pss+kk-1);
+                }
+            }
+        }
+        for (j = 0; j < nc; ++j) {
+            ddisolve (pz+j*ddnint);
+        }
+        for (n = 0; n < NEQ; ++n) {
+            cn = *(ddmap+n);
+            k = n;
+            for (kk = *(pmaxa+n)+1; kk < *(pmaxa+n+1); ++kk) {
+                k--;
+                ci = *(ddmap+k);
+                s = *(pss+kk-1);
+                if (ci > 0 && cn < 0) {
+                    for (j = 0; j < nc; ++j) {
+                        *(ddsch+(c0+j)*ddnif+ci-1) -= s * (*(pz+j*ddnint-cn-1));
+                    }
+                } else if (ci < 0 && cn > 0) {
+                    for (j = 0; j < nc; ++j) {
+                        *(ddsch+(c0+j)*ddnif+cn-1) -= s * (*(pz+j*ddnint-ci-1));
+                    }
+                }
+            }
+        }
+        
+        // Sum the columns over the ranks
+        MPI_Allreduce (MPI_IN_PLACE, ddsch+c0*ddnif, (int) (nc*ddnif), MPI_DOUBLE, MPI_SUM,
+                       MPI_COMM_WORLD);
+    }
+    free (pz);
+    
+    /* Every rank factorizes the interface problem by LDL^t with Bunch-Kaufman pivoting,
+     which allows for an indefinite tangent stiffness */
+    nn = (int) ddnif;
+    lwork = -1;
+    dsytrf_(&uplo, &nn, ddsch, &nn, ddipiv, &wkopt, &lwork, &info);
+    lwork = (int) wkopt;
+    double *pwork = alloc_dbl (lwork);
+    if (pwork == NULL) {
+        return -1;
+    }
+    dsytrf_(&uplo, &nn, ddsch, &nn, ddipiv, pwork, &lwork, &info);
+    free (pwork);
+    if (info > 0) {
+        fprintf(OFP[0], "\n***ERROR*** Singular interface problem of the domain");
+        fprintf(OFP[0], " decomposition\n");
+        return -1;
+    }
+    
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+int ddsolve (long *pmaxa, double *pss, double *pssd, double *pdd, int *pdet)
+{
+    
+#ifdef BEN_MPI
+    // Initialize function variables
+    long i, k, kk, n, it, ci, cn;
+    int nn, info, nrhs = 1;
+    char uplo = 'L';
+    double rz, rzp, pap, alpha, gnrm, rnrm;
+    
+    double *pg = alloc_dbl (5*(ddnif+1));
+    double *pz = alloc_dbl (ddnint+1);
+    double *pw = alloc_dbl (ddnint+1);
+    double *pb = alloc_dbl (NEQ);
+    if (pg == NULL || pz == NULL || pw == NULL || pb == NULL) {
+        return -1;
+    }
+    double *pu = pg+(ddnif+1); // Interface displacements
+    double *pr = pu+(ddnif+1); // Residual of the interface problem
+    double *pp = pr+(ddnif+1); // Search direction
+    double *pq = pp+(ddnif+1); // Product of the Schur complement with the search direction
+    
+    for (i = 0; i < NEQ; ++i) {
+        *(pb+i) = *(pdd+i);
+    }
+    
+    // Interior displacements of this rank due to the loads on its interior, Kii^-1 fi
+    for (n = 0; n < NEQ; ++n) {
+        if (*(ddmap+n) < 0) {
+            *(pz-*(ddmap+n)-1) = *(pb+n);
+        }
+    }
+    ddisolve (pz);
+    
+    // Condensed loads on the interface, g = fg - Kgi Kii^-1 fi summed over the ranks
+    for (i = 0; i < ddnif; ++i) {
+        *(pg+i) = 0;
+    }
+    for (n = 0; n < NEQ; ++n) {
+        cn = *(ddmap+n);
+        k = n;
+        for (kk = *(pmaxa+n)+1; kk < *(pmaxa+n+1); ++kk) {
+            k--;
+            ci = *(ddmap+k);
+            if (ci > 0 && cn < 0) {
+                *(pg+ci-1) -= *(pss+kk-1) * (*(pz-cn-1));
+            } else if (ci < 0 && cn > 0) {
+                *(pg+cn-1) -= *(pss+kk-1) * (*(pz-ci-1));
+            }
+        }
+    }
+    MPI_Allreduce (MPI_IN_PLACE, pg, (int) ddnif, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    for (i = 0; i < NEQ; ++i) {
+        if (*(ddmap+i) > 0) {
+            *(pg+*(ddmap+i)-1) += *(pb+i);
+        }
+    }
+    
+    /* Solve the interface problem S ug = g by conjugate gradients with the Jacobi
+     preconditioner; every rank holds the interface vectors, and the product with the Schur
+     complement S is summed over the ranks by ddmult */
+    gnrm = 0;
+    for (i = 0; i < ddnif; ++i) {
+        *(pu+i) = 0;
+        *(pr+i) = *(pg+i);
+        gnrm += *(pg+i) * (*(pg+i));
+    }
+    gnrm = sqrt(gnrm);
+    rnrm = gnrm;
+    rzp = 1;
+    for (it = 0; ddsch == NULL && it < 2*ddnif+100 && rnrm > 1e-12 * gnrm; ++it) {
+        rz = 0;
+        for (i = 0; i < ddnif; ++i) {
+            rz += *(pr+i) * (*(pr+i)) / *(ddpre+i);
+        }
+        for (i = 0; i < ddnif; ++i) {
+            if (it == 0) {
+                *(pp+i) = *(pr+i) / *(ddpre+i);
+            } else {
+                *(pp+i) = *(pr+i) / *(ddpre+i) + rz / rzp * (*(pp+i));
+            }
+        }
+        rzp = rz;
+        ddmult (pmaxa, pss, pp, pq, pw);
+        pap = 0;
+        for (i = 0; i < ddnif; ++i) {
+            pap += *(pp+i) * (*(pq+i));
+        }
+        if (pap <= 0) {
+            break; // The interface problem is not positive definite
+        }
+        alpha = rz / pap;
+        rnrm = 0;
+        for (i = 0; i < ddnif; ++i) {
+            *(pu+i) += alpha * (*(pp+i));
+            *(pr+i) -= alpha * (*(pq+i));
+            rnrm += *(pr+i) * (*(pr+i));
+        }
+        rnrm = sqrt(rnrm);
+    }
+    
+    /* If conjugate gradients break down or stagnate, as for an indefinite or nearly singular
+     tangent stiffness, the interface problem is formed and factorized (see ddschur), and
+     solved directly for this and the following right-hand sides of the factorization */
+    if (ddsch == NULL && rnrm > 1e-12 * gnrm && ddschur (pmaxa, pss) < 0) {
+        free (pg);
+        free (pz);
+        free (pw);
+        free (pb);
+        return -1;
+    }
+    if (ddsch != NULL) {
+        for (i = 0; i < ddnif; ++i) {
+            *(pu+i) = *(pg+i);
+        }
+        nn = (int) ddnif;
+        dsytrs_(&uplo, &nn, &nrhs, ddsch, &nn, ddipiv, pu, &nn, &info);
+    }
+    
+    // Interior displacements of this rank, ui = Kii^-1 (fi - Kig ug)
+    for (n = 0; n < NEQ; ++n) {
+        if (*(ddmap+n) < 0) {
+            *(pz-*(ddmap+n)-1) = *(pb+n);
+        }
+    }
+    for (n = 0; n < NEQ; ++n) {
+        cn = *(ddmap+n);
+        k = n;
+        for (kk = *(pmaxa+n)+1; kk < *(pmaxa+n+1); ++kk) {
+            k--;
+            ci = *(ddmap+k);
+            if (ci < 0 && cn > 0) {
+                *(pz-ci-1) -= *(pss+kk-1) * (*(pu+cn-1));
+            } else if (ci > 0 && cn < 0) {
+                *(pz-cn-1) -= *(pss+kk-1) * (*(pu+ci-1));
+            }
+        }
+    }
+    ddisolve (pz);
+    
+    /* Gather the displacements; the interior displacements are summed over the ranks, each
+     of which contributes its own, while every rank holds the interface displacements */
+    for (i = 0; i < NEQ; ++i) {
+        *(pdd+i) = 0;
+    }
+    for (n = 0; n < NEQ; ++n) {
+        if (*(ddmap+n) < 0) {
+            *(pdd+n) = *(pz-*(ddmap+n)-1);
+        }
+    }
+    MPI_Allreduce (MPI_IN_PLACE, pdd, (int) NEQ, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    for (i = 0; i < NEQ; ++i) {
+        if (*(ddmap+i) > 0) {
+            *(pdd+i) = *(pu+*(ddmap+i)-1);
+        }
+    }
+    
+    free (pg);
+    free (pz);
+    free (pw);
+    free (pb);
+    
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+int lapfact (double *pss, int *pipiv, double *pssd, int *pdet)
+{
+    
+    // Initialize function variables
+    long i, j;
+    int n, lda, info, lwork, neg, type;
+    char uplo;
+    double amax, a, b, c, wkopt;
+    
+    n = lda = NEQ;
+    
+    // Check the symmetry of the matrix relative to its largest entry
+    amax = 0;
+    for (i = 0; i < NEQ*NEQ; ++i) {
+        if (fabs(*(pss+i)) > amax) {
+            amax = fabs(*(pss+i));
+        }
+    }
+    type = 1;
+    for (j = 0; j < NEQ && type == 1; ++j) {
+        for (i = j+1; i < NEQ; ++i) {
+            if (fabs(*(pss+j*NEQ+i) - *(pss+i*NEQ+j)) > 1e-12 * amax) {
+                type = 0;
+                break;
+            }
+        }
+    }
+    
+    // Non-symmetric matrix (e.g. FSI analysis); LU factorization with partial pivoting
+    if (type == 0) {
+        dgetrf_(&n, &n, pss, &lda, pipiv, &info);
+        return 0;
+    }
+    
+    /* Cholesky factorization of the upper triangle; dpotrf leaves the strict lower
+     triangle untouched, so only the diagonal is saved for a fallback factorization */
+    double *pdiag = alloc_dbl (NEQ);
+    if (pdiag == NULL) {
+        return -1;
+    }
+    for (i = 0; i < NEQ; ++i) {
+        *(pdiag+i) = *(pss+i*NEQ+i);
+    }
+    
+    uplo = 'U';
+    dpotrf_(&uplo, &n, pss, &lda, &info);
+    if (info == 0) {
+        // The matrix is positive definite; the pivots of its LDL^t factorization are U_ii^2
+        *pdet = 0;
+        if (ALGFLAG == 3) {
+            for (i = 0; i < NEQ; ++i) {
+                *(pssd+i) = *(pss+i*NEQ+i) * (*(pss+i*NEQ+i));
+            }
+        }
+        free (pdiag);
+        return 1;
+    }
+    
+    /* The matrix is not positive definite; restore the diagonal and perform the LDL^t
+     factorization of the lower triangle with Bunch-Kaufman pivoting */
+    for (i = 0; i < NEQ; ++i) {
+        *(pss+i*NEQ+i) = *(pdiag+i);
+    }
+    free (pdiag);
+    
+    uplo = 'L';
+    lwork = -1;
+    dsytrf_(&uplo, &n, pss, &lda, pipiv, &wkopt, &lwork, &info);
+    lwork = (int) wkopt;
+    double *pwork = alloc_dbl (lwork);
+    if (pwork == NULL) {
+        return -1;
+    }
+    dsytrf_(&uplo, &n, pss, &lda, pipiv, pwork, &lwork, &info);
+    free (pwork);
+    
+    if (info > 0) {
+        fprintf(OFP[0], "\n***ERROR*** Singular stiffness matrix\n");
+    }
+    
+    /* Count the negative eigenvalues of the block diagonal factor D, which by Sylvester's
+     law of inertia equal those of the matrix; a 2x2 block holds one of each sign if its
+     determinant is negative */
+    neg = 0;
+    for (i = 0; i < NEQ; ++i) {
+        a = *(pss+i*NEQ+i);
+        if (*(pipiv+i) > 0 || i == NEQ-1) {
+            if (a <= 0) {
+                neg++;
+            }
+            if (ALGFLAG == 3) {
+                *(pssd+i) = a;
+            }
+        } else {
+            b = *(pss+i*NEQ+i+1);
+            c = *(pss+(i+1)*NEQ+i+1);
+            if (a*c - b*b < 0) {
+                neg++;
+            } else if (a < 0) {
+                neg += 2;
+            }
+            if (ALGFLAG == 3) {
+                *(pssd+i) = a;
+                *(pssd+i+1) = c;
+            }
+            i++;
+        }
+    }
+    if (neg > 0) {
+        *pdet = 1;
+    } else {
+        *pdet = 0;
+    }
+    
+    return 2;
+}
+
+int lapsolve (double *pss, int *pipiv, double *pdd, int type)
+{
+    
+    // Initialize function variables
+    int n, lda, ldb, info, nrhs = 1;
+    char trans = 'N', uplo;
+    
+    n = lda = ldb = NEQ;
+    
+    // Perform the triangular solves with the factorization computed by lapfact
+    if (type == 1) {
+        uplo = 'U';
+        dpotrs_(&uplo, &n, &nrhs, pss, &lda, pdd, &ldb, &info);
+    } else if (type == 2) {
+        uplo = 'L';
+        dsytrs_(&uplo, &n, &nrhs, pss, &lda, pipiv, pdd, &ldb, &info);
+    } else {
+        dgetrs_(&trans, &n, &nrhs, pss, &lda, pipiv, pdd, &ldb, &info);
+    }
+    
+    return info;
+}
+
+void bfgsfwd (double *pr, double *ps, double *py, double *prho, double *palpha, int nbfgs,
+    int kbfgs, int mbfgs)
+{
+    
+    // Initialize function variables
+    long i;
+    int j, l;
+    double c;
+    
+    /* First loop of the BFGS inverse update (Matthies and Strang 1979): sweep the stored
+     vector pairs from the newest to the oldest, removing from the residual its components
+     along the changes in internal force */
+    for (j = 0; j < nbfgs; ++j) {
+        l = (kbfgs - 1 - j + mbfgs) % mbfgs;
+        c = 0;
+        for (i = 0; i < NEQ; ++i) {
+            c += *(ps+l*NEQ+i) * (*(pr+i));
+        }
+        c *= *(prho+l);
+        *(palpha+l) = c;
+        for (i = 0; i < NEQ; ++i) {
+            *(pr+i) -= c * (*(py+l*NEQ+i));
+        }
+    }
+}
+
+void bfgsbwd (double *pdd, double *ps, double *py, double *prho, double *palpha, int nbfgs,
+    int kbfgs, int mbfgs)
+{
+    
+    // Initialize function variables
+    long i;
+    int j, l;
+    double c;
+    
+    /* Second loop of the BFGS inverse update: once the modified residual has been solved
+     with the factorized tangent stiffness matrix, sweep the stored vector pairs from the
+     oldest to the newest, adding back the corrections along the displacement increments */
+    for (j = 0; j < nbfgs; ++j) {
+        l = (kbfgs - nbfgs + j + mbfgs) % mbfgs;
+        c = 0;
+        for (i = 0; i < NEQ; ++i) {
+            c += *(py+l*NEQ+i) * (*(pdd+i));
+        }
+        c = *(palpha+l) - c * (*(prho+l));
+        for (i = 0; i < NEQ; ++i) {
+            *(pdd+i) += c * (*(ps+l*NEQ+i));
+        }
+    }
+}
+
+int bfgsupd (double *ps, double *py, double *prho, double *pdd, double *pf_temp,
+    double *pf_ip, int *pnbfgs, int *pkbfgs, int mbfgs)
+{
+    
+    // Initialize function variables
+    long i;
+    int l;
+    double sy = 0, ss = 0, yy = 0;
+    
+    /* Store the incremental displacement vector and the change in internal force over the
+     iteration as the newest vector pair, overwriting the oldest pair once mbfgs pairs are
+     held */
+    l = *pkbfgs;
+    for (i = 0; i < NEQ; ++i) {
+        *(ps+l*NEQ+i) = *(pdd+i);
+        *(py+l*NEQ+i) = *(pf_temp+i) - *(pf_ip+i);
+        sy += *(ps+l*NEQ+i) * (*(py+l*NEQ+i));
+        ss += *(ps+l*NEQ+i) * (*(ps+l*NEQ+i));
+        yy += *(py+l*NEQ+i) * (*(py+l*NEQ+i));
+    }
+    
+    /* Skip the update if the pair does not satisfy the curvature condition, which would
+     make the updated matrix indefinite (e.g. past a limit point or during unloading) */
+    if (sy <= 1e-10 * sqrt(ss * yy)) {
+        return 1;
+    }
+    
+    *(prho+l) = 1 / sy;
+    *pkbfgs = (l + 1) % mbfgs;
+    if (*pnbfgs < mbfgs) {
+        (*pnbfgs)++;
+    }
+    
+    return 0;
+}
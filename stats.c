@@ -0,0 +1,301 @@
+//********************************************************************************
+//**                                                                            **
+//**  Pertains to CU-BEN ver 4.0                                                **
+//**                                                                            **
+//**  CU-BENs: a ship hull modeling finite element library                      **
+//**  Copyright (c) 2019 C. J. Earls                                            **
+//**  Developed by C. J. Earls, Cornell University                              **
+//**  All rights reserved.                                                      **
+//**                                                                            **
+//**  Contributors:                                                             **
+//**    Christopher Stull                                                       **
+//**    Heather Reed                                                            **
+//**    Justyna Kosianka                                                        **
+//**    Wensi Wu                                                                **
+//**                                                                            **
+//**  This program is free software: you can redistribute it and/or modify it   **
+//**  under the terms of the GNU General Public License as published by the     **
+//**  Free Software Foundation, either version 3 of the License, or (at your    **
+//**  option) any later version.                                                **
+//**                                                                            **
+//**  This program is distributed in the hope that it will be useful, but       **
+//**  WITHOUT ANY WARRANTY; without even the implied warranty of                **
+//**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General  **
+//**  Public License for more details.                                          **
+//**                                                                            **
+//**  You should have received a copy of the GNU General Public License along   **
+//**  with this program. If not, see <https://www.gnu.org/licenses/>.           **
+//**                                                                            **
+//********************************************************************************
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "prototypes.h"
+
+/* Statistics of an analysis, written at exit to stats.json (or to the model handle of the
+   library interface, see ben_stats): the wall time, number of calls, and estimated
+   floating point operations of each phase (ST_INPUT to ST_OUTPUT), in total and for each
+   load increment or time step, together with the bytes written to the output files and the
+   peak memory of the process. The phases are timed inclusively: input contains optnum and
+   skylin, and solve contains skyfact, skysolve, and the output of the direct solvers. The
+   operations are estimated for the skyline factorization and solution only, and the other
+   phases are written without them. */
+
+extern BEN_TLS long NEQ;
+extern BEN_TLS int ANAFLAG, ALGFLAG, SLVFLAG, MPIRANK;
+extern BEN_TLS FILE *IFP[4], *OFP[8];
+
+static const char *stname[NSTAT] = {"input", "optnum", "skylin", "stiff_tr", "stiff_fr",
+    "stiff_sh", "stiff_br", "mass_tr", "mass_fr", "mass_sh", "mass_br", "solve", "skyfact",
+    "skysolve", "forces_tr", "forces_fr", "forces_sh", "updatc", "test", "output"};
+
+// Phases for which the floating point operations are estimated (see statsky)
+static const int stflop[NSTAT] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0};
+
+static BEN_TLS BENMODEL *stpbm = NULL; // Model handle of the analysis; NULL if run by ben.exe
+static BEN_TLS int stdone = 0; // 1 once the statistics are written out
+static BEN_TLS double st0; // Start of the analysis
+static BEN_TLS double stbeg[NSTAT]; // Start of the current call of each phase
+static BEN_TLS int stopen[NSTAT]; // 1 while a call of the phase is running
+static BEN_TLS long stcnt[NSTAT]; // Number of calls of each phase
+static BEN_TLS double sttim[NSTAT]; // Wall time of each phase
+static BEN_TLS double stflp[NSTAT]; // Estimated floating point operations of each phase
+
+/* Record of the running totals at the end of each load increment or time step, from which
+   the breakdown by step is found; layout of the record of a step: */
+#define SVAL 0 // Load proportionality factor or time of the step
+#define SWALL 1 // Wall time
+#define SBYTE 2 // Bytes written to the output files
+#define SMEM 3 // Peak memory (kB)
+#define SCNT 4 // Number of calls of each phase
+#define STIM (SCNT+NSTAT) // Wall time of each phase
+#define SFLP (STIM+NSTAT) // Floating point operations of each phase
+#define SLEN (SFLP+NSTAT) // Length of the record of a step
+
+static BEN_TLS long nstp = 0, mstp = 0; // Number of steps recorded, and allocated
+static BEN_TLS double *pstep = NULL; // Records of the steps, [nstp][SLEN]
+
+void statinit (BENMODEL *pbm)
+{
+    // Initialize function variables
+    int i;
+    
+    stpbm = pbm;
+    stdone = 0;
+    for (i = 0; i < NSTAT; ++i) {
+        stcnt[i] = stopen[i] = 0;
+        sttim[i] = stflp[i] = 0;
+    }
+    nstp = 0;
+    st0 = statclock ();
+}
+
+double statclock (void)
+{
+    // Initialize function variables
+    struct timespec ts;
+    
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+long statmem (void)
+{
+    // Initialize function variables
+    struct rusage ru;
+    
+    // The peak resident memory is that of the process, shared by concurrent analyses
+    if (getrusage (RUSAGE_SELF, &ru) != 0) {
+        return 0;
+    }
+#if defined(__APPLE__)
+    return ru.ru_maxrss / 1024; // Reported in bytes
+#else
+    return ru.ru_maxrss;
+#endif
+}
+
+long statbyte (void)
+{
+    // Initialize function variables
+    long i, k, sum = 0;
+    
+    for (i = 0; i < 7; ++i) {
+        if (OFP[i] != NULL) {
+            k = ftell (OFP[i]);
+            if (k > 0) {
+                sum += k;
+            }
+        }
+    }
+    
+    return sum;
+}
+
+void statbeg (int ph)
+{
+    stbeg[ph] = statclock ();
+    stopen[ph] = 1;
+}
+
+void statend (int ph, double flops)
+{
+    stcnt[ph]++;
+    sttim[ph] += statclock () - stbeg[ph];
+    stflp[ph] += flops;
+    stopen[ph] = 0;
+}
+
+double statsky (long *pmaxa, int type)
+{
+    // Initialize function variables
+    long n, m;
+    double sum = 0;
+    
+    /* A column of m entries above the diagonal costs about m^2 operations in the
+     factorization, and 4m in the reduction and back-substitution */
+    for (n = 0; n < NEQ; ++n) {
+        m = *(pmaxa+n+1) - *(pmaxa+n) - 1;
+        if (type == 0) {
+            sum += (double) m * m + 3 * m;
+        } else {
+            sum += 4 * m + 1;
+        }
+    }
+    
+    return sum;
+}
+
+void statstep (double val)
+{
+    // Initialize function variables
+    long m, i;
+    double t;
+    double *pd, *ps;
+    
+    /* Enlarge the record of the steps as needed; the breakdown stops, keeping the steps
+     recorded, if memory is not available */
+    if (nstp == mstp) {
+        m = (mstp > 0) ? 2 * mstp : 64;
+        pd = (double *) realloc (pstep, m * SLEN * sizeof (double));
+        if (pd == NULL) {
+            mstp = -1;
+        } else {
+            pstep = pd;
+            mstp = m;
+        }
+    }
+    if (mstp < 0) {
+        return;
+    }
+    
+    ps = pstep + nstp * SLEN;
+    t = statclock ();
+    *(ps+SVAL) = val;
+    *(ps+SWALL) = t - st0;
+    *(ps+SBYTE) = statbyte ();
+    *(ps+SMEM) = statmem ();
+    for (i = 0; i < NSTAT; ++i) {
+        *(ps+SCNT+i) = stcnt[i];
+        /* The time of a call still running, such as solve for the time steps of a linear
+         dynamic analysis, is split among the steps; the call is counted when it ends */
+        *(ps+STIM+i) = sttim[i] + ((stopen[i] == 1) ? t - stbeg[i] : 0);
+        *(ps+SFLP+i) = stflp[i];
+    }
+    nstp++;
+}
+
+void statwrite (int flag)
+{
+    // Initialize function variables
+    FILE *fp;
+    long k, i, j;
+    double wall, cnt, tim, flp;
+    double *ps, *pp; // Records of the step and of the previous step
+    
+    // The output files may be closed more than once on failure
+    if (stdone == 1) {
+        return;
+    }
+    stdone = 1;
+    
+    wall = statclock () - st0;
+    if (stpbm != NULL) {
+        free (stpbm->stats);
+        stpbm->stats = NULL;
+        fp = open_memstream (&stpbm->stats, &stpbm->nstats);
+    } else if (MPIRANK == 0) {
+        fp = fopen("stats.json", "w");
+    } else {
+        fp = NULL;
+    }
+    
+    if (fp != NULL) {
+        fprintf(fp, "{\n  \"status\": \"%s\",\n", (flag == 0) ? "successful" : "failed");
+        fprintf(fp, "  \"analysis\": %d,\n  \"algorithm\": %d,\n  \"solver\": %d,\n", ANAFLAG,
+            ALGFLAG, SLVFLAG);
+        fprintf(fp, "  \"equations\": %ld,\n  \"wall_time\": %.6f,\n", NEQ, wall);
+        fprintf(fp, "  \"bytes_written\": %ld,\n  \"peak_memory_kb\": %ld,\n", statbyte (),
+            statmem ());
+        
+        // Totals of the phases
+        fprintf(fp, "  \"phases\": {");
+        for (i = 0, j = 0; i < NSTAT; ++i) {
+            if (stcnt[i] > 0) {
+                fprintf(fp, "%s\n    \"%s\": {\"calls\": %ld, \"wall_time\": %.6f",
+                    (j++ > 0) ? "," : "", stname[i], stcnt[i], sttim[i]);
+                if (stflop[i] == 1) {
+                    fprintf(fp, ", \"flops\": %.6e", stflp[i]);
+                }
+                fprintf(fp, "}");
+            }
+        }
+        fprintf(fp, "\n  },\n");
+        
+        /* Breakdown by load increment or time step, as the differences of the running totals
+         of consecutive steps */
+        fprintf(fp, "  \"steps_complete\": %s,\n", (mstp < 0) ? "false" : "true");
+        fprintf(fp, "  \"steps\": [");
+        for (k = 0; k < nstp; ++k) {
+            ps = pstep + k * SLEN;
+            pp = (k > 0) ? ps - SLEN : NULL;
+            fprintf(fp, "%s\n    {\"step\": %ld, \"%s\": %e, \"wall_time\": %.6f, ",
+                (k > 0) ? "," : "", k + 1, (ALGFLAG > 3) ? "t" : "lpf", *(ps+SVAL),
+                *(ps+SWALL) - ((pp != NULL) ? *(pp+SWALL) : 0));
+            fprintf(fp, "\"bytes_written\": %.0f, \"peak_memory_kb\": %.0f, \"phases\": {",
+                *(ps+SBYTE) - ((pp != NULL) ? *(pp+SBYTE) : 0), *(ps+SMEM));
+            for (i = 0, j = 0; i < NSTAT; ++i) {
+                if (pp != NULL) {
+                    cnt = *(ps+SCNT+i) - *(pp+SCNT+i);
+                    tim = *(ps+STIM+i) - *(pp+STIM+i);
+                    flp = *(ps+SFLP+i) - *(pp+SFLP+i);
+                } else {
+                    cnt = *(ps+SCNT+i);
+                    tim = *(ps+STIM+i);
+                    flp = *(ps+SFLP+i);
+                }
+                if (cnt > 0 || tim > 0) {
+                    fprintf(fp, "%s\"%s\": {\"calls\": %.0f, \"wall_time\": %.6f",
+                        (j++ > 0) ? ", " : "", stname[i], cnt, tim);
+                    if (stflop[i] == 1) {
+                        fprintf(fp, ", \"flops\": %.6e", flp);
+                    }
+                    fprintf(fp, "}");
+                }
+            }
+            fprintf(fp, "}}");
+        }
+        fprintf(fp, "\n  ]\n}\n");
+        fclose(fp);
+    }
+    
+    // Release the record of the steps
+    free (pstep);
+    pstep = NULL;
+    nstp = mstp = 0;
+}
@@ -0,0 +1,804 @@
+//********************************************************************************
+//**                                                                            **
+//**  Pertains to CU-BEN ver 4.0                                                **
+//**                                                                            **
+//**  CU-BENs: a ship hull modeling finite element library                      **
+//**  Copyright (c) 2019 C. J. Earls                                            **
+//**  Developed by C. J. Earls, Cornell University                              **
+//**  All rights reserved.                                                      **
+//**                                                                            **
+//**  Contributors:                                                             **
+//**    Christopher Stull                                                       **
+//**    Heather Reed                                                            **
+//**    Justyna Kosianka                                                        **
+//**    Wensi Wu                                                                **
+//**                                                                            **
+//**  This program is free software: you can redistribute it and/or modify it   **
+//**  under the terms of the GNU General Public License as published by the     **
+//**  Free Software Foundation, either version 3 of the License, or (at your    **
+//**  option) any later version.                                                **
+//**                                                                            **
+//**  This program is distributed in the hope that it will be useful, but       **
+//**  WITHOUT ANY WARRANTY; without even the implied warranty of                **
+//**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General  **
+//**  Public License for more details.                                          **
+//**                                                                            **
+//**  You should have received a copy of the GNU General Public License along   **
+//**  with this program. If not, see <https://www.gnu.org/licenses/>.           **
+//**                                                                            **
+//********************************************************************************
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "prototypes.h"
+
+extern BEN_TLS long NJ, NE_TR, NE_FR, NE_SH, NE_SBR, NE_FBR, NEQ, NSUP, NEQI;
+extern BEN_TLS int OPTFLAG, OOCFLAG, MPIRANK;
+extern BEN_TLS FILE *IFP[4], *OFP[8];
+
+int superin (long *psup)
+{
+    // Initialize function variables
+    long i, j, t, n, *ps;
+    long ne[3]; // Number of truss, frame, and shell elements
+
+    ne[0] = NE_TR;
+    ne[1] = NE_FR;
+    ne[2] = NE_SH;
+
+    fprintf(OFP[0], "\nSubstructure Instances:\n\t\t\t___Truss Elements___\t");
+    fprintf(OFP[0], "___Frame Elements___\t___Shell Elements___\n\tInstance\tFirst\t\t");
+    fprintf(OFP[0], "Number\t\tFirst\t\tNumber\t\tFirst\t\tNumber\t\tSubstructure\n");
+    for (i = 0; i < NSUP; ++i) {
+        ps = psup + i * SUPLEN;
+        /* Read in element ranges and substructure number from input file; the substructure
+           number is held in place of the first interior equation until the instances are
+           numbered by supercodes */
+        if (fscanf(IFP[0], "%ld,%ld,%ld,%ld,%ld,%ld,%ld\n", ps+SUP_TR, ps+SUP_NTR, ps+SUP_FR,
+            ps+SUP_NFR, ps+SUP_SH, ps+SUP_NSH, ps+SUP_INT) != 7) {
+            fprintf(OFP[0], "\n***ERROR*** Substructure instance input not recognized\n");
+            return 1;
+        }
+        fprintf(OFP[0], "\t%ld\t\t%ld\t\t%ld\t\t%ld\t\t%ld\t\t%ld\t\t%ld\t\t%ld\n", i + 1,
+            *(ps+SUP_TR), *(ps+SUP_NTR), *(ps+SUP_FR), *(ps+SUP_NFR), *(ps+SUP_SH),
+            *(ps+SUP_NSH), *(ps+SUP_INT));
+        if (OPTFLAG == 2) {
+            fprintf(IFP[1], "%ld,%ld,%ld,%ld,%ld,%ld,%ld\n", *(ps+SUP_TR), *(ps+SUP_NTR),
+                *(ps+SUP_FR), *(ps+SUP_NFR), *(ps+SUP_SH), *(ps+SUP_NSH), *(ps+SUP_INT));
+        }
+
+        // Check the element ranges and make the first elements 0-based
+        n = 0;
+        for (t = 0; t < 3; ++t) {
+            if (*(ps+t*2+1) < 0 || (*(ps+t*2+1) > 0 && (*(ps+t*2) < 1 ||
+                *(ps+t*2) - 1 + *(ps+t*2+1) > ne[t]))) {
+                fprintf(OFP[0], "\n***ERROR*** Element range of substructure instance %ld", i + 1);
+                fprintf(OFP[0], " exceeds the elements of the model\n");
+                return 1;
+            }
+            *(ps+t*2) = (*(ps+t*2+1) > 0) ? *(ps+t*2) - 1 : 0;
+            n += *(ps+t*2+1);
+        }
+        if (n == 0 || *(ps+SUP_INT) < 1) {
+            fprintf(OFP[0], "\n***ERROR*** Substructure instance %ld holds no elements or has", i + 1);
+            fprintf(OFP[0], " no substructure number\n");
+            return 1;
+        }
+    }
+
+    /* The first instance of each substructure number defines the substructure, which the
+       others repeat */
+    for (i = 0; i < NSUP; ++i) {
+        *(psup+i*SUPLEN+SUP_MST) = i;
+        for (j = 0; j < i; ++j) {
+            if (*(psup+j*SUPLEN+SUP_INT) == *(psup+i*SUPLEN+SUP_INT)) {
+                *(psup+i*SUPLEN+SUP_MST) = j;
+                break;
+            }
+        }
+    }
+    return 0;
+}
+
+int supercodes (long *psup, long *psupmap, long *pmcode, long *pmcodeg, long *pmcodel,
+    long *pmaxal, long *pjcode, long *pminc, int *pwrpres, long *plssl, long *plsupv)
+{
+    // Initialize function variables
+    long i, j, k, l, n, s, t, e, b, min, ng, ni, nb, nint, lo, moff, voff, *ps, *pm;
+    long nsl[3] = {6, 14, 18}; // Number of DOFs of truss, frame, and shell elements
+    long njt[3] = {2, 2, 3}; // Number of joints of truss, frame, and shell elements
+    long off[3]; // Offsets of truss, frame, and shell elements in mcode
+    long moffc[3]; // Offsets of truss, frame, and shell elements in minc
+    long eoff[3]; // Offsets of truss, frame, and shell elements in the element numbering
+    long ne[3]; // Number of truss, frame, and shell elements
+    long *pown, *pjown, *peown, *pnum, *ploc;
+    int flag = 0;
+
+    off[0] = 0;
+    off[1] = NE_TR * 6;
+    off[2] = NE_TR * 6 + NE_FR * 14;
+    moffc[0] = 0;
+    moffc[1] = NE_TR * 2;
+    moffc[2] = NE_TR * 2 + NE_FR * 2;
+    eoff[0] = 0;
+    eoff[1] = NE_TR;
+    eoff[2] = NE_TR + NE_FR;
+    ne[0] = NE_TR;
+    ne[1] = NE_FR;
+    ne[2] = NE_SH;
+
+    /* Instance of each element and joint, instance of each equation, new number of each
+       equation, and position of each boundary equation among the boundary DOFs of a
+       substructure */
+    long *w = alloc_long (NE_TR+NE_FR+NE_SH+NJ+3*(NEQ+1));
+    if (w == NULL) {
+        return 1;
+    }
+    pown = w;
+    pjown = pown + NE_TR + NE_FR + NE_SH;
+    peown = pjown + NJ;
+    pnum = peown + NEQ + 1;
+    ploc = pnum + NEQ + 1;
+
+    // Find the instance of each element, -1 if it belongs to none
+    for (i = 0; i < NE_TR + NE_FR + NE_SH; ++i) {
+        *(pown+i) = -1;
+    }
+    for (s = 0; s < NSUP; ++s) {
+        ps = psup + s * SUPLEN;
+        for (t = 0; t < 3; ++t) {
+            for (i = *(ps+t*2); i < *(ps+t*2) + *(ps+t*2+1); ++i) {
+                if (*(pown+eoff[t]+i) != -1) {
+                    fprintf(OFP[0], "\n***ERROR*** Substructure instances %ld and %ld",
+                        *(pown+eoff[t]+i) + 1, s + 1);
+                    fprintf(OFP[0], " share elements\n");
+                    free (w);
+                    return 1;
+                }
+                *(pown+eoff[t]+i) = s;
+            }
+        }
+    }
+
+    /* Find the instance of each joint: a joint is interior to an instance if all of its
+       elements belong to the instance, and a boundary joint (NSUP) otherwise */
+    for (i = 0; i < NJ; ++i) {
+        *(pjown+i) = -1;
+    }
+    for (t = 0; t < 3; ++t) {
+        for (i = 0; i < ne[t]; ++i) {
+            s = (*(pown+eoff[t]+i) != -1) ? *(pown+eoff[t]+i) : NSUP;
+            for (l = 0; l < njt[t]; ++l) {
+                j = *(pminc+moffc[t]+i*njt[t]+l) - 1;
+                if (*(pjown+j) == -1) {
+                    *(pjown+j) = s;
+                } else if (*(pjown+j) != s) {
+                    *(pjown+j) = NSUP;
+                }
+            }
+        }
+    }
+    for (i = 0; i < (NE_SBR + NE_FBR) * 8; ++i) {
+        *(pjown+*(pminc+NE_TR*2+NE_FR*2+NE_SH*3+i)-1) = NSUP;
+    }
+    /* Joints with a warping DOF per frame element (see codes) are kept as boundary joints,
+       so that their warping DOFs stay numbered in sequence */
+    for (i = 0; i < NJ; ++i) {
+        if (*(pwrpres+i*3) == 1 && *(pwrpres+i*3+1) > 1) {
+            *(pjown+i) = NSUP;
+        }
+    }
+
+    // Find the instance of each equation, -1 for the equations of the structure
+    for (e = 0; e <= NEQ; ++e) {
+        *(peown+e) = -1;
+        *(pnum+e) = 0;
+        *(ploc+e) = -1;
+    }
+    for (i = 0; i < NJ; ++i) {
+        if (*(pjown+i) >= 0 && *(pjown+i) < NSUP) {
+            for (k = 0; k < 7; ++k) {
+                e = *(pjcode+i*7+k);
+                if (e != 0) {
+                    *(peown+e) = *(pjown+i);
+                }
+            }
+        }
+    }
+
+    // Number the equations of the structure first, in their original sequence
+    ng = 0;
+    for (e = 1; e <= NEQ; ++e) {
+        if (*(peown+e) == -1) {
+            *(pnum+e) = ++ng;
+        }
+    }
+
+    /* Number the interior equations of each instance after them, in the sequence in which
+       its elements first refer to them, so that the instances of a substructure number
+       their interior DOFs alike */
+    ni = 0;
+    for (s = 0; s < NSUP; ++s) {
+        ps = psup + s * SUPLEN;
+        *(ps+SUP_INT) = ni;
+        for (t = 0; t < 3; ++t) {
+            for (i = *(ps+t*2); i < *(ps+t*2) + *(ps+t*2+1); ++i) {
+                for (k = 0; k < nsl[t]; ++k) {
+                    e = *(pmcode+off[t]+i*nsl[t]+k);
+                    if (e != 0 && *(peown+e) == s && *(pnum+e) == 0) {
+                        *(pnum+e) = ng + (++ni);
+                    }
+                }
+            }
+        }
+        // DOFs of interior joints to which no element refers
+        for (i = 0; i < NJ; ++i) {
+            if (*(pjown+i) == s) {
+                for (k = 0; k < 7; ++k) {
+                    e = *(pjcode+i*7+k);
+                    if (e != 0 && *(pnum+e) == 0) {
+                        *(pnum+e) = ng + (++ni);
+                    }
+                }
+            }
+        }
+        *(ps+SUP_NINT) = ni - *(ps+SUP_INT);
+    }
+
+    /* Renumber jcode and mcode; mcodeg is mcode without the elements of the instances,
+       which enter the structure stiffness matrix through their condensed stiffness matrices
+       only */
+    for (i = 0; i < NJ * 7; ++i) {
+        if (*(pjcode+i) != 0) {
+            *(pjcode+i) = *(pnum+*(pjcode+i));
+        }
+    }
+    for (i = 0; i < NE_TR * 6 + NE_FR * 14 + NE_SH * 18 + (NE_SBR + NE_FBR) * 24; ++i) {
+        if (*(pmcode+i) != 0) {
+            *(pmcode+i) = *(pnum+*(pmcode+i));
+        }
+        *(pmcodeg+i) = *(pmcode+i);
+        *(pmcodel+i) = 0;
+    }
+    for (s = 0; s < NSUP; ++s) {
+        ps = psup + s * SUPLEN;
+        for (t = 0; t < 3; ++t) {
+            for (i = *(ps+t*2); i < *(ps+t*2) + *(ps+t*2+1); ++i) {
+                for (k = 0; k < nsl[t]; ++k) {
+                    *(pmcodeg+off[t]+i*nsl[t]+k) = 0;
+                }
+            }
+        }
+    }
+    NEQ = ng;
+    NEQI = ni;
+
+    /* Number the DOFs of each substructure on the local skyline, interior DOFs first, and
+       map the boundary DOFs of each instance to the equations of the structure */
+    lo = moff = voff = 0;
+    for (s = 0; s < NSUP && flag == 0; ++s) {
+        ps = psup + s * SUPLEN;
+        pm = psup + *(ps+SUP_MST) * SUPLEN;
+        nint = *(ps+SUP_NINT);
+        *(ps+SUP_MAP) = moff;
+        if (pm == ps) {
+            /* Number the boundary DOFs in the sequence in which the elements first refer to
+               them */
+            nb = 0;
+            for (t = 0; t < 3; ++t) {
+                for (i = *(ps+t*2); i < *(ps+t*2) + *(ps+t*2+1); ++i) {
+                    for (k = 0; k < nsl[t]; ++k) {
+                        e = *(pmcode+off[t]+i*nsl[t]+k);
+                        if (e != 0 && e <= NEQ && *(ploc+e) == -1) {
+                            *(ploc+e) = nb;
+                            *(psupmap+moff+nb) = e;
+                            nb++;
+                        }
+                    }
+                }
+            }
+
+            // Generate the local mcode of the substructure
+            for (t = 0; t < 3; ++t) {
+                for (i = *(ps+t*2); i < *(ps+t*2) + *(ps+t*2+1); ++i) {
+                    for (k = 0; k < nsl[t]; ++k) {
+                        e = *(pmcode+off[t]+i*nsl[t]+k);
+                        if (e > NEQ) {
+                            *(pmcodel+off[t]+i*nsl[t]+k) = lo + e - NEQ - *(ps+SUP_INT);
+                        } else if (e != 0) {
+                            *(pmcodel+off[t]+i*nsl[t]+k) = lo + nint + *(ploc+e) + 1;
+                        }
+                    }
+                }
+            }
+            for (k = 0; k < nb; ++k) {
+                *(ploc+*(psupmap+moff+k)) = -1;
+            }
+            *(ps+SUP_NBND) = nb;
+            *(ps+SUP_LOC) = lo;
+            *(ps+SUP_VAL) = voff;
+            lo += nint + nb;
+            voff += nb * nb;
+        } else {
+            /* Map the boundary DOFs of the instance through the elements corresponding to
+               those of the substructure; a boundary DOF of the substructure may be
+               constrained in the instance, but the interior DOFs must correspond */
+            nb = *(pm+SUP_NBND);
+            *(ps+SUP_NBND) = nb;
+            *(ps+SUP_LOC) = *(pm+SUP_LOC);
+            *(ps+SUP_VAL) = *(pm+SUP_VAL);
+            for (k = 0; k < nb; ++k) {
+                *(psupmap+moff+k) = -1;
+            }
+            if (nint != *(pm+SUP_NINT) || *(ps+SUP_NTR) != *(pm+SUP_NTR) ||
+                *(ps+SUP_NFR) != *(pm+SUP_NFR) || *(ps+SUP_NSH) != *(pm+SUP_NSH)) {
+                flag = 1;
+            }
+            for (t = 0; t < 3 && flag == 0; ++t) {
+                for (n = 0; n < *(ps+t*2+1); ++n) {
+                    for (k = 0; k < nsl[t]; ++k) {
+                        l = *(pmcodel+off[t]+(*(pm+t*2)+n)*nsl[t]+k);
+                        e = *(pmcode+off[t]+(*(ps+t*2)+n)*nsl[t]+k);
+                        if (l == 0) {
+                            if (e != 0) {
+                                flag = 1;
+                            }
+                            continue;
+                        }
+                        l -= *(pm+SUP_LOC) + 1;
+                        if (l < nint) {
+                            if (e - NEQ - 1 - *(ps+SUP_INT) != l) {
+                                flag = 1;
+                            }
+                        } else {
+                            b = l - nint;
+                            if (e > NEQ) {
+                                flag = 1;
+                            } else if (*(psupmap+moff+b) == -1) {
+                                *(psupmap+moff+b) = e;
+                            } else if (*(psupmap+moff+b) != e) {
+                                flag = 1;
+                            }
+                        }
+                    }
+                }
+            }
+            if (flag == 1) {
+                fprintf(OFP[0], "\n***ERROR*** Substructure instance %ld does not repeat the",
+                    s + 1);
+                fprintf(OFP[0], " elements and DOFs of instance %ld\n", *(ps+SUP_MST) + 1);
+            }
+        }
+        moff += nb;
+    }
+    free (w);
+    if (flag == 1) {
+        return 1;
+    }
+
+    /* Define the column heights of the local skyline, held in maxal until maxal is formed
+       from them, as in skylin */
+    for (i = 0; i <= lo; ++i) {
+        *(pmaxal+i) = 0;
+    }
+    for (s = 0; s < NSUP; ++s) {
+        ps = psup + s * SUPLEN;
+        if (*(ps+SUP_MST) != s) {
+            continue;
+        }
+        for (t = 0; t < 3; ++t) {
+            for (i = *(ps+t*2); i < *(ps+t*2) + *(ps+t*2+1); ++i) {
+                min = lo + 1;
+                for (k = 0; k < nsl[t]; ++k) {
+                    l = *(pmcodel+off[t]+i*nsl[t]+k);
+                    if (l > 0 && l < min) {
+                        min = l;
+                    }
+                }
+                for (k = 0; k < nsl[t]; ++k) {
+                    l = *(pmcodel+off[t]+i*nsl[t]+k);
+                    if (l != 0 && l - min > *(pmaxal+l)) {
+                        *(pmaxal+l) = l - min;
+                    }
+                }
+            }
+        }
+    }
+    *pmaxal = 1;
+    for (i = 0; i < lo; ++i) {
+        *(pmaxal+i+1) += *(pmaxal+i) + 1;
+    }
+    *plssl = *(pmaxal+lo) - 1;
+    *plsupv = voff;
+
+    fprintf(OFP[0], "\nSubstructure Equations:\n\tInstance\tSubstructure\tInterior\t");
+    fprintf(OFP[0], "Boundary\n");
+    for (s = 0; s < NSUP; ++s) {
+        ps = psup + s * SUPLEN;
+        fprintf(OFP[0], "\t%ld\t\t%ld\t\t%ld\t\t%ld\n", s + 1, *(ps+SUP_MST) + 1,
+            *(ps+SUP_NINT), *(ps+SUP_NBND));
+    }
+    return 0;
+}
+
+int supereq (double a, double b, double c)
+{
+    return (fabs(a - b) <= 1e-9 * c) ? 1 : 0;
+}
+
+int superchk (long *psup, long *pminc, double *px, double *pemod, double *pgmod,
+    double *pnu, double *pcarea, double *pthick, double *pistrong, double *piweak,
+    double *pipolar, double *piwarp, double *poffset, int *posflag, int *pmendrel,
+    double *pc1, double *pc2, double *pc3)
+{
+    // Initialize function variables
+    long i, k, l, n, s, t, jc, jm, ec, em, *ps, *pm;
+    long njt[3] = {2, 2, 3}; // Number of joints of truss, frame, and shell elements
+    long moffc[3]; // Offsets of truss, frame, and shell elements in minc
+    long eoff[3]; // Offsets of truss, frame, and shell elements in the element numbering
+    double T[3]; // Translation of the instance from the instance defining its substructure
+    int flag;
+
+    moffc[0] = 0;
+    moffc[1] = NE_TR * 2;
+    moffc[2] = NE_TR * 2 + NE_FR * 2;
+    eoff[0] = 0;
+    eoff[1] = NE_TR;
+    eoff[2] = NE_TR + NE_FR;
+
+    for (s = 0; s < NSUP; ++s) {
+        ps = psup + s * SUPLEN;
+        pm = psup + *(ps+SUP_MST) * SUPLEN;
+        if (pm == ps) {
+            continue;
+        }
+        flag = 0;
+
+        /* Translation of the instance, from the first joint of its first element; the
+           joints of all of its elements must be translated alike */
+        t = 0;
+        while (*(ps+t*2+1) == 0) {
+            t++;
+        }
+        jc = *(pminc+moffc[t]+*(ps+t*2)*njt[t]) - 1;
+        jm = *(pminc+moffc[t]+*(pm+t*2)*njt[t]) - 1;
+        for (k = 0; k < 3; ++k) {
+            T[k] = *(px+jc*3+k) - *(px+jm*3+k);
+        }
+
+        for (t = 0; t < 3; ++t) {
+            for (n = 0; n < *(ps+t*2+1); ++n) {
+                ec = *(ps+t*2) + n;
+                em = *(pm+t*2) + n;
+                for (l = 0; l < njt[t]; ++l) {
+                    jc = *(pminc+moffc[t]+ec*njt[t]+l) - 1;
+                    jm = *(pminc+moffc[t]+em*njt[t]+l) - 1;
+                    for (k = 0; k < 3; ++k) {
+                        flag |= !supereq (*(px+jc*3+k) - *(px+jm*3+k), T[k],
+                            fabs(*(px+jc*3+k)) + fabs(*(px+jm*3+k)) + fabs(T[k]));
+                    }
+                }
+                flag |= !supereq (*(pemod+eoff[t]+ec), *(pemod+eoff[t]+em),
+                    fabs(*(pemod+eoff[t]+ec)));
+
+                // Direction cosines and section properties
+                if (t == 0) {
+                    flag |= !supereq (*(pc1+ec), *(pc1+em), 1);
+                    flag |= !supereq (*(pc2+ec), *(pc2+em), 1);
+                    flag |= !supereq (*(pc3+ec), *(pc3+em), 1);
+                    flag |= !supereq (*(pcarea+ec), *(pcarea+em), fabs(*(pcarea+ec)));
+                } else if (t == 1) {
+                    for (k = 0; k < 3; ++k) {
+                        flag |= !supereq (*(pc1+NE_TR+ec*3+k), *(pc1+NE_TR+em*3+k), 1);
+                        flag |= !supereq (*(pc2+NE_TR+ec*3+k), *(pc2+NE_TR+em*3+k), 1);
+                        flag |= !supereq (*(pc3+NE_TR+ec*3+k), *(pc3+NE_TR+em*3+k), 1);
+                    }
+                    flag |= !supereq (*(pcarea+NE_TR+ec), *(pcarea+NE_TR+em),
+                        fabs(*(pcarea+NE_TR+ec)));
+                    flag |= !supereq (*(pgmod+ec), *(pgmod+em), fabs(*(pgmod+ec)));
+                    flag |= !supereq (*(pistrong+ec), *(pistrong+em), fabs(*(pistrong+ec)));
+                    flag |= !supereq (*(piweak+ec), *(piweak+em), fabs(*(piweak+ec)));
+                    flag |= !supereq (*(pipolar+ec), *(pipolar+em), fabs(*(pipolar+ec)));
+                    flag |= !supereq (*(piwarp+ec), *(piwarp+em), fabs(*(piwarp+ec)));
+                    flag |= (*(posflag+ec) != *(posflag+em));
+                    for (k = 0; k < 6; ++k) {
+                        flag |= !supereq (*(poffset+ec*6+k), *(poffset+em*6+k),
+                            fabs(*(poffset+ec*6+k)));
+                    }
+                    for (k = 0; k < 5; ++k) {
+                        flag |= (*(pmendrel+ec*5+k) != *(pmendrel+em*5+k));
+                    }
+                } else {
+                    i = NE_TR + NE_FR * 3;
+                    for (k = 0; k < 3; ++k) {
+                        flag |= !supereq (*(pc1+i+ec*3+k), *(pc1+i+em*3+k), 1);
+                        flag |= !supereq (*(pc2+i+ec*3+k), *(pc2+i+em*3+k), 1);
+                        flag |= !supereq (*(pc3+i+ec*3+k), *(pc3+i+em*3+k), 1);
+                    }
+                    flag |= !supereq (*(pnu+ec), *(pnu+em), fabs(*(pnu+ec)));
+                    flag |= !supereq (*(pthick+ec), *(pthick+em), fabs(*(pthick+ec)));
+                }
+            }
+        }
+        if (flag != 0) {
+            fprintf(OFP[0], "\n***ERROR*** Substructure instance %ld does not repeat the", s + 1);
+            fprintf(OFP[0], " geometry and properties of instance %ld\n", *(ps+SUP_MST) + 1);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int supercond (long *psup, long *pmaxal, double *pssl, double *psupv)
+{
+    // Initialize function variables
+    long i, j, k, r, c, n, s, nint, nb, nfac, neq, *ps, *pm;
+    long hdr[3]; // Interior and boundary DOFs, and length of the factorized interior block
+    int det, oocflag, flag, errchk;
+    unsigned long long key; // FNV-1a hash of the substructure stiffness matrix
+    unsigned char *pc;
+    double sum, *pkc, *py, *pf;
+    char name[32];
+    FILE *fp;
+
+    // Work vector of the interior DOFs of the largest substructure
+    n = 1;
+    for (s = 0; s < NSUP; ++s) {
+        if (*(psup+s*SUPLEN+SUP_NINT) > n) {
+            n = *(psup+s*SUPLEN+SUP_NINT);
+        }
+    }
+    py = alloc_dbl (n);
+    if (py == NULL) {
+        return 1;
+    }
+
+    for (s = 0; s < NSUP; ++s) {
+        ps = psup + s * SUPLEN;
+        if (*(ps+SUP_MST) != s) {
+            continue;
+        }
+        nint = *(ps+SUP_NINT);
+        nb = *(ps+SUP_NBND);
+        pm = pmaxal + *(ps+SUP_LOC);
+        pkc = psupv + *(ps+SUP_VAL);
+        nfac = *(pm+nint) - *pm;
+
+        /* Key the cache on the stiffness matrix of the substructure, which reflects its
+           geometry and material, and on its skyline profile */
+        key = 14695981039346656037ULL;
+        hdr[0] = nint;
+        hdr[1] = nb;
+        hdr[2] = nfac;
+        pc = (unsigned char *) hdr;
+        for (i = 0; i < (long) sizeof(hdr); ++i) {
+            key = (key ^ *(pc+i)) * 1099511628211ULL;
+        }
+        for (i = 0; i <= nint + nb; ++i) {
+            k = *(pm+i) - *pm;
+            pc = (unsigned char *) &k;
+            for (j = 0; j < (long) sizeof(long); ++j) {
+                key = (key ^ *(pc+j)) * 1099511628211ULL;
+            }
+        }
+        pc = (unsigned char *) (pssl + *pm - 1);
+        for (i = 0; i < (*(pm+nint+nb) - *pm) * (long) sizeof(double); ++i) {
+            key = (key ^ *(pc+i)) * 1099511628211ULL;
+        }
+        sprintf(name, "super_%016llx.bin", key);
+
+        /* Read the condensed stiffness matrix and the factorized interior block from the
+           cache; the factorized block is read aside, so that an incomplete file leaves the
+           assembled block in place */
+        flag = 0;
+        pf = alloc_dbl ((nfac > 0) ? nfac : 1);
+        if (pf == NULL) {
+            free (py);
+            return 1;
+        }
+        fp = fopen(name, "rb");
+        if (fp != NULL) {
+            if (fread(hdr, sizeof(long), 3, fp) == 3 && hdr[0] == nint && hdr[1] == nb &&
+                hdr[2] == nfac && fread(pkc, sizeof(double), nb*nb, fp) == (size_t) (nb*nb) &&
+                fread(pf, sizeof(double), nfac, fp) == (size_t) nfac) {
+                flag = 1;
+            }
+            fclose(fp);
+        }
+        if (flag == 1) {
+            for (i = 0; i < nfac; ++i) {
+                *(pssl+*pm-1+i) = *(pf+i);
+            }
+            fprintf(OFP[0], "\nSubstructure of instance %ld: condensed stiffness matrix read", s + 1);
+            fprintf(OFP[0], " from %s\n", name);
+            free (pf);
+            continue;
+        }
+        free (pf);
+
+        /* Factorize the interior block Kii, the first nint equations of the substructure on
+           the local skyline, in place */
+        neq = NEQ;
+        oocflag = OOCFLAG;
+        NEQ = nint;
+        OOCFLAG = 0;
+        errchk = skyfact (pm, pssl, NULL, NULL, 0, &det);
+        NEQ = neq;
+        OOCFLAG = oocflag;
+        if (errchk == 1) {
+            fprintf(OFP[0], "\n***ERROR*** Interior stiffness matrix of the substructure of");
+            fprintf(OFP[0], " instance %ld is not positive definite\n", s + 1);
+            free (py);
+            return 1;
+        }
+
+        /* Condense the stiffness matrix onto the boundary DOFs, Kc = Kbb - Kbi Kii^-1 Kib,
+           by columns: column j of Kib, whose entries are held above the interior rows of
+           skyline column nint + j, is solved with the factorized interior block */
+        for (j = 0; j < nb; ++j) {
+            c = nint + j;
+            for (r = 0; r < nint; ++r) {
+                *(py+r) = 0;
+            }
+            for (k = *(pm+c) + 1; k < *(pm+c+1); ++k) {
+                r = c - (k - *(pm+c));
+                if (r < nint) {
+                    *(py+r) = *(pssl+k-1);
+                }
+            }
+            skyrange (pm, pssl, py, 0, nint);
+            for (i = 0; i <= j; ++i) {
+                sum = 0;
+                if (c - (nint + i) < *(pm+c+1) - *(pm+c)) {
+                    sum = *(pssl+*(pm+c)+c-(nint+i)-1);
+                }
+                for (k = *(pm+nint+i) + 1; k < *(pm+nint+i+1); ++k) {
+                    r = nint + i - (k - *(pm+nint+i));
+                    if (r < nint) {
+                        sum -= *(pssl+k-1) * (*(py+r));
+                    }
+                }
+                *(pkc+i*nb+j) = *(pkc+j*nb+i) = sum;
+            }
+        }
+
+        // Write the condensed stiffness matrix and the factorized interior block to the cache
+        if (MPIRANK == 0) {
+            fp = fopen(name, "wb");
+            if (fp == NULL || fwrite(hdr, sizeof(long), 3, fp) != 3 ||
+                fwrite(pkc, sizeof(double), nb*nb, fp) != (size_t) (nb*nb) ||
+                fwrite(pssl+*pm-1, sizeof(double), nfac, fp) != (size_t) nfac) {
+                fprintf(OFP[0], "\n***WARNING*** Unable to write %s\n", name);
+                if (fp != NULL) {
+                    fclose(fp);
+                    remove(name);
+                }
+            } else {
+                fclose(fp);
+                fprintf(OFP[0], "\nSubstructure of instance %ld: condensed stiffness matrix",
+                    s + 1);
+                fprintf(OFP[0], " written to %s\n", name);
+            }
+        }
+    }
+    free (py);
+    return 0;
+}
+
+int superasm (double *pss, double *pq, long *pmaxa, long *psup, long *psupmap,
+    long *pmaxal, double *pssl, double *psupv)
+{
+    // Initialize function variables
+    long i, j, k, r, c, n, s, nint, nb, I, J, *ps, *pmap, *pm;
+    double sum, *pkc, *py;
+
+    // Work vector of the interior DOFs of the largest substructure
+    n = 1;
+    for (s = 0; s < NSUP; ++s) {
+        if (*(psup+s*SUPLEN+SUP_NINT) > n) {
+            n = *(psup+s*SUPLEN+SUP_NINT);
+        }
+    }
+    py = alloc_dbl (n);
+    if (py == NULL) {
+        return 1;
+    }
+
+    for (s = 0; s < NSUP; ++s) {
+        ps = psup + s * SUPLEN;
+        nint = *(ps+SUP_NINT);
+        nb = *(ps+SUP_NBND);
+        pmap = psupmap + *(ps+SUP_MAP);
+        pm = pmaxal + *(ps+SUP_LOC);
+        pkc = psupv + *(ps+SUP_VAL);
+
+        /* Assign the condensed stiffness matrix to the structure stiffness matrix by the
+           boundary map, as the element stiffness matrices are by mcode; boundary DOFs
+           constrained in the instance are mapped to zero */
+        for (j = 0; j < nb; ++j) {
+            J = *(pmap+j);
+            if (J != 0) {
+                for (i = 0; i < nb; ++i) {
+                    I = *(pmap+i);
+                    if (I != 0 && I <= J) {
+                        *(pss+*(pmaxa+J-1)+(J-I)-1) += *(pkc+i*nb+j);
+                    }
+                }
+            }
+        }
+
+        // Condense the loads on the interior DOFs, q_b - Kbi Kii^-1 q_i
+        for (r = 0; r < nint; ++r) {
+            *(py+r) = *(pq+NEQ+*(ps+SUP_INT)+r);
+        }
+        skyrange (pm, pssl, py, 0, nint);
+        for (j = 0; j < nb; ++j) {
+            J = *(pmap+j);
+            if (J != 0) {
+                c = nint + j;
+                sum = 0;
+                for (k = *(pm+c) + 1; k < *(pm+c+1); ++k) {
+                    r = c - (k - *(pm+c));
+                    if (r < nint) {
+                        sum += *(pssl+k-1) * (*(py+r));
+                    }
+                }
+                *(pq+J-1) -= sum;
+            }
+        }
+    }
+    free (py);
+    return 0;
+}
+
+int superrec (double *pd, double *pq, long *psup, long *psupmap, long *pmaxal, double *pssl)
+{
+    // Initialize function variables
+    long j, k, r, c, n, s, nint, nb, J, *ps, *pmap, *pm;
+    double *py;
+
+    // Work vector of the interior DOFs of the largest substructure
+    n = 1;
+    for (s = 0; s < NSUP; ++s) {
+        if (*(psup+s*SUPLEN+SUP_NINT) > n) {
+            n = *(psup+s*SUPLEN+SUP_NINT);
+        }
+    }
+    py = alloc_dbl (n);
+    if (py == NULL) {
+        return 1;
+    }
+
+    // Recover the interior displacements of each instance, d_i = Kii^-1 (q_i - Kib d_b)
+    for (s = 0; s < NSUP; ++s) {
+        ps = psup + s * SUPLEN;
+        nint = *(ps+SUP_NINT);
+        nb = *(ps+SUP_NBND);
+        pmap = psupmap + *(ps+SUP_MAP);
+        pm = pmaxal + *(ps+SUP_LOC);
+        for (r = 0; r < nint; ++r) {
+            *(py+r) = *(pq+NEQ+*(ps+SUP_INT)+r);
+        }
+        for (j = 0; j < nb; ++j) {
+            J = *(pmap+j);
+            if (J != 0) {
+                c = nint + j;
+                for (k = *(pm+c) + 1; k < *(pm+c+1); ++k) {
+                    r = c - (k - *(pm+c));
+                    if (r < nint) {
+                        *(py+r) -= *(pssl+k-1) * (*(pd+J-1));
+                    }
+                }
+            }
+        }
+        skyrange (pm, pssl, py, 0, nint);
+        for (r = 0; r < nint; ++r) {
+            *(pd+NEQ+*(ps+SUP_INT)+r) = *(py+r);
+        }
+    }
+    free (py);
+    return 0;
+}
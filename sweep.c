@@ -0,0 +1,300 @@
+//********************************************************************************
+//**                                                                            **
+//**  Pertains to CU-BEN ver 4.0                                                **
+//**                                                                            **
+//**  CU-BENs: a ship hull modeling finite element library                      **
+//**  Copyright (c) 2019 C. J. Earls                                            **
+//**  Developed by C. J. Earls, Cornell University                              **
+//**  All rights reserved.                                                      **
+//**                                                                            **
+//**  Contributors:                                                             **
+//**    Christopher Stull                                                       **
+//**    Heather Reed                                                            **
+//**    Justyna Kosianka                                                        **
+//**    Wensi Wu                                                                **
+//**                                                                            **
+//**  This program is free software: you can redistribute it and/or modify it   **
+//**  under the terms of the GNU General Public License as published by the     **
+//**  Free Software Foundation, either version 3 of the License, or (at your    **
+//**  option) any later version.                                                **
+//**                                                                            **
+//**  This program is distributed in the hope that it will be useful, but       **
+//**  WITHOUT ANY WARRANTY; without even the implied warranty of                **
+//**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General  **
+//**  Public License for more details.                                          **
+//**                                                                            **
+//**  You should have received a copy of the GNU General Public License along   **
+//**  with this program. If not, see <https://www.gnu.org/licenses/>.           **
+//**                                                                            **
+//********************************************************************************
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "prototypes.h"
+
+/* Parameter sweep driver (make bensweep.exe): analyzes variants of the model in model_def.txt
+   concurrently through the library interface (see library.c), the variants differing in the
+   element properties or joint loads given in sweep_def.txt:
+ 
+    enter number of variants and number of threads (0 for one thread per processor) - nvar,nthr
+    for each variant, enter its overrides; enter 0,0,0,0 after the last override of the variant:
+        kind of override:
+            1 - truss element property; field = 1 to 4 in the order of the property input line:
+                elastic modulus, area, density, yield stress
+            2 - frame element property; field = 1 to 11 in the order of the property and yield
+                criteria input lines: elastic modulus, shear modulus, density, area, strong-axis,
+                weak-axis, polar, and warping moments of inertia, yield stress, strong-axis and
+                weak-axis plastic section moduli
+            3 - shell element property; field = 1 to 5 in the order of the property input line:
+                elastic modulus, Poisson's ratio, thickness, density, yield stress
+            4 - joint load (static analysis only); field = direction, 1 to 7
+        number of the element or joint (as in model_def.txt)
+        field
+        value
+        *** enter on single line as: kind,num,field,value
+ 
+   The results of variant k (k = 1 to nvar) are written to results1_k.txt to results7_k.txt,
+   and its statistics to stats_k.json.
+   The node-numbering scheme (OPTFLAG = 2) is determined once, by a setup analysis that stops
+   after struc, and shared by all variants; the input is still read, and the profile of the
+   stiffness matrix still determined, by each variant. With one thread per processor, setting
+   OMP_NUM_THREADS=1 keeps the threaded loops of the variants from oversubscribing the
+   processors. */
+
+static BENMODEL **pvar; // Variants
+static int *perr; // Error flag of each variant
+static long nvar, next; // Number of variants, and next variant to be analyzed
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER; // Guards next
+
+int main (void)
+{
+    // Initialize function variables
+    FILE *fp;
+    char *text;
+    long len, i, k, nov, nfail;
+    long *povk;
+    double *povv;
+    int nthr;
+    pthread_t *thread;
+    BENMODEL *pbase;
+    
+    // Read in the model
+    fp = fopen("model_def.txt", "r");
+    if (fp == NULL) {
+        fprintf(stderr, "\n***ERROR*** Unable to open model_def.txt\n");
+        return 1;
+    }
+    fseek (fp, 0, SEEK_END);
+    len = ftell (fp);
+    fseek (fp, 0, SEEK_SET);
+    text = (char *) malloc (len + 1);
+    if (text == NULL || fread (text, 1, len, fp) != (size_t) len) {
+        fprintf(stderr, "\n***ERROR*** Unable to read model_def.txt\n");
+        fclose(fp);
+        free (text);
+        return 1;
+    }
+    fclose(fp);
+    
+    // Determine the node-numbering scheme shared by the variants
+    pbase = ben_create (text, len);
+    if (pbase == NULL) {
+        free (text);
+        return 1;
+    }
+    pbase->setup = 1;
+    if (ben_run (pbase) == 1) {
+        fprintf(stderr, "\n***ERROR*** Setup of the sweep failed (see results1_0.txt)\n");
+        sweepwrite (pbase, 0);
+        ben_free (pbase);
+        free (text);
+        return 1;
+    }
+    
+    // Read in the variants
+    fp = fopen("sweep_def.txt", "r");
+    if (fp == NULL) {
+        fprintf(stderr, "\n***ERROR*** Unable to open sweep_def.txt\n");
+        ben_free (pbase);
+        free (text);
+        return 1;
+    }
+    if (fscanf(fp, "%ld,%d\n", &nvar, &nthr) != 2 || nvar < 1 || nthr < 0) {
+        fprintf(stderr, "\n***ERROR*** Invalid number of variants or threads in sweep_def.txt\n");
+        fclose(fp);
+        ben_free (pbase);
+        free (text);
+        return 1;
+    }
+    pvar = (BENMODEL **) calloc (nvar, sizeof (BENMODEL *));
+    perr = (int *) calloc (nvar, sizeof (int));
+    if (pvar == NULL || perr == NULL) {
+        goto EXIT;
+    }
+    for (k = 0; k < nvar; ++k) {
+        *(pvar+k) = ben_create (text, len);
+        if (*(pvar+k) == NULL) {
+            goto EXIT;
+        }
+        (*(pvar+k))->jnt = pbase->jnt;
+        
+        nov = 0;
+        do {
+            povk = (long *) realloc ((*(pvar+k))->povk, (nov + 1) * 3 * sizeof (long));
+            if (povk == NULL) {
+                goto EXIT;
+            }
+            (*(pvar+k))->povk = povk;
+            povv = (double *) realloc ((*(pvar+k))->povv, (nov + 1) * sizeof (double));
+            if (povv == NULL) {
+                goto EXIT;
+            }
+            (*(pvar+k))->povv = povv;
+            if (fscanf(fp, "%ld,%ld,%ld,%lf\n", povk+nov*3, povk+nov*3+1, povk+nov*3+2,
+                povv+nov) != 4) {
+                fprintf(stderr, "\n***ERROR*** Invalid overrides of variant %ld in sweep_def.txt\n",
+                    k + 1);
+                goto EXIT;
+            }
+        } while (*(povk+(nov++)*3) != 0);
+        (*(pvar+k))->nov = nov - 1;
+    }
+    fclose(fp);
+    fp = NULL;
+    
+    // Analyze the variants on a pool of threads
+    if (nthr == 0) {
+        nthr = (int) sysconf (_SC_NPROCESSORS_ONLN);
+    }
+    if (nthr < 1) {
+        nthr = 1;
+    }
+    if (nthr > nvar) {
+        nthr = (int) nvar;
+    }
+    thread = (pthread_t *) malloc (nthr * sizeof (pthread_t));
+    if (thread == NULL) {
+        goto EXIT;
+    }
+    next = 0;
+    for (i = 0; i < nthr; ++i) {
+        if (pthread_create (thread+i, NULL, sweepthread, NULL) != 0) {
+            break;
+        }
+    }
+    if (i == 0) {
+        // Analyze the variants on the main thread if no thread could be created
+        sweepthread (NULL);
+    }
+    nthr = (int) i;
+    for (i = 0; i < nthr; ++i) {
+        pthread_join (*(thread+i), NULL);
+    }
+    free (thread);
+    
+    // Report the outcome of each variant
+    nfail = 0;
+    for (k = 0; k < nvar; ++k) {
+        if (*(perr+k) == 0) {
+            printf("Variant %ld: solution successful\n", k + 1);
+        } else {
+            printf("Variant %ld: solution failed (see results1_%ld.txt)\n", k + 1, k + 1);
+            nfail++;
+        }
+    }
+    
+    free (pvar);
+    free (perr);
+    ben_free (pbase);
+    free (text);
+    return (nfail > 0);
+    
+EXIT:
+    fprintf(stderr, "\n***ERROR*** Setup of the sweep failed\n");
+    if (fp != NULL) {
+        fclose(fp);
+    }
+    if (pvar != NULL) {
+        for (k = 0; k < nvar; ++k) {
+            if (*(pvar+k) != NULL) {
+                (*(pvar+k))->jnt = NULL; // Held by the setup
+                ben_free (*(pvar+k));
+            }
+        }
+    }
+    free (pvar);
+    free (perr);
+    ben_free (pbase);
+    free (text);
+    return 1;
+}
+
+void * sweepthread (void *arg)
+{
+    // Initialize function variables
+    long k;
+    
+    while (1) {
+        pthread_mutex_lock (&lock);
+        k = next++;
+        pthread_mutex_unlock (&lock);
+        if (k >= nvar) {
+            break;
+        }
+        
+        // Analyze the variant, write out its results, and release it
+        *(perr+k) = ben_run (*(pvar+k));
+        if (sweepwrite (*(pvar+k), k + 1) == 1) {
+            *(perr+k) = 1;
+        }
+        (*(pvar+k))->jnt = NULL; // Held by the setup
+        ben_free (*(pvar+k));
+        *(pvar+k) = NULL;
+    }
+    
+    return arg;
+}
+
+int sweepwrite (BENMODEL *pbm, long k)
+{
+    // Initialize function variables
+    FILE *fp;
+    const char *res;
+    size_t len;
+    char file[32];
+    int i, errchk;
+    
+    errchk = 0;
+    for (i = 1; i <= 7; ++i) {
+        res = ben_result (pbm, i, &len);
+        if (res == NULL) {
+            continue;
+        }
+        sprintf(file, "results%d_%ld.txt", i, k);
+        fp = fopen(file, "w");
+        if (fp == NULL || fwrite (res, 1, len, fp) != len) {
+            errchk = 1;
+        }
+        if (fp != NULL) {
+            fclose(fp);
+        }
+    }
+    res = ben_stats (pbm, &len);
+    if (res != NULL) {
+        sprintf(file, "stats_%ld.json", k);
+        fp = fopen(file, "w");
+        if (fp == NULL || fwrite (res, 1, len, fp) != len) {
+            errchk = 1;
+        }
+        if (fp != NULL) {
+            fclose(fp);
+        }
+    }
+    
+    return errchk;
+}